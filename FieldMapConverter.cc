@@ -0,0 +1,78 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "MagneticFieldMapping.hh"
+#include "globals.hh"
+
+/// Field map converter
+///
+/// Converts a .TABLE field map into the binary field map format, which the
+/// MagneticFieldMapping memory-maps instead of parsing the .TABLE field map.
+///
+/// Usage: FieldMapConverter <field map .TABLE> <binary field map .FMAP>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace {
+    void PrintUsage() {
+        G4cerr << " Usage: " << G4endl;
+        G4cerr << " FieldMapConverter <field map .TABLE> <binary field map .FMAP>" << G4endl;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc,char** argv)
+{
+    if ( argc != 3 ) {
+        PrintUsage();
+        return 1;
+    }
+    
+    MagneticFieldMapping fieldMap(argv[1], 0.);
+    
+    if ( !fieldMap.WriteBinary(argv[2]) ) {
+        G4cerr << " The binary field map " << argv[2] << " could not be written." << G4endl;
+        return 1;
+    }
+    
+    G4cout << " ---> Written the binary field map " << argv[2] << G4endl;
+    
+    return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
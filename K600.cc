@@ -31,8 +31,15 @@
 #include "DetectorConstruction.hh"
 #include "ActionInitialization.hh"
 
+#include "G4Version.hh"
+
 #ifdef G4MULTITHREADED
+#if G4VERSION_NUMBER >= 1070
+#include "G4TaskRunManager.hh"
+#else
 #include "G4MTRunManager.hh"
+#endif
+#include "G4Threading.hh"
 #else
 #include "G4RunManager.hh"
 #endif
@@ -45,8 +52,27 @@
 
 #include "G4PhysListFactory.hh"
 #include "G4RadioactiveDecayPhysics.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "TransferMapPhysics.hh"
+#include "TransferMap.hh"
+#include "TimeWindowPhysics.hh"
+#include "TimeWindowMessenger.hh"
+#include "ImportanceBiasing.hh"
+#include "ImportanceBiasingMessenger.hh"
+#include "EfficiencyCurveMessenger.hh"
+#include "ResponseMatrixMessenger.hh"
+#include "ImportanceWorld.hh"
+
+#include "G4GeometrySampler.hh"
+#include "G4ImportanceBiasing.hh"
+#include "G4ParallelWorldPhysics.hh"
 
 #include "Randomize.hh"
+#include "RandomSeeding.hh"
+#include "RandomSeedingMessenger.hh"
+#include "ProgressMonitorMessenger.hh"
+
+#include <cstdlib>
 
 #ifdef G4VIS_USE
 #include "G4VisExecutive.hh"
@@ -61,8 +87,11 @@
 namespace {
     void PrintUsage() {
         G4cerr << " Usage: " << G4endl;
-        G4cerr << " exampleB4a [-m macro ] [-u UIsession] [-t nThreads]" << G4endl;
-        G4cerr << "   note: -t option is available only for multi-threaded mode."
+        G4cerr << " K600 [-m macro ] [-u UIsession] [-t nThreads] [-s runSeed] [-o outputPrefix]" << G4endl;
+        G4cerr << "      [--physics physicsList] [--engine MixMax|MTwist|Ranecu|Ranlux]" << G4endl;
+        G4cerr << "   note: -t option is available only for multi-threaded mode,"
+        << G4endl;
+        G4cerr << "         -t 0 (the default) runs a thread on every core."
         << G4endl;
     }
 }
@@ -73,20 +102,32 @@ int main(int argc,char** argv)
 {
     // Evaluate arguments
     //
-    if ( argc > 7 ) {
+    if ( argc > 15 ) {
         PrintUsage();
         return 1;
     }
     
     G4String macro;
     G4String session;
+    G4String outputPrefix;
+    G4String physName = "QGSP_BERT";
+    G4String engineName = RandomSeeding::GetDefaultEngineName();
 #ifdef G4MULTITHREADED
-    G4int nThreads = 2;
+    G4int nThreads = 0;
 #endif
-  /*
     for ( G4int i=1; i<argc; i=i+2 ) {
+        if ( i+1 >= argc ) {
+            PrintUsage();
+            return 1;
+        }
         if      ( G4String(argv[i]) == "-m" ) macro = argv[i+1];
         else if ( G4String(argv[i]) == "-u" ) session = argv[i+1];
+        else if ( G4String(argv[i]) == "-o" ) outputPrefix = argv[i+1];
+        else if ( G4String(argv[i]) == "--physics" ) physName = argv[i+1];
+        else if ( G4String(argv[i]) == "-s" || G4String(argv[i]) == "--seed" ) {
+            RandomSeeding::SetRunSeed(std::atol(argv[i+1]));
+        }
+        else if ( G4String(argv[i]) == "--engine" ) engineName = argv[i+1];
 #ifdef G4MULTITHREADED
         else if ( G4String(argv[i]) == "-t" ) {
             nThreads = G4UIcommand::ConvertToInt(argv[i+1]);
@@ -97,29 +138,40 @@ int main(int argc,char** argv)
             return 1;
         }
     }
-    */
-    
     
     // Choose the Random engine
+    // Every event is reseeded from the run seed, its run ID and its event ID, see RandomSeeding.hh
     //
-    //G4Random::setTheEngine(new CLHEP::RanecuEngine);
+    CLHEP::HepRandomEngine* engine = RandomSeeding::CreateEngine(engineName);
+    if ( !engine ) {
+        G4cerr << " Unknown random engine " << engineName << G4endl;
+        PrintUsage();
+        return 1;
+    }
+    G4Random::setTheEngine( engine );
+    G4Random::setTheSeed( RandomSeeding::GetRunSeed() );
     
-    CLHEP::RanluxEngine defaultEngine( 1234567, 4 );
-    G4Random::setTheEngine( &defaultEngine );
-    G4int seed = time( NULL );
-    G4Random::setTheSeed( seed );
+    RandomSeedingMessenger* randomSeedingMessenger = new RandomSeedingMessenger();
+    ProgressMonitorMessenger* progressMonitorMessenger = new ProgressMonitorMessenger();
+    TimeWindowMessenger* timeWindowMessenger = new TimeWindowMessenger();
+    ImportanceBiasingMessenger* importanceBiasingMessenger = new ImportanceBiasingMessenger();
+    EfficiencyCurveMessenger* efficiencyCurveMessenger = new EfficiencyCurveMessenger();
+    ResponseMatrixMessenger* responseMatrixMessenger = new ResponseMatrixMessenger();
     
     // Construct the default run manager
+    // The events are processed as tasks where available, on every core unless -t is given
     //
 #ifdef G4MULTITHREADED
+#if G4VERSION_NUMBER >= 1070
+    G4TaskRunManager * runManager = new G4TaskRunManager;
+#else
     G4MTRunManager * runManager = new G4MTRunManager;
-    runManager->SetNumberOfThreads(2);
-    
-    /*
-     if ( nThreads > 0 ) {
-     runManager->SetNumberOfThreads(4);
-     }
-     */
+#endif
+    if ( nThreads <= 0 ) {
+        nThreads = G4Threading::G4GetNumberOfCores();
+    }
+    runManager->SetNumberOfThreads(nThreads);
+    G4cout << "\n---> " << nThreads << " worker threads" << G4endl;
 #else
     G4RunManager * runManager = new G4RunManager;
 #endif
@@ -129,6 +181,14 @@ int main(int argc,char** argv)
     DetectorConstruction* detConstruction = new DetectorConstruction();
     runManager->SetUserInitialization(detConstruction);
     
+    ////    Shells around the AmBe source in a parallel world, see ImportanceBiasing.hh
+    ImportanceWorld* importanceWorld = 0;
+    if(ImportanceBiasing_Active)
+    {
+        importanceWorld = new ImportanceWorld(ImportanceBiasing_WorldName, detConstruction);
+        detConstruction->RegisterParallelWorld(importanceWorld);
+    }
+    
     /*
      G4VModularPhysicsList* physicsList = new QGSP_BERT;
      runManager->SetUserInitialization(physicsList);
@@ -140,11 +200,44 @@ int main(int argc,char** argv)
     
     G4PhysListFactory factory;
     G4VModularPhysicsList* phys = 0;
-    G4String physName = "QGSP_BERT";
-  //  G4String physName = "QGSP_BERT_HP";
-    // reference PhysicsList via its name
-    phys = factory.GetReferencePhysList(physName);
+    // reference PhysicsList via its name, e.g. --physics QGSP_BERT_HP
+    if ( factory.IsReferencePhysList(physName) ) {
+        phys = factory.GetReferencePhysList(physName);
+    }
+    if ( !phys ) {
+        G4cerr << " Unknown reference physics list " << physName << G4endl;
+        PrintUsage();
+        delete runManager;
+        delete randomSeedingMessenger;
+        delete progressMonitorMessenger;
+        delete timeWindowMessenger;
+        delete importanceBiasingMessenger;
+        delete efficiencyCurveMessenger;
+        delete responseMatrixMessenger;
+        delete engine;
+        return 1;
+    }
     phys->RegisterPhysics(new G4RadioactiveDecayPhysics());
+    
+    ////    Maximum steps of the detector regions, see DetectorConstruction.hh
+    phys->RegisterPhysics(new G4StepLimiterPhysics());
+    
+    ////    Fast simulation through the K600 magnets with their transfer maps
+    if(TransferMap_FastSimulation) phys->RegisterPhysics(new TransferMapPhysics());
+    
+    ////    Tracks beyond the longest sampled time of the detectors are killed, see TimeWindow.hh
+    phys->RegisterPhysics(new TimeWindowPhysics());
+    
+    ////    Importance biasing of the neutrons between the shells of the ImportanceWorld
+    ////    The sampler is given the world of the ImportanceWorld by G4ImportanceBiasing once it is constructed
+    G4GeometrySampler* importanceSampler = 0;
+    if(ImportanceBiasing_Active)
+    {
+        importanceSampler = new G4GeometrySampler(importanceWorld->GetWorldVolume(), ImportanceBiasing_Particle);
+        importanceSampler->SetParallel(true);
+        phys->RegisterPhysics(new G4ImportanceBiasing(importanceSampler, ImportanceBiasing_WorldName));
+        phys->RegisterPhysics(new G4ParallelWorldPhysics(ImportanceBiasing_WorldName));
+    }
     runManager->SetUserInitialization(phys);
     
     
@@ -167,6 +260,11 @@ int main(int argc,char** argv)
     // Get the pointer to the User Interface manager
     G4UImanager* UImanager = G4UImanager::GetUIpointer();
     
+    // The output file, which the macros may still rename with /analysis/setFileName
+    if ( outputPrefix.size() ) {
+        UImanager->ApplyCommand("/analysis/setFileName " + outputPrefix);
+    }
+    
     if ( macro.size() ) {
         // batch mode
         G4String command = "/control/execute ";
@@ -197,6 +295,14 @@ int main(int argc,char** argv)
     delete visManager;
 #endif
     delete runManager;
+    delete randomSeedingMessenger;
+    delete progressMonitorMessenger;
+    delete timeWindowMessenger;
+    delete importanceBiasingMessenger;
+    delete efficiencyCurveMessenger;
+    delete responseMatrixMessenger;
+    delete importanceSampler;
+    delete engine;
     
     return 0;
 }
@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "PrimaryVertexFile.hh"
+#include "globals.hh"
+
+/// Primary vertex converter
+///
+/// Converts a text file of primaries into the binary primary vertex file,
+/// which the PrimaryGeneratorAction memory-maps in the file mode. Every line
+/// holds a primary particle with its own vertex:
+///
+///     event pdg Z A Ex px py pz x y z t weight
+///
+/// in MeV, MeV/c, mm and ns, with pdg = 0 for an ion of the given Z, A and
+/// excitation energy Ex. The lines of an event are consecutive and the events
+/// are in ascending order, lines starting with # are ignored. The weight is the
+/// statistical weight of the event, repeated on every line of the event, and
+/// lines of the same event with different weights are rejected.
+///
+/// Usage: PrimaryVertexConverter <primaries .txt> <primary vertex file .PVTX>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace {
+    void PrintUsage() {
+        G4cerr << " Usage: " << G4endl;
+        G4cerr << " PrimaryVertexConverter <primaries .txt> <primary vertex file .PVTX>" << G4endl;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc,char** argv)
+{
+    if ( argc != 3 ) {
+        PrintUsage();
+        return 1;
+    }
+    
+    if ( !PrimaryVertexFile::Convert(argv[1], argv[2]) ) {
+        G4cerr << " The primary vertex file " << argv[2] << " could not be written." << G4endl;
+        return 1;
+    }
+    
+    G4cout << " ---> Written the primary vertex file " << argv[2] << G4endl;
+    
+    return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
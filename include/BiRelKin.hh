@@ -1,5 +1,11 @@
+#ifndef BiRelKin_h
+#define BiRelKin_h 1
 
-using namespace std;
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 ////////////////////////////////////
 ////        BiRelKin        ////
@@ -8,99 +14,221 @@ using namespace std;
 //  A calculator for Binary Relativistic Kinematics
 //  Kevin C.W. Li, kcwli@sun.ac.za
 //  10/02/15
+//
+//  Header only and without any global state, such that the kinematics may be
+//  solved concurrently on every worker thread. The angle independent terms of a
+//  reaction are computed once by BiRelKinematics, after which any number of
+//  scattering angles are solved, one at a time or as a batch.
 
 
 ////////////////////////
 ////    Constants   ////
 ////////////////////////
 
-////  Speed of Light
-double c2 = 931.494;     // MeV/u, c^2
-double c4 = c2*c2;  // (MeV/u)^2, c^4
-
-////    Lab Variables
-double Q, Etotal;
-double theta_lab, phi_lab;
-
-////    Quadratic equation variables
-double a = 0.0;
-double b = 0.0;
-double c = 0.0;
+#if __cplusplus >= 201103L
+#define BIRELKIN_CONSTEXPR constexpr
+#else
+#define BIRELKIN_CONSTEXPR const
+#endif
 
+////  Speed of Light
+BIRELKIN_CONSTEXPR double BiRelKin_c2 = 931.494;     // MeV/u, c^2
+
+////    Degrees to radians
+BIRELKIN_CONSTEXPR double BiRelKin_deg = 0.017453292519943295;
+
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Binary relativistic kinematics of a reaction m[0](m[1], m[2])m[3]
+///
+/// The masses are given in u, the energies in MeV and the angles in degrees,
+/// with m[0] the projectile, m[1] the target, m[2] the ejectile and m[3] the
+/// recoil, the latter with an excitation energy Ex.
+///
+/// The ejectile momentum is solved in closed form,
+///
+///     p[2]c = (K p[0]c cos + Etotal sqrt(K^2 - m[2]^2 c^4 (Etotal^2 - p[0]^2 c^2 cos^2)))/(Etotal^2 - p[0]^2 c^2 cos^2)
+///
+/// with 2K = Etotal^2 - p[0]^2 c^2 + m[2]^2 c^4 - m[3]^2 c^4, the root of the
+/// quadratic equation for E[2] of the original BiRelKin. Expanding the latter
+/// cancels terms of order Etotal^4 and, at 90 deg, its discriminant vanishes
+/// with a double root. The kinetic energies and the recoil momentum are then
+/// taken from differences of kinetic energies rather than of total energies,
+/// such that they remain accurate as the recoil kinetic energy vanishes.
+
+class BiRelKinematics
+{
+public:
+    BiRelKinematics(const double* m, double T0, double T1, double Ex);
+
+    //  Ejectile scattering angle ThetaSCAT, returns the energies and momenta of all four particles and the recoil angle
+    void Solve(double ThetaSCAT, double* T, double* E, double* p, double& ThetaRecoil) const;
+
+    //  Solves n scattering angles at once, returns the ejectile and recoil kinetic energies and the recoil angles
+    void Solve(int n, const double* ThetaSCAT, double* T2, double* T3, double* ThetaRecoil) const;
+
+    double GetQ() const { return fQ; }
+    double GetTotalEnergy() const { return fEtotal; }
+
+private:
+    double fMc2[4];         // m c^2
+    double fT0, fT1;        // kinetic energies of the projectile and target
+    double fE0, fE1;        // total energies of the projectile and target
+    double fP0, fP1;        // momenta of the projectile and target
+    double fQ, fEtotal;
+
+    ////    Angle independent terms of the ejectile momentum, momenta as p c in MeV
+    double fPc0, fPc0Squared;   // p[0] c, p[0]^2 c^2
+    double fEtotalSquared;      // Etotal^2
+    double fK, fKSquared;       // K, K^2
+    double fM2;                 // m[2]^2 c^4
+    double fTtotal;             // T[2] + T[3] = T[0] + T[1] - Ex
+
+    ////    Recoil momentum along the beam axis, p[0] c - p[2] c cos
+    double RecoilMomentumZ(double cos, double sin, double pc2, double T2) const;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline BiRelKinematics::BiRelKinematics(const double* m, double T0, double T1, double Ex)
+{
+    for(int i=0; i<4; i++) fMc2[i] = m[i]*BiRelKin_c2;
 
-void BiRelKin(double *m, double *T, double *E, double *p, double ThetaSCAT,  double &PhiSCAT, double Ex) {
-    
     ////    Q-value calculation
-    Q = (m[2] + m[3])*c2 - (m[0] + m[1])*c2; // MeV
-    
-    ////    Conversion of ejectile scattering angle from degrees to radians
-    theta_lab = ThetaSCAT*0.017453292; // radians
-    phi_lab = PhiSCAT*0.017453292; // radians
+    fQ = (m[2] + m[3])*BiRelKin_c2 - (m[0] + m[1])*BiRelKin_c2; // MeV
 
     ////    Initial Total Energy Calculation
-    E[0] = T[0] + (m[0]*c2);
-    E[1] = T[1] + (m[1]*c2);
-    Etotal = E[0] + E[1] + Q - Ex;
+    fT0 = T0;
+    fT1 = T1;
+    fE0 = T0 + fMc2[0];
+    fE1 = T1 + fMc2[1];
+    fEtotal = fE0 + fE1 + fQ - Ex;
+    fTtotal = T0 + T1 - Ex;
+
+    ////    Initial Momentum Calculation, from the kinetic energies
+    fPc0Squared = T0*(T0 + 2*fMc2[0]);
+    fPc0 = std::sqrt(fPc0Squared);
+    fP0 = fPc0/std::sqrt(BiRelKin_c2);
+    fP1 = std::sqrt(T1*(T1 + 2*fMc2[1]))/std::sqrt(BiRelKin_c2);
+
+    ////    Angle independent terms of the ejectile momentum
+    fEtotalSquared = fEtotal*fEtotal;
+    fM2 = fMc2[2]*fMc2[2];
+    fK = 0.5*((fEtotalSquared - fPc0Squared) + (fMc2[2] - fMc2[3])*(fMc2[2] + fMc2[3]));
+    fKSquared = fK*fK;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-    ////    Initial Momentum Calculation
-    p[0] = (1/sqrt(c2))*sqrt((E[0]*E[0]) - (m[0]*m[0]*c4));
-    p[1] = (1/sqrt(c2))*sqrt((E[1]*E[1]) - (m[1]*m[1]*c4));
+inline void BiRelKinematics::Solve(double ThetaSCAT, double* T, double* E, double* p, double& ThetaRecoil) const
+{
+    const double theta_lab = ThetaSCAT*BiRelKin_deg; // radians
+    const double cos = std::cos(theta_lab);
+    const double sin = std::sin(theta_lab);
 
-    
-    ////////////////////////////////////////////////////////////////////////////////
-    ////    E[2] is now solved via the solution of a quadratic equation
+    T[0] = fT0;
+    T[1] = fT1;
+    E[0] = fE0;
+    E[1] = fE1;
+    p[0] = fP0;
+    p[1] = fP1;
 
-    a = 4*p[0]*p[0]*c2*cos(theta_lab)*cos(theta_lab) - 4*Etotal*Etotal;
-    b = (4*Etotal*Etotal*Etotal) - (4*p[0]*p[0]*c2*Etotal) + (4*m[2]*m[2]*c4*Etotal) - (4*m[3]*m[3]*c4*Etotal);
-    c = (2*p[0]*p[0]*c2*Etotal*Etotal) - (2*m[2]*m[2]*c4*Etotal*Etotal) + (2*m[2]*m[2]*c4*p[0]*p[0]*c2) + (2*m[3]*m[3]*c4*Etotal*Etotal) - (2*m[3]*m[3]*c4*p[0]*p[0]*c2) + (2*m[3]*m[3]*c4*m[2]*m[2]*c4) - (Etotal*Etotal*Etotal*Etotal) - (p[0]*p[0]*p[0]*p[0]*c4) - (m[2]*m[2]*m[2]*m[2]*c4*c4) - (m[3]*m[3]*m[3]*m[3]*c4*c4) - (4*m[2]*m[2]*c4*p[0]*p[0]*c2*cos(theta_lab)*cos(theta_lab));
+    ////    Momentum, Total Energy and Kinetic Energy of Ejectile
+    const double d = fEtotalSquared - fPc0Squared*cos*cos;
+    const double pc2 = (fK*fPc0*cos + fEtotal*std::sqrt(fKSquared - fM2*d))/d;
+    E[2] = std::sqrt(pc2*pc2 + fM2);
+    T[2] = pc2*pc2/(E[2] + fMc2[2]);
+    p[2] = pc2/std::sqrt(BiRelKin_c2);
 
-    ////    Total Energy, Kinetic Energy and Momentum of Ejectile
-    E[2] = (- b - sqrt((b*b) - (4*a*c)))/(2*a);
-    T[2] = E[2] - m[2]*c2;
-    p[2] = (1/sqrt(c2))*sqrt((E[2]*E[2]) - (m[2]*m[2]*c4));
+    ////    Kinetic Energy, Total Energy and Momentum of Recoil
+    T[3] = fTtotal - T[2];
+    E[3] = T[3] + fMc2[3];
 
-    ////    Total Energy, Kinetic Energy and Momentum of Recoil
-    E[3] = Etotal - E[2];
-    T[3] = E[3] - m[3]*c2;
-    p[3] = (1/sqrt(c2))*sqrt((E[3]*E[3]) - (m[3]*m[3]*c4));
+    const double pcx3 = pc2*sin;
+    const double pcz3 = RecoilMomentumZ(cos, sin, pc2, T[2]);
+    p[3] = std::sqrt(pcx3*pcx3 + pcz3*pcz3)/std::sqrt(BiRelKin_c2);
 
     ////    Angle between beam axis and Recoil velocity
-    phi_lab = asin((p[2]/p[3])*sin(theta_lab)); // radians
-    PhiSCAT = phi_lab/0.0174532925; // deg
-    
-    bool printResults = false;
-    
-    if (printResults)
+    ThetaRecoil = std::atan2(pcx3, pcz3)/BiRelKin_deg; // deg
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void BiRelKinematics::Solve(int n, const double* ThetaSCAT, double* T2, double* T3, double* ThetaRecoil) const
+{
+    int i = 0;
+
+#if defined(__SSE2__)
+    ////    Two scattering angles per iteration, the trigonometric functions remain scalar
+    const __m128d EtotalSquared = _mm_set1_pd(fEtotalSquared), Pc0Squared = _mm_set1_pd(fPc0Squared);
+    const __m128d KSquared = _mm_set1_pd(fKSquared);
+    const __m128d KPc0 = _mm_set1_pd(fK*fPc0), Etotal = _mm_set1_pd(fEtotal);
+    const __m128d M2 = _mm_set1_pd(fM2), Mc2_2 = _mm_set1_pd(fMc2[2]);
+    const __m128d Ttotal = _mm_set1_pd(fTtotal);
+
+    for(; i+1<n; i+=2)
+    {
+        const double theta0 = ThetaSCAT[i]*BiRelKin_deg, theta1 = ThetaSCAT[i+1]*BiRelKin_deg;
+        const double cos0 = std::cos(theta0), cos1 = std::cos(theta1);
+        const double sin0 = std::sin(theta0), sin1 = std::sin(theta1);
+
+        const __m128d cos = _mm_set_pd(cos1, cos0);
+        const __m128d d = _mm_sub_pd(EtotalSquared, _mm_mul_pd(Pc0Squared, _mm_mul_pd(cos, cos)));
+
+        ////    p[2] c, E[2] and T[2] = p[2]^2 c^2/(E[2] + m[2] c^2)
+        const __m128d root = _mm_sqrt_pd(_mm_sub_pd(KSquared, _mm_mul_pd(M2, d)));
+        const __m128d pc2 = _mm_div_pd(_mm_add_pd(_mm_mul_pd(KPc0, cos), _mm_mul_pd(Etotal, root)), d);
+        const __m128d pc2Squared = _mm_mul_pd(pc2, pc2);
+        const __m128d E2 = _mm_sqrt_pd(_mm_add_pd(pc2Squared, M2));
+        const __m128d t2 = _mm_div_pd(pc2Squared, _mm_add_pd(E2, Mc2_2));
+
+        _mm_storeu_pd(T2 + i, t2);
+        _mm_storeu_pd(T3 + i, _mm_sub_pd(Ttotal, t2));
+
+        double pc[2];
+        _mm_storeu_pd(pc, pc2);
+
+        ThetaRecoil[i] = std::atan2(pc[0]*sin0, RecoilMomentumZ(cos0, sin0, pc[0], T2[i]))/BiRelKin_deg;
+        ThetaRecoil[i+1] = std::atan2(pc[1]*sin1, RecoilMomentumZ(cos1, sin1, pc[1], T2[i+1]))/BiRelKin_deg;
+    }
+#endif
+
+    for(; i<n; i++)
     {
-        cout << "///////////////////////////////" << endl;
-        cout << "////   Particle Massses    ////" << endl;
-        
-        cout << "m[0]:    " << m[0] << " u"  << endl;
-        cout << "m[1]:    " << m[1] << " u"  << endl;
-        cout << "m[2]:    " << m[2] << " u"  << endl;
-        cout << "m[3]:    " << m[3] << " u"  << endl;
-        
-        cout << "///////////////////////" << endl;
-        cout << "////   Ejectile    ////" << endl;
-
-        cout << "Total Energy, E[2]:    " << E[2] << " MeV"  << endl;
-        cout << "Kinetic Energy, T[2]:    " << T[2] << " MeV"  << endl;
-        cout << "Momentum, p[2]:    " << p[2] << " MeV/c"  << endl;
-
-        
-        cout << "///////////////////////" << endl;
-        cout << "////   Recoil    ////" << endl;
-        cout << "Total Energy, E[3]:    " << E[3] << " MeV"  << endl;
-        cout << "Kinetic Energy, T[3]:    " << T[3] << " MeV"  << endl;
-        cout << "Momentum, p[3]:    " << p[3] << " MeV/c"  << endl;
-        
-        
-        cout << "   " << endl;
-        cout << "ThetaSCAT (angle of ejectile w.r.t. beam axis):    " << ThetaSCAT << " deg"  << endl;
-        cout << "PhiSCAT (angle of recoil w.r.t. beam axis):    " << PhiSCAT << " deg"  << endl;
+        const double theta_lab = ThetaSCAT[i]*BiRelKin_deg;
+        const double cos = std::cos(theta_lab);
+        const double sin = std::sin(theta_lab);
+
+        const double d = fEtotalSquared - fPc0Squared*cos*cos;
+        const double pc2 = (fK*fPc0*cos + fEtotal*std::sqrt(fKSquared - fM2*d))/d;
+
+        T2[i] = pc2*pc2/(std::sqrt(pc2*pc2 + fM2) + fMc2[2]);
+        T3[i] = fTtotal - T2[i];
+        ThetaRecoil[i] = std::atan2(pc2*sin, RecoilMomentumZ(cos, sin, pc2, T2[i]))/BiRelKin_deg;
     }
-    
-    
-    
-    
 }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline double BiRelKinematics::RecoilMomentumZ(double cos, double sin, double pc2, double T2) const
+{
+    ////    p[0] c - p[2] c = (p[0]^2 c^2 - p[2]^2 c^2)/(p[0] c + p[2] c), from the kinetic energies
+    const double pc0MinusPc2 = ((fT0 - T2)*(fT0 + T2 + 2*fMc2[0]) + 2*(fMc2[0] - fMc2[2])*T2)/(fPc0 + pc2);
+
+    ////    1 - cos = sin^2/(1 + cos) at forward angles
+    const double oneMinusCos = cos > 0. ? sin*sin/(1 + cos) : 1 - cos;
+
+    return pc0MinusPc2 + pc2*oneMinusCos;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+////    The original interface, PhiSCAT returns the angle of the recoil w.r.t. the beam axis
+inline void BiRelKin(double *m, double *T, double *E, double *p, double ThetaSCAT,  double &PhiSCAT, double Ex)
+{
+    BiRelKinematics kinematics(m, T[0], T[1], Ex);
+    kinematics.Solve(ThetaSCAT, T, E, p, PhiSCAT);
+}
+
+#endif
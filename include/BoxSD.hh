@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef BoxSD_h
+#define BoxSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "CrystalHit.hh"
+
+class G4Step;
+class G4HCofThisEvent;
+
+/// Paraffin and Iron box sensitive detector class
+///
+/// In ProcessHits(), the energy deposit of a gamma-ray step within the box is
+/// accumulated in a single hit, which carries the kinetic energy of the first
+/// gamma-ray to enter the box. The energy deposit is weighted with the weight
+/// of the track, the importance biasing weight alone (ImportanceBiasing.hh),
+/// such that the box is weighted with the event weight like every other
+/// detector (PrimaryVertexWeight.hh). The box is not time sampled.
+
+class BoxSD : public G4VSensitiveDetector
+{
+public:
+    BoxSD(const G4String& name, const G4String& hitsCollectionName);
+    virtual ~BoxSD();
+    
+    // methods from base class
+    virtual void   Initialize(G4HCofThisEvent* hitCollection);
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory* history);
+    
+private:
+    CrystalHitsCollection*  fHitsCollection;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
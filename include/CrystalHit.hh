@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef CrystalHit_h
+#define CrystalHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+/// Crystal hit class
+///
+/// It defines the data members to store the energy deposited (keV) within a single
+/// crystal of a gamma-ray detector during one time sample, together with the kinetic
+/// energy (keV) of the particle that created the hit.
+/// It is shared by the CLOVER, LEPS and NAIS detectors and the Paraffin and Iron boxes.
+
+class CrystalHit : public G4VHit
+{
+public:
+    CrystalHit(G4int detectorNo, G4int crystalNo, G4int timeSample, G4double incidentEnergy);
+    virtual ~CrystalHit();
+    
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+    
+    // methods to handle data
+    void Add(G4double edep) {fEdep += edep;};
+    
+    // get methods
+    G4int       GetDetectorNo() const       {return fDetectorNo;};
+    G4int       GetCrystalNo() const        {return fCrystalNo;};
+    G4int       GetTimeSample() const       {return fTimeSample;};
+    G4double    GetEdep() const             {return fEdep;};
+    G4double    GetIncidentEnergy() const   {return fIncidentEnergy;};
+    
+private:
+    G4int       fDetectorNo;
+    G4int       fCrystalNo;
+    G4int       fTimeSample;
+    G4double    fEdep;
+    G4double    fIncidentEnergy;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+typedef G4THitsCollection<CrystalHit> CrystalHitsCollection;
+
+extern G4ThreadLocal G4Allocator<CrystalHit>* CrystalHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* CrystalHit::operator new(size_t)
+{
+    if(!CrystalHitAllocator) CrystalHitAllocator = new G4Allocator<CrystalHit>;
+    return (void *) CrystalHitAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void CrystalHit::operator delete(void *hit)
+{
+    CrystalHitAllocator->FreeSingle((CrystalHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
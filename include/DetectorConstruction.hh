@@ -41,6 +41,7 @@
 #include "globals.hh"
 #include "G4RotationMatrix.hh"
 #include "G4Transform3D.hh"
+#include "G4ThreeVector.hh"
 
 #include "G4UniformMagField.hh"
 #include "G4QuadrupoleMagField.hh"
@@ -53,6 +54,12 @@
 #include "G4PropagatorInField.hh"
 #include "G4FieldManager.hh"
 
+#include "TransferMap.hh"
+
+#include <map>
+#include <vector>
+#include <algorithm>
+
 
 class G4VPhysicalVolume;
 class G4GlobalMagFieldMessenger;
@@ -71,6 +78,9 @@ class G4ChordFinder;
 class G4PropagatorInField;
 class G4FieldManager;
 class G4UniformMagField;
+class VDCWireplaneParameterisation;
+class MeshRegistry;
+class G4Region;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -108,8 +118,78 @@ const G4int     numberOf_NAIS = 5;
 const G4int     numberOf_FLATSIDE = 2;
 
 
+//////////////////////////////////////////////////////////
+//                  SCORING VOLUMES                     //
+//////////////////////////////////////////////////////////
+
+////    The volume types which are scored within the simulation.
+////    Each scored logical volume is registered with its type as it is placed in DefineVolumes().
+////    The sensitive detectors are attached to the detector volumes in ConstructSDandField(),
+////    whilst the SteppingAction resolves the geometry analysis volumes with a single pointer lookup.
+enum ScoringVolumeType
+{
+    kNotScored = 0,
+    kWorld,
+    kTIARA_AA_RS,
+    kTIARA_SiliconWafer,
+    kTIARA_PCB,
+    kVDC_SenseRegion,
+    kVDC_Wireplane,
+    kPADDLE,
+    kCLOVER_HPGeCrystal,
+    kParaffinBox,
+    kIronBox,
+    kLEPS_HPGeCrystal,
+    kNAIS_NaICrystal,
+    //  K600 magnets, registered for the transfer map calibration, in the order of TransferMapMagnet
+    kK600_Quadrupole,
+    kK600_Dipole1,
+    kK600_Dipole2
+};
+
+
+//////////////////////////////////////////////////////////
+//                  INSTRUMENTED VOLUMES                //
+//////////////////////////////////////////////////////////
+
+////    Bounding spheres of the present gamma-ray and neutron detectors, towards which the directions
+////    of the primary particles may be biased. The radii enclose the crystals and their encasements.
+const G4double  CLOVER_BoundingRadius = 130.; // mm
+const G4double  LEPS_BoundingRadius = 61.; // mm
+const G4double  NAIS_BoundingRadius = 54.; // mm
+
+struct InstrumentedVolume
+{
+    G4ThreeVector   centre;
+    G4double        radius;
+};
+
+
+//////////////////////////////////////////////////////////
+//                  DETECTOR REGIONS                    //
+//////////////////////////////////////////////////////////
+
+////    Regions with their own production cuts and maximum step, the remainder of the geometry lies within the
+////    world region (DefaultRegionForTheWorld) with the cut of /run/setCut. The cuts are ranges for all particles,
+////    a maximum step of 0 imposes no limit. Both may be changed with /K600/region/ once the geometry is built.
+enum DetectorRegion
+{
+    kVDCRegion = 0,     // VDC assemblies, the 1.8 mg/cm3 gas, its frames and wires
+    kTIARARegion,       // TIARA assemblies, the thin silicon
+    kCrystalRegion,     // CLOVER, LEPS and NAIS crystals
+    kShieldRegion,      // CLOVER shields, BGO and heavimet
+    numberOf_DetectorRegions
+};
+
+const char* const   DetectorRegion_Name[numberOf_DetectorRegions] = {"VDC", "TIARA", "Crystals", "Shields"};
+const G4double      DetectorRegion_ProductionCut[numberOf_DetectorRegions] = {10., 0.05, 1., 5.}; // mm
+const G4double      DetectorRegion_MaxStep[numberOf_DetectorRegions] = {0., 0., 0., 0.}; // mm
+
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+class DetectorRegionMessenger;
+
 class DetectorConstruction : public G4VUserDetectorConstruction
 {
 public:
@@ -118,18 +198,41 @@ public:
     
 public:
     virtual G4VPhysicalVolume* Construct();
+    virtual void ConstructSDandField();
     virtual void ConstructField();
     
     // get methods
     //
     //const G4VPhysicalVolume* GetAbsorberPV() const;
     //const G4VPhysicalVolume* GetGapPV() const;
+    ScoringVolumeType GetScoringVolumeType(G4LogicalVolume* logicalVolume) const;
+    const std::vector<InstrumentedVolume>& GetInstrumentedVolumes() const { return fInstrumentedVolumes; }
+    //  The longest sampled time of the digitisation of the present detectors (ns), 0 without any timed detector
+    G4double GetLongestSampledTime() const;
+    //  The AmBe source within the IronBox in the world frame, the centre of the ImportanceWorld shells
+    const G4ThreeVector& GetAmBeSourcePosition() const { return AmBeSource_position; }
+    G4bool IsNeutronShieldingPresent() const { return PARAFFINTUBE_Presence || IRONBOX_Presence; }
     
 private:
     // methods
     //
     void DefineMaterials();
     G4VPhysicalVolume* DefineVolumes();
+    void RegisterScoringVolume(G4LogicalVolume* logicalVolume, ScoringVolumeType type);
+    void RegisterInstrumentedVolume(const G4ThreeVector& centre, G4double radius);
+    void RegisterRegionVolume(G4LogicalVolume* logicalVolume, DetectorRegion region);
+    void SetupRegions();
+    void SetupTransferMap(TransferMapMagnet magnet, G4LogicalVolume* logicalVolume, ScoringVolumeType type, const G4String& setting);
+    
+    //  Scoring volume table, filled once during DefineVolumes() and only read thereafter
+    std::map<G4LogicalVolume*, ScoringVolumeType> fScoringVolumes;
+    
+    //  Bounding spheres of the present detectors, filled during DefineVolumes() and only read thereafter
+    std::vector<InstrumentedVolume> fInstrumentedVolumes;
+    
+    //  Root logical volumes of the regions of the present detectors, filled during DefineVolumes()
+    std::vector<G4LogicalVolume*>   fRegionVolumes[numberOf_DetectorRegions];
+    DetectorRegionMessenger*        fRegionMessenger;
     
     // data members
     //
@@ -181,12 +284,12 @@ private:
     //      VDC - X WIRES
     G4VPhysicalVolume*  PhysiVDC_X_WIRE;
     G4RotationMatrix    VDC_X_WIRE_rotm;
-    G4Transform3D       VDC_X_WIRE_transform;
+    VDCWireplaneParameterisation*   VDC_X_WireplaneParam;
     
     //      VDC - U WIRES
     G4VPhysicalVolume*  PhysiVDC_U_WIRE;
     G4RotationMatrix    VDC_U_WIRE_rotm;
-    G4Transform3D       VDC_U_WIRE_transform;
+    VDCWireplaneParameterisation*   VDC_U_WireplaneParam;
     
     
     
@@ -346,6 +449,7 @@ private:
     G4bool              PARAFFINTUBE_Presence;
     G4bool              IRONBOX_Presence;
     G4bool              AmBeBOX_Presence;
+    G4ThreeVector       AmBeSource_position;
     
     ///////////////////////////////////////////////////////////////
     //          CLOVER - BGO Shield   (Manufacturer: Cyberstar)
@@ -457,9 +561,46 @@ private:
     //  K600 Target Backing
     G4bool      K600_TargetBacking_Presence;
     
+    /////////////////////////////////////
+    //  CAD mesh models, shared by all the copies of a mesh
+    MeshRegistry*   fMeshRegistry;
+    
+    //  Transfer map fast simulation, the envelope region and transfer map of each present magnet
+    G4Region*       fTransferMapRegion[numberOf_TransferMapMagnets];
+    TransferMap*    fTransferMap[numberOf_TransferMapMagnets];
+    
 };
 
 // inline functions
+
+inline ScoringVolumeType DetectorConstruction::GetScoringVolumeType(G4LogicalVolume* logicalVolume) const
+{
+    std::map<G4LogicalVolume*, ScoringVolumeType>::const_iterator it = fScoringVolumes.find(logicalVolume);
+    
+    if(it == fScoringVolumes.end()) return kNotScored;
+    return it->second;
+}
+
+inline void DetectorConstruction::RegisterScoringVolume(G4LogicalVolume* logicalVolume, ScoringVolumeType type)
+{
+    fScoringVolumes[logicalVolume] = type;
+}
+
+inline void DetectorConstruction::RegisterInstrumentedVolume(const G4ThreeVector& centre, G4double radius)
+{
+    InstrumentedVolume volume;
+    volume.centre = centre;
+    volume.radius = radius;
+    fInstrumentedVolumes.push_back(volume);
+}
+
+inline void DetectorConstruction::RegisterRegionVolume(G4LogicalVolume* logicalVolume, DetectorRegion region)
+{
+    ////    The logical volumes of several copies are registered once
+    std::vector<G4LogicalVolume*>& volumes = fRegionVolumes[region];
+    if(std::find(volumes.begin(), volumes.end(), logicalVolume) == volumes.end()) volumes.push_back(logicalVolume);
+}
+
 /*
  inline const G4VPhysicalVolume* DetectorConstruction::GetAbsorberPV() const {
  return fAbsorberPV;
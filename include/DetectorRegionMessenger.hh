@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef DetectorRegionMessenger_h
+#define DetectorRegionMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcommand;
+class G4Region;
+
+/// Macro commands of the detector regions, /K600/region/
+///
+/// The regions are shared by all threads, the commands act on the master only
+/// and are available once the geometry is built (/run/initialize).
+
+class DetectorRegionMessenger : public G4UImessenger
+{
+public:
+    DetectorRegionMessenger();
+    virtual ~DetectorRegionMessenger();
+    
+    virtual void SetNewValue(G4UIcommand* command, G4String newValue);
+    
+private:
+    G4UIcommand* CreateRegionCommand(const char* name, const char* guidance);
+    G4Region* GetRegion(const G4String& name) const;
+    
+    G4UIdirectory*  fRegionDirectory;
+    G4UIcommand*    fProductionCutCmd;
+    G4UIcommand*    fMaxStepCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,120 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef EfficiencyCurve_h
+#define EfficiencyCurve_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+///////////////     EFFICIENCY CURVE - Defaults     ///////////////////
+const G4double      EfficiencyCurve_DefaultPeakWindow = 3.;    // keV, half width of the full-energy and escape peaks
+const char* const   EfficiencyCurve_DefaultFileName = "K600_efficiency.dat";
+
+////    The gamma-ray arrays of the efficiency curves
+enum EfficiencyArray
+{
+    kEfficiency_CLOVER = 0,
+    kEfficiency_LEPS,
+    kEfficiency_NAIS,
+    numberOf_EfficiencyArrays
+};
+
+////    The counts of every detector and energy
+enum EfficiencyCount
+{
+    kEfficiency_Total = 0,          // any energy above the threshold
+    kEfficiency_FullEnergy,
+    kEfficiency_SingleEscape,       // the full energy less 511 keV
+    kEfficiency_DoubleEscape,       // the full energy less 1022 keV
+    numberOf_EfficiencyCounts
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Batch measurement of the efficiency curves of the CLOVER, LEPS and NAIS arrays
+///
+/// Once a list of gamma-ray energies is given with /K600/efficiency/addEnergy,
+/// the particle gun fires energy i of the list in the events whose event ID
+/// modulo the number of energies is i, such that all energies are interleaved
+/// within one run. The generator must be in its gun mode (/K600/gun/mode gun),
+/// any other mode is refused with a fatal exception on its first event. At the end of each event the measured energies of every
+/// detector, as written to the ntuple, are classified into total, full-energy,
+/// single and double escape counts of the energy of the event, weighted with
+/// its statistical weight.
+///
+/// The counts are accumulated in a RunAccumulable and written at the end of
+/// every run to a table per detector of the efficiencies and their statistical
+/// errors, one line per energy.
+
+class EfficiencyCurve
+{
+public:
+    //  The gamma-ray energies, none for the normal operation of the particle gun
+    static void AddEnergy(G4double energy) { fEnergies.push_back(energy); }
+    static void ClearEnergies() { fEnergies.clear(); }
+    static G4bool IsActive() { return !fEnergies.empty(); }
+    
+    //  The energy index of an event and its energy
+    static G4int GetEnergyIndex(G4int eventID) { return eventID%fEnergies.size(); }
+    static G4double GetEnergy(G4int index) { return fEnergies[index]; }
+    
+    static void SetPeakWindow(G4double window) { fPeakWindow = window; }
+    static void SetFileName(const G4String& fileName) { fFileName = fileName; }
+    
+    //  Called by the master at the start of a run
+    static void BeginOfRun();
+    
+    //  A measured energy of a detector within the current event (keV)
+    static void ScoreEnergy(EfficiencyArray array, G4int detector, G4double energy);
+    
+    //  Classifies the measured energies of the event into the counts of its energy
+    static void EndOfEvent(G4int eventID, G4double weight);
+    
+    //  Called by the master at the end of a run, once the counts are merged
+    static void WriteTables();
+    
+private:
+    static std::vector<G4double>    fEnergies;
+    static G4double                 fPeakWindow;
+    static G4String                 fFileName;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -42,6 +42,7 @@
 #include "globals.hh"
 
 #include <fstream>
+#include <vector>
 using namespace std;
 
 //////////////////////////////////////////////////////////////////////////
@@ -132,9 +133,7 @@ const G4double      NAIS_NaICrystal_ThresholdEnergy = 6.;   // keV
 ///////////////     PADDLE, Plastic Scintillators - Energy Threshold     ///////////////////
 const G4double      PADDLE_ThresholdEnergy = 0.5;  //  MeV
 
-///////////////     Average particles per packet, (from beam intensity and frequency)     ///////
-const G4bool        Activate_CyclotronBeam_Timing = false;
-const G4int         Particles_per_Bunch = 100;  // Particles per Bunch
+///////////////     Cyclotron beam bunch structure, see PrimaryGeneratorAction.hh     ///////
 
 
 
@@ -149,10 +148,12 @@ const G4double sinThetaU = 0.766044443;
 const G4double tanThetaU = 1.191753593;
 
 
+class RunAction;
+
 class EventAction : public G4UserEventAction
 {
 public:
-    EventAction();
+    EventAction(RunAction* runAction);
     virtual ~EventAction();
     
     virtual void  BeginOfEventAction(const G4Event* event);
@@ -401,11 +402,56 @@ public:
 
     
 private:
+    //  Accumulates the hits collections of the sensitive detectors into the event arrays
+    void ReadHitsCollections(const G4Event* event);
+    
+    //  Resets every channel of the event arrays, only required once at construction
+    void ClearAllChannels();
+    //  Resets the channels listed within the touched lists of the previous event
+    void ClearTouchedChannels();
+    
+    //  Adds a row to the ntuple, together with the statistical weight of the event
+    void AddWeightedNtupleRow(G4int ntupleId);
+    
+    RunAction*  fRunAction;
+    
+    //  Statistical weight of the event, the product of the weights of its primary vertices
+    G4double    fEventWeight;
+    
+    ////    The keys of the touched lists follow the nesting order of the original loops (outermost first),
+    ////    a sorted list is therefore traversed in the same order as the full arrays used to be
+    G4int TIARAKey(G4int i, G4int j, G4int l, G4int k) const
+    {return ((i*TIARA_TotalTimeSamples + k)*16 + j)*8 + l;};
+    void DecodeTIARAKey(G4int key, G4int& i, G4int& j, G4int& l, G4int& k) const
+    {l = key%8; key /= 8; j = key%16; key /= 16; k = key%TIARA_TotalTimeSamples; i = key/TIARA_TotalTimeSamples;};
+    
+    //  Channels filled within the current event, [i][k] keys for PADDLE/NAIS and [i][k][j] keys for the CLOVER/LEPS crystals
+    std::vector<G4int>  TIARA_Touched;
+    std::vector<G4int>  PADDLE_Touched;
+    std::vector<G4int>  CLOVER_HPGeCrystal_Touched;
+    std::vector<G4int>  LEPS_HPGeCrystal_Touched;
+    std::vector<G4int>  NAIS_Touched;
+    
+    //  Number of VDC_Observables slots filled within the current event
+    G4int     VDC_nofSlots;
+    
     G4double  fEnergyAbs;
     G4double  fEnergyGap;
     G4double  fTrackLAbs;
     G4double  fTrackLGap;
     
+    //  Hits collection IDs, -1 for detectors which are absent
+    G4bool    fHCIDsInitialised;
+    G4int     fTIARA_HCID;
+    G4int     fVDC_HCID;
+    G4int     fVDCTraverse_HCID;
+    G4int     fPADDLE_HCID;
+    G4int     fCLOVER_HCID;
+    G4int     fParaffinBox_HCID;
+    G4int     fIronBox_HCID;
+    G4int     fLEPS_HCID;
+    G4int     fNAIS_HCID;
+    
     
     
     
@@ -441,7 +487,7 @@ inline void EventAction::RayTrace(G4int VDCNo, G4int XU_Wireplane)
     
     
     
-    for(G4int k=0; k<hit_buffersize; k++)
+    for(G4int k=0; k<VDC_nofSlots; k++)
     {
         if( (VDC_Observables[0][k]>=wireChannelMin) && (VDC_Observables[0][k]<=wireChannelMax) && (VDC_Observables[1][k]>EnergyThreshold) )
         {
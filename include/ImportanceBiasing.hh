@@ -0,0 +1,124 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef ImportanceBiasing_h
+#define ImportanceBiasing_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+class G4VPhysicalVolume;
+
+//////////////////////////////////////////////////////////////////////////
+//              NEUTRON SHIELDING - GEOMETRY IMPORTANCE BIASING
+//////////////////////////////////////////////////////////////////////////
+
+const G4bool        ImportanceBiasing_Active = false;   // The neutrons are split and rouletted between the shells of the ImportanceWorld
+const char* const   ImportanceBiasing_WorldName = "ImportanceWorld";
+const char* const   ImportanceBiasing_Particle = "neutron";
+
+////    Concentric shells around the AmBe source, through the IronBox and the ParaffinBox
+const G4int         numberOf_ImportanceShells = 6;
+const G4double      ImportanceShell_OuterRadius[numberOf_ImportanceShells] = {2., 4., 6., 8., 11., 16.}; // cm
+const G4double      ImportanceShell_Importance[numberOf_ImportanceShells] = {1., 2., 4., 8., 16., 32.};
+
+enum ImportanceTally
+{
+    kImportanceTally_ParaffinBox = 0,
+    kImportanceTally_IronBox,
+    numberOf_ImportanceTallies
+};
+
+const char* const   ImportanceTally_Name[numberOf_ImportanceTallies] = {"ParaffinBox", "IronBox"};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Geometry importance biasing of the neutron shielding studies
+///
+/// The neutrons crossing from one shell of the ImportanceWorld into the next
+/// are split, or rouletted, by the ratio of the importances of both shells, and
+/// their secondaries inherit their weight. The BoxSD scores the weighted energy
+/// deposit, such that the energy deposit of an event remains an unbiased
+/// estimate of its mean, while its spectrum is no longer that of an analog run.
+///
+/// The mean energy deposits of the ParaffinBox and the IronBox per event are
+/// tallied in a RunAccumulable and printed at the end of every run, together
+/// with their figure of merit. An analog run, with every importance
+/// set to 1 by /K600/importance/analog, is the reference against which the
+/// following biased runs are checked.
+
+class ImportanceBiasing
+{
+public:
+    //  Every importance set to 1, the tracking is then analog
+    static void SetAnalog(G4bool analog) { fAnalog = analog; }
+    static G4bool IsAnalog() { return fAnalog; }
+    //  The importance of a shell, 0 for its default of ImportanceShell_Importance
+    static void SetImportance(G4int shell, G4double importance);
+    static G4double GetImportance(G4int shell);
+    
+    //  The physical volumes of the shells, innermost first, and of the world of the ImportanceWorld
+    static void SetCells(const std::vector<const G4VPhysicalVolume*>& shells, const G4VPhysicalVolume* world);
+    
+    //  Called by the master at the start of a run
+    static void BeginOfRun();
+    
+    //  Called by every thread at the start of a run, fills its importance store
+    static void BeginOfThreadRun();
+    
+    //  The energy deposits of an event (keV), weighted with the track and the event weights
+    static void ScoreEvent(G4double paraffinBoxEDep, G4double ironBoxEDep);
+    
+    //  Called by the master at the end of a run, once the tallies are merged
+    static void PrintTallies();
+    
+private:
+    static G4bool                               fAnalog;
+    static G4double                             fImportance[numberOf_ImportanceShells];    // 0 for the default
+    static std::vector<const G4VPhysicalVolume*> fShells;
+    static const G4VPhysicalVolume*             fWorld;
+    
+    ////    The tallies of the last analog run, the reference of the biased runs
+    static G4bool                               fHasReference;
+    static G4double                             fReferenceMean[numberOf_ImportanceTallies];
+    static G4double                             fReferenceError[numberOf_ImportanceTallies];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef ImportanceWorld_h
+#define ImportanceWorld_h 1
+
+#include "G4VUserParallelWorld.hh"
+#include "globals.hh"
+
+class G4VPhysicalVolume;
+class DetectorConstruction;
+
+/// Parallel world of the importance biasing
+///
+/// Concentric spherical shells around the AmBe source, of the outer radii
+/// ImportanceShell_OuterRadius, which cut the IronBox and the ParaffinBox into
+/// layers. The shells are placed within each other, innermost last, and are
+/// given their importances by ImportanceBiasing at the start of every run.
+
+class ImportanceWorld : public G4VUserParallelWorld
+{
+public:
+    ImportanceWorld(const G4String& worldName, const DetectorConstruction* detector);
+    virtual ~ImportanceWorld();
+    
+    virtual void Construct();
+    
+    //  Known once the geometry has been constructed
+    G4VPhysicalVolume* GetWorldVolume() const { return fWorldVolume; }
+    
+private:
+    const DetectorConstruction*     fDetector;
+    G4VPhysicalVolume*              fWorldVolume;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
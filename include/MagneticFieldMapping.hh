@@ -46,28 +46,72 @@
 
 using namespace std;
 
+/// Binary field map format
+///
+/// A binary field map holds this header, followed by the contiguous field grid
+/// (the interleaved Bx, By, Bz, 0 of every grid point, in doubles) exactly as it
+/// is laid out in memory. It is memory-mapped read-only, such that every thread
+/// building the field shares the same pages without parsing the field map.
+/// The bounds are stored in ascending order, the axes which were tabulated in
+/// descending order being flagged. Binary field maps are produced from the
+/// .TABLE field maps by the FieldMapConverter.
+
+struct MagneticFieldMapHeader
+{
+  char   magic[8];        // "K600FMAP"
+  int    version;
+  int    flags;           // kInvertX | kInvertY | kInvertZ
+  int    nx, ny, nz;
+  int    nofComponents;   // 4, the padded (Bx, By, Bz, 0)
+  double lengthUnit;      // the Geant4 units of the bounds
+  double fieldUnit;       // the Geant4 units of the field values
+  double minx, maxx, miny, maxy, minz, maxz;
+  char   reserved[32];    // pads the header to 128 bytes, aligning the payload
+};
+
 class MagneticFieldMapping
 #ifndef STANDALONE
  : public G4MagneticField
 #endif
 {
   
-  // Storage space for the table
-  vector< vector< vector< double > > > xField;
-  vector< vector< vector< double > > > yField;
-  vector< vector< vector< double > > > zField;
+  // Storage space for the table, a single contiguous grid of the
+  // interleaved field components (Bx, By, Bz, 0) of every grid point,
+  // the fourth component pads a grid point to two SIMD pairs.
+  // fField points either to fFieldStorage or into the memory-mapped
+  // binary field map.
+  vector< double > fFieldStorage;
+  const double* fField;
+  void* fMapping;
+  size_t fMappingSize;
   // The dimensions of the table
   int nx,ny,nz; 
+  // The strides between neighbouring grid points in fField
+  int strideX, strideY, strideZ;
   // The physical limits of the defined region
   double minx, maxx, miny, maxy, minz, maxz;
   // The physical extent of the defined region
   double dx, dy, dz;
+  // The grid coordinates of a point are (x - xOrigin)*xScale, the
+  // inversion of an axis being folded into its origin and scale
+  double xOrigin, yOrigin, zOrigin;
+  double xScale, yScale, zScale;
   double fZoffset;
   bool invertX, invertY, invertZ;
 
+  // Reads a binary field map, returns false if the file is not a binary field map
+  bool ReadBinary( const char* filename );
+  // Reads a .TABLE field map
+  void ReadTable( const char* filename );
+
 public:
+  enum { kInvertX = 1, kInvertY = 2, kInvertZ = 4 };
+
   MagneticFieldMapping(const char* filename, double zOffset );
+  ~MagneticFieldMapping();
   void  GetFieldValue( const  double Point[4],
 		       double *Bfield          ) const;
+  // Writes the field map in the binary format
+  bool  WriteBinary( const char* filename ) const;
 };
 
@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef MeshCache_h
+#define MeshCache_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <stdint.h>
+#include <vector>
+
+class G4VSolid;
+
+/// The facets of a mesh model, as loaded from the cache or read from the mesh file
+
+struct MeshFacets
+{
+    MeshFacets() : key(0), isKeyValid(false), isCached(false), isRead(false) {}
+    
+    uint64_t                key;
+    G4bool                  isKeyValid;
+    G4bool                  isCached;
+    G4bool                  isRead;
+    
+    //  The nine vertex coordinates of every triangular facet
+    std::vector<G4double>   vertices;
+};
+
+/// Binary cache of the CADMesh tessellated solids
+///
+/// Parsing the PLY mesh models dominates the start-up of the executable. The
+/// facets of every tessellated solid that CADMesh has built are therefore
+/// written once to a binary cache file, which subsequent runs memory-map and
+/// build the G4TessellatedSolid from directly.
+///
+/// A cache file is keyed by a hash of the contents of the mesh file together
+/// with the mesh type, units, offset and facet orientation, such that an edited
+/// mesh model or a changed placement is never served from a stale cache. The
+/// key also names the parser that produced the facets, MeshReader or CADMesh,
+/// and its version, such that the facets of one are never served in place of
+/// the other, nor those of an outdated parser.
+/// The cache directory is taken from the K600_MESH_CACHE environment variable,
+/// defaulting to "MeshCache" within the working directory.
+///
+/// Loading a mesh is split in two stages. LoadFacets() reads the facets from
+/// the cache or, on a cache miss, from the PLY or STL mesh file (MeshReader.hh)
+/// without creating any Geant4 object, and may be called concurrently for
+/// different meshes. BuildSolid() only assembles the G4TessellatedSolid from
+/// the facets, and caches those read from the mesh file, on the thread
+/// constructing the geometry. Mesh types which MeshReader does not read are
+/// parsed by CADMesh within BuildSolid().
+
+class MeshCache
+{
+public:
+    //  Drop-in replacement for CADMesh(meshPath, meshType, units, offset, reverse).TessellatedMesh()
+    static G4VSolid* TessellatedMesh(char* meshPath, char* meshType, G4double units, G4ThreeVector offset, G4bool reverse);
+    
+    //  Hashes the mesh file and reads its facets from the cache, or from the mesh file on a cache miss
+    static void LoadFacets(const char* meshPath, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse, MeshFacets& facets);
+    
+    //  Builds the solid from the loaded facets, or through CADMesh if none were loaded, the facets are released afterwards
+    static G4VSolid* BuildSolid(const char* meshPath, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse, MeshFacets& facets);
+    
+private:
+    static uint64_t ComputeKey(const void* meshData, size_t meshSize, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse);
+    static uint64_t ParserKey(uint64_t meshKey, const char* parser, G4int parserVersion);
+    static G4String CacheDirectory();
+    static G4String CacheFileName(uint64_t key);
+    
+    static G4bool ReadCache(const G4String& cacheFileName, uint64_t key, std::vector<G4double>& vertices);
+    static G4bool GetTriangularFacets(const G4VSolid* solid, std::vector<G4double>& vertices);
+    static void WriteCache(const G4String& cacheFileName, uint64_t key, const std::vector<G4double>& vertices);
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
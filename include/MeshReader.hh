@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+
+#ifndef MeshReader_h
+#define MeshReader_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Reader of the PLY and STL mesh models
+///
+/// Reads the triangular facets of a mesh model from its file contents, without
+/// creating any Geant4 object, such that the meshes may be read concurrently.
+/// The facets are placed as CADMesh places them, every vertex at its position
+/// times the units less the offset, and with the first two vertices of every
+/// facet swapped when reversed. PLY meshes may be ASCII or binary of either
+/// byte order, their polygons are split into triangle fans. STL meshes may be
+/// ASCII or binary.
+///
+/// Any other mesh type, or a malformed mesh, is not read and is left to
+/// CADMesh.
+
+class MeshReader
+{
+public:
+    //  Version of the facets read, part of the key of the cached facets, to be incremented with any change to the facets read
+    static const G4int kVersion = 1;
+    
+    //  Whether the mesh type is read, otherwise it is left to CADMesh
+    static G4bool IsReadable(const char* meshType);
+    
+    //  Appends the nine vertex coordinates of every triangular facet, returns false if the mesh could not be read
+    static G4bool Read(const void* data, size_t size, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse, std::vector<G4double>& vertices);
+    
+private:
+    //  The vertex positions and the vertex indices of the triangles, as given in the file
+    static G4bool ReadPLY(const char* data, size_t size, std::vector<G4double>& points, std::vector<size_t>& triangles);
+    static G4bool ReadSTL(const char* data, size_t size, std::vector<G4double>& points, std::vector<size_t>& triangles);
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,104 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef MeshRegistry_h
+#define MeshRegistry_h 1
+
+#include "MeshCache.hh"
+#include "G4ThreeVector.hh"
+#include "G4Threading.hh"
+#include "globals.hh"
+
+#include <map>
+#include <vector>
+
+class G4VSolid;
+
+/// Registry of the CAD mesh models of the geometry
+///
+/// Every mesh is requested with its path, type, units, offset and facet
+/// orientation, identical requests share a single entry and hence a single
+/// G4VSolid. Load() reads the facets of all pending meshes concurrently on a
+/// pool of threads, from the cache or, on a cache miss, by parsing the mesh
+/// file. Only the assembly of the tessellated solids from these facets is left
+/// to the calling thread, when first handed out by GetSolid(), such that the
+/// start-up is bounded by the largest mesh rather than by the sum of all. A
+/// mesh which has not been loaded when its solid is requested is loaded on
+/// demand.
+
+class MeshRegistry
+{
+public:
+    MeshRegistry();
+    ~MeshRegistry();
+    
+    //  Registers a mesh and returns its identifier
+    G4int Request(const char* meshPath, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse);
+    
+    //  Loads the facets of all pending meshes concurrently
+    void Load();
+    
+    //  The shared solid of a requested mesh
+    G4VSolid* GetSolid(G4int meshID);
+    
+private:
+    struct MeshEntry
+    {
+        G4String        path;
+        G4String        type;
+        G4double        units;
+        G4ThreeVector   offset;
+        G4bool          reverse;
+        
+        G4bool          isLoaded;
+        MeshFacets      facets;
+        G4VSolid*       solid;
+    };
+    
+    static G4ThreadFunReturnType LoadWorker(G4ThreadFunArgType registry);
+    
+    std::vector<MeshEntry*>     fEntries;
+    std::map<G4String, G4int>   fEntryIDs;
+    
+    //  The entries still to be loaded, consumed by the load workers
+    std::vector<G4int>          fPending;
+    size_t                      fNextPending;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
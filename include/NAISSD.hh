@@ -0,0 +1,73 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef NAISSD_h
+#define NAISSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "CrystalHit.hh"
+
+#include <vector>
+
+class G4Step;
+class G4HCofThisEvent;
+
+/// NAIS sensitive detector class
+///
+/// In ProcessHits(), the energy deposit of a step within a NAIS NaI crystal
+/// (copy number = NAISNo) is accumulated in the hit of that detector and time sample.
+
+class NAISSD : public G4VSensitiveDetector
+{
+public:
+    NAISSD(const G4String& name, const G4String& hitsCollectionName);
+    virtual ~NAISSD();
+    
+    // methods from base class
+    virtual void   Initialize(G4HCofThisEvent* hitCollection);
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory* history);
+    
+private:
+    CrystalHitsCollection*  fHitsCollection;
+    
+    //  (crystal, time sample) -> index within fHitsCollection, -1 if not yet hit within this event
+    std::vector<G4int>      fHitIndex;
+    std::vector<G4int>      fTouchedIndices;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,109 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef PADDLEHit_h
+#define PADDLEHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+/// PADDLE hit class
+///
+/// It defines the data members to store the energy deposited (MeV) within a PADDLE
+/// detector during one time sample, the time of flight (ns) tagged by the latest step,
+/// and the energy weighted local x and y positions (MeV*mm).
+
+class PADDLEHit : public G4VHit
+{
+public:
+    PADDLEHit(G4int PADDLENo, G4int timeSample);
+    virtual ~PADDLEHit();
+    
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+    
+    // methods to handle data
+    void Add(G4double edep, G4double EW_xpos, G4double EW_ypos)
+    {
+        fEdep += edep;
+        fEWpositionX += EW_xpos;
+        fEWpositionY += EW_ypos;
+    };
+    void TagTOF(G4double time) {fTOF = time;};
+    
+    // get methods
+    G4int       GetPADDLENo() const     {return fPADDLENo;};
+    G4int       GetTimeSample() const   {return fTimeSample;};
+    G4double    GetEdep() const         {return fEdep;};
+    G4double    GetTOF() const          {return fTOF;};
+    G4double    GetEWpositionX() const  {return fEWpositionX;};
+    G4double    GetEWpositionY() const  {return fEWpositionY;};
+    
+private:
+    G4int       fPADDLENo;
+    G4int       fTimeSample;
+    G4double    fEdep;
+    G4double    fTOF;
+    G4double    fEWpositionX;
+    G4double    fEWpositionY;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+typedef G4THitsCollection<PADDLEHit> PADDLEHitsCollection;
+
+extern G4ThreadLocal G4Allocator<PADDLEHit>* PADDLEHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* PADDLEHit::operator new(size_t)
+{
+    if(!PADDLEHitAllocator) PADDLEHitAllocator = new G4Allocator<PADDLEHit>;
+    return (void *) PADDLEHitAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void PADDLEHit::operator delete(void *hit)
+{
+    PADDLEHitAllocator->FreeSingle((PADDLEHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -40,16 +40,111 @@
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "globals.hh"
 #include "G4ThreeVector.hh"
+#include "G4LorentzVector.hh"
+
+#include <vector>
 
 class G4ParticleGun;
 class G4Event;
+class G4ParticleDefinition;
+class ReactionKinematicsTable;
+class PrimaryGeneratorMessenger;
+class DetectorConstruction;
+class PrimaryVertexFile;
+
+///////////////     Cyclotron beam, the defaults of the bunch mode of the generator     ///////
+////    Average particles per packet, (from beam intensity and frequency)
+const G4bool        Activate_CyclotronBeam_Timing = false;
+const G4int         Particles_per_Bunch = 100;  // Particles per Bunch
+const G4double      CyclotronBeam_RFPeriod = 62.; // ns, ~16 MHz RF
+const G4int         CyclotronBeam_BunchesPerEvent = 1;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+////    The primary stage of the generator
+enum GeneratorMode
+{
+    kGunMode = 0,       // the particle of the G4ParticleGun
+    kReactionMode,      // binary reaction of the beam on the target
+    kDecayMode,         // decay of an excited nucleus at rest
+    kFileMode           // primaries read from a primary vertex file
+};
+
+////    Momentum direction of the particle gun
+enum GunDirection
+{
+    kIsotropicDirection = 0,
+    kForwardHemisphere,
+    kBackwardHemisphere,
+    kFixedDirection,    // the direction of the G4ParticleGun
+    kBiasedDirection    // towards the instrumented solid angle, with the statistical weight on the vertex
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Parameters of the generator stages, set from macros by the PrimaryGeneratorMessenger
+///
+/// The energies are in MeV, the reaction masses in u and the angles in rad.
+
+struct PrimaryGeneratorSettings
+{
+    PrimaryGeneratorSettings();
+    
+    GeneratorMode           mode;
+    
+    ////    Source, applied on top of the /gun/ settings in every mode
+    GunDirection            direction;
+    G4double                energySigma;
+    G4double                targetThickness;    // vertices uniformly distributed along z
+    G4double                timeSigma;
+    G4double                biasingFraction;    // of the biased directions drawn towards the detectors
+    
+    ////    Cyclotron bunch mode, a Poisson number of primaries per RF bunch with the time spread as the beam-time jitter
+    G4bool                  bunchMode;
+    G4double                particlesPerBunch;  // mean
+    G4double                rfPeriod;
+    G4int                   bunchesPerEvent;
+    
+    ////    Reaction, m[0](m[1], m[2])m[3] with the beam along +z
+    G4double                masses[4];
+    G4int                   ejectileZ, ejectileA;
+    G4int                   recoilZ, recoilA;
+    std::vector<G4double>   beamEnergies;       // one of which is chosen per event
+    G4double                beamEnergySigma;
+    G4double                excitation;
+    G4double                excitationFWHM;
+    G4double                thetaMin, thetaMax; // ejectile scattering angle
+    G4bool                  emitEjectile, emitRecoil;
+    G4bool                  decayRecoil;
+    
+    ////    Decay of the excited nucleus into an emitted particle and a daughter nucleus
+    G4double                parentExcitation;   // decay mode only, the recoil excitation otherwise
+    G4double                separationEnergy;
+    G4int                   emittedZ, emittedA;
+    G4int                   daughterZ, daughterA;
+    std::vector<G4double>   daughterExcitations;
+    std::vector<G4double>   daughterWeights;
+    G4bool                  emitDaughter, emitGamma;
+    
+    ////    Primary vertex file, event i of a run being event firstEvent + i of the file
+    G4String                inputFileName;
+    G4int                   inputFirstEvent;
+};
 
-/// The primary generator action class with particle gum.
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// The primary generator action class with particle gun.
 ///
-/// It defines a single particle which hits the calorimeter
-/// perpendicular to the input face. The type of the particle
-/// can be changed via the G4 build-in commands of G4ParticleGun class
-/// (see the macros provided with this example).
+/// The generator is composed of a primary stage (the particle gun, a binary
+/// reaction or a decay at rest) and an optional decay stage of the reaction
+/// recoil, all of which are selected and parameterised from macros with the
+/// /K600/gun/, /K600/reaction/ and /K600/decay/ commands. Alternatively, the
+/// primaries of every event are read from a primary vertex file (/K600/input/),
+/// each thread reading the file events of its own event IDs. In the bunch mode an
+/// event holds the pile-up of one or more RF bunches of the cyclotron, each
+/// with a Poisson number of primary vertices. The particle, energy,
+/// position and direction of the G4ParticleGun (/gun/ commands) serve as the
+/// nominal values, which are restored after every event.
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -59,36 +154,47 @@ public:
     
     virtual void GeneratePrimaries(G4Event* event);
     
-    // set methods
-    void SetRandomFlag(G4bool value);
+    PrimaryGeneratorSettings& GetSettings() { return fSettings; }
+    
+    //  To be called whenever the reaction or decay settings are changed
+    void ResetCaches();
     
 private:
-    G4ParticleGun*  fParticleGun; // G4 particle gun
+    void GenerateGun(G4Event* event);
+    void GenerateReaction(G4Event* event);
+    void GenerateDecay(G4Event* event, G4double parentExcitation, const G4LorentzVector& parentMomentum);
+    void GenerateFromFile(G4Event* event);
     
+    void Emit(G4Event* event, G4ParticleDefinition* particle, G4double kineticEnergy, const G4ThreeVector& direction);
+    G4ThreeVector IsotropicDirection() const;
+    G4ThreeVector BiasedDirection(const G4ThreeVector& vertex, G4double& weight);
+    G4ParticleDefinition* GetIon(G4int Z, G4int A) const;
     
-    G4double    mx;
-    G4double    my;
-    G4double    mz;
+    G4ParticleGun*  fParticleGun; // G4 particle gun
     
-    G4double    theta;
-    G4double    phi;
+    PrimaryGeneratorSettings    fSettings;
+    PrimaryGeneratorMessenger*  fMessenger;
     
-    G4double    beamEnergy;
-    G4double    energy;
-    G4double    recoilExcitationEnergy;
-    G4double    alphaSeperationEnergy;
-    G4double    protonSeperationEnergy;
-    G4double    daughterExcitationEnergy;
-    G4int       alphaDecayMode;
+    //  Tabulated kinematics per beam energy, shared by all threads and owned by the ReactionKinematicsCache
+    std::vector<const ReactionKinematicsTable*> fKinematicsTables;
     
-    G4ThreeVector ejectileDirection;
-    G4ThreeVector recoilDirection;
+    //  Particle definitions of the reaction and decay, resolved on first use
+    G4ParticleDefinition*   fEjectile;
+    G4ParticleDefinition*   fRecoil;
+    G4ParticleDefinition*   fEmitted;
+    G4ParticleDefinition*   fDaughter;
     
+    //  Instrumented volumes of the geometry, resolved on first use
+    const DetectorConstruction*  fDetector;
+    std::vector<G4ThreeVector>   fConeAxes;
+    std::vector<G4double>        fConeCosAngles;
+    std::vector<G4double>        fConeSolidAngles;
     
+    //  Primary vertex file of the file mode, mapped on first use
+    PrimaryVertexFile*  fInputFile;
+    G4bool              fEndOfInputReported;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 #endif
-
-
@@ -0,0 +1,126 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef PrimaryGeneratorMessenger_h
+#define PrimaryGeneratorMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class PrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithoutParameter;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+
+/// Macro commands of the PrimaryGeneratorAction
+///
+/// /K600/gun/      selects the primary stage (gun, reaction or decay) and the
+///                 direction, energy, vertex and time distributions of the gun,
+///                 as well as the cyclotron bunch structure
+/// /K600/reaction/ parameterises the binary reaction and its recoil
+/// /K600/decay/    parameterises the decay of the excited nucleus
+/// /K600/input/    selects the primary vertex file of the file mode
+
+class PrimaryGeneratorMessenger : public G4UImessenger
+{
+public:
+    PrimaryGeneratorMessenger(PrimaryGeneratorAction* generatorAction);
+    virtual ~PrimaryGeneratorMessenger();
+    
+    virtual void SetNewValue(G4UIcommand* command, G4String newValue);
+    
+private:
+    G4UIcommand* CreateIonCommand(const char* name, const char* guidance);
+    
+    PrimaryGeneratorAction*     fGeneratorAction;
+    
+    G4UIdirectory*              fK600Directory;
+    
+    ////    Source
+    G4UIdirectory*              fGunDirectory;
+    G4UIcmdWithAString*         fModeCmd;
+    G4UIcmdWithAString*         fDirectionCmd;
+    G4UIcmdWithADoubleAndUnit*  fEnergySigmaCmd;
+    G4UIcmdWithADoubleAndUnit*  fTargetThicknessCmd;
+    G4UIcmdWithADoubleAndUnit*  fTimeSigmaCmd;
+    G4UIcmdWithADouble*         fBiasingFractionCmd;
+    
+    ////    Cyclotron bunches
+    G4UIcmdWithABool*           fBunchModeCmd;
+    G4UIcmdWithADouble*         fParticlesPerBunchCmd;
+    G4UIcmdWithADoubleAndUnit*  fRFPeriodCmd;
+    G4UIcmdWithAnInteger*       fBunchesPerEventCmd;
+    
+    ////    Reaction
+    G4UIdirectory*              fReactionDirectory;
+    G4UIcommand*                fMassesCmd;
+    G4UIcommand*                fEjectileCmd;
+    G4UIcommand*                fRecoilCmd;
+    G4UIcmdWithADoubleAndUnit*  fBeamEnergyCmd;
+    G4UIcmdWithADoubleAndUnit*  fAddBeamEnergyCmd;
+    G4UIcmdWithADoubleAndUnit*  fBeamEnergySigmaCmd;
+    G4UIcmdWithADoubleAndUnit*  fExcitationCmd;
+    G4UIcmdWithADoubleAndUnit*  fExcitationFWHMCmd;
+    G4UIcommand*                fThetaRangeCmd;
+    G4UIcmdWithABool*           fEmitEjectileCmd;
+    G4UIcmdWithABool*           fEmitRecoilCmd;
+    G4UIcmdWithABool*           fDecayRecoilCmd;
+    
+    ////    Decay
+    G4UIdirectory*              fDecayDirectory;
+    G4UIcmdWithADoubleAndUnit*  fParentExcitationCmd;
+    G4UIcmdWithADoubleAndUnit*  fSeparationEnergyCmd;
+    G4UIcommand*                fEmittedCmd;
+    G4UIcommand*                fDaughterCmd;
+    G4UIcmdWithoutParameter*    fClearDaughterStatesCmd;
+    G4UIcommand*                fAddDaughterStateCmd;
+    G4UIcmdWithABool*           fEmitDaughterCmd;
+    G4UIcmdWithABool*           fEmitGammaCmd;
+    
+    ////    Input
+    G4UIdirectory*              fInputDirectory;
+    G4UIcmdWithAString*         fInputFileNameCmd;
+    G4UIcmdWithAnInteger*       fInputFirstEventCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef PrimaryVertexFile_h
+#define PrimaryVertexFile_h 1
+
+#include "globals.hh"
+
+#include <cstddef>
+
+/// Binary primary vertex file format
+///
+/// A primary vertex file holds this header, followed by the index of the first
+/// record of every event (nofEvents + 1 long longs, the last one being
+/// nofRecords) and the records of all the events. Every record is a primary
+/// particle with its own vertex, in MeV, mm and ns. The statistical weight is
+/// that of the event, every record of an event carrying the same weight, which
+/// the converter checks. The file is memory-mapped
+/// read-only, such that every worker thread reads its events in place without
+/// any locking, the pages being shared by all the threads. Primary vertex files
+/// are produced from text files by the PrimaryVertexConverter.
+
+struct PrimaryVertexFileHeader
+{
+    char        magic[8];       // "K600PVTX"
+    int         version;
+    int         recordSize;     // sizeof(PrimaryVertexRecord)
+    long long   nofEvents;
+    long long   nofRecords;
+    char        reserved[32];   // pads the header to 64 bytes, aligning the index
+};
+
+struct PrimaryVertexRecord
+{
+    int         pdg;            // PDG code, 0 for an ion
+    int         Z, A;           // of an ion
+    int         reserved;
+    double      Ex;             // excitation energy of an ion
+    double      px, py, pz;     // momentum
+    double      x, y, z;        // vertex position
+    double      t;              // vertex time
+    double      weight;         // statistical weight of the event
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class PrimaryVertexFile
+{
+public:
+    PrimaryVertexFile(const G4String& fileName);
+    ~PrimaryVertexFile();
+    
+    long long GetNumberOfEvents() const { return fNofEvents; }
+    
+    //  The records of an event, 0 <= event < GetNumberOfEvents()
+    const PrimaryVertexRecord* GetRecords(long long event, G4int& nofRecords) const
+    {
+        nofRecords = (G4int) (fFirstRecord[event+1] - fFirstRecord[event]);
+        return fRecords + fFirstRecord[event];
+    }
+    
+    //  Converts a text file of "event pdg Z A Ex px py pz x y z t weight" lines, with the events in ascending order and one weight per event
+    static G4bool Convert(const char* textFileName, const char* binaryFileName);
+    
+private:
+    void*                       fMapping;
+    size_t                      fMappingSize;
+    long long                   fNofEvents;
+    const long long*            fFirstRecord;
+    const PrimaryVertexRecord*  fRecords;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,79 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+
+#ifndef PrimaryVertexWeight_h
+#define PrimaryVertexWeight_h 1
+
+#include "G4VUserPrimaryVertexInformation.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4ios.hh"
+#include "globals.hh"
+
+/// Statistical weight of a primary vertex of a biased generator
+///
+/// The weight is carried as the user information of the vertex rather than as
+/// its G4PrimaryVertex weight, which G4PrimaryTransformer would copy into the
+/// weight of every track of the vertex. The track weights thus remain those of
+/// the importance biasing alone (ImportanceBiasing.hh), whereas the weight of
+/// an event, the product of the weights of its vertices, is written to the
+/// EventWeight column of the ntuples (EventAction).
+
+class PrimaryVertexWeight : public G4VUserPrimaryVertexInformation
+{
+public:
+    PrimaryVertexWeight(G4double weight) : fWeight(weight) {}
+    virtual ~PrimaryVertexWeight() {}
+    
+    virtual void Print() const { G4cout << "PrimaryVertexWeight: " << fWeight << G4endl; }
+    
+    G4double GetWeight() const { return fWeight; }
+    
+    //  The weight of a vertex, 1 without a PrimaryVertexWeight
+    static G4double GetWeight(const G4PrimaryVertex* vertex)
+    {
+        const PrimaryVertexWeight* info = dynamic_cast<const PrimaryVertexWeight*>(vertex->GetUserInformation());
+        return info ? info->GetWeight() : 1.;
+    }
+    
+private:
+    G4double    fWeight;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,104 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef ProgressMonitor_h
+#define ProgressMonitor_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+///////////////     PROGRESS - Defaults     ///////////////////
+const G4double      ProgressMonitor_DefaultInterval = 10.;     // s, wall-clock time between reports
+const G4double      ProgressMonitor_FlushInterval = 1.;        // s, wall-clock time between the updates of a thread
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Rate-limited progress of a run
+///
+/// Every thread counts its events locally and only merges its count into the
+/// totals once per ProgressMonitor_FlushInterval, the thread which finds the
+/// report interval elapsed then prints a single line with the events done, the
+/// event rates of the run and of the threads, the estimated time remaining and
+/// the peak resident memory of the process. The same values may be appended to
+/// a log file, one line of key=value pairs per report, for the monitoring of
+/// batch jobs.
+///
+/// The settings are made on the master only, with /K600/progress/, and are read
+/// by the worker threads during the run.
+
+class ProgressMonitor
+{
+public:
+    //  Wall-clock time between reports, a non-positive interval reports the end of the run only
+    static void SetInterval(G4double interval) { fInterval = interval; }
+    static G4double GetInterval() { return fInterval; }
+    
+    //  The log file of the machine-readable reports, none for an empty name
+    static void SetLogFileName(const G4String& fileName) { fLogFileName = fileName; }
+    static const G4String& GetLogFileName() { return fLogFileName; }
+    
+    //  Called by the master at the start and at the end of a run
+    static void BeginOfRun(G4int runID, G4int nofEventsToBeProcessed);
+    static void EndOfRun(G4int nofEvents);
+    
+    //  Called by every thread at the start and at the end of its run, and at the end of each of its events
+    static void BeginOfThreadRun();
+    static void EndOfThreadRun();
+    static void EventDone();
+    
+private:
+    static void Flush(G4double wallTime);
+    static void Report(G4double wallTime, G4bool isFinal);
+    
+    static G4double             fInterval;
+    static G4String             fLogFileName;
+    
+    ////    The state of the current run, guarded by a mutex
+    static G4int                fRunID;
+    static G4long               fNofEventsToBeProcessed;
+    static G4long               fNofEvents;
+    static G4long               fNofEventsReported;
+    static G4double             fStartTime;
+    static G4double             fReportTime;
+    static std::vector<G4long>  fThreadEvents;
+    static std::vector<G4long>  fThreadEventsReported;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
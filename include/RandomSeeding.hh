@@ -0,0 +1,89 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef RandomSeeding_h
+#define RandomSeeding_h 1
+
+#include "globals.hh"
+
+namespace CLHEP { class HepRandomEngine; }
+
+///////////////     RANDOM NUMBERS - Defaults     ///////////////////
+const long          RandomSeeding_DefaultSeed = 1234567;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Reproducible seeding of the random number engines
+///
+/// The engine is reseeded at the start of every event with seeds derived from
+/// the run seed, the run ID and the event ID alone, such that an event is
+/// independent of the thread which processes it and of the events before it.
+/// Any event is thereby re-run in isolation by replaying it with the same run
+/// seed (/K600/random/replayEvent <run> <event> followed by /run/beamOn 1).
+///
+/// The run seed and the replay are set on the master only, and are read by the
+/// worker threads during the run.
+
+class RandomSeeding
+{
+public:
+    //  Creates the engine of the given name (MixMax, MTwist, Ranecu or Ranlux), 0 for an unknown name
+    static CLHEP::HepRandomEngine* CreateEngine(const G4String& name);
+    //  The engine used whenever none is chosen, MixMax when available
+    static const char* GetDefaultEngineName();
+    
+    static void SetRunSeed(long seed) { fRunSeed = seed; }
+    static long GetRunSeed() { return fRunSeed; }
+    
+    //  The following runs are seeded as run replayRun, starting at its event replayEvent
+    static void SetReplay(G4int replayRun, G4int replayEvent) { fReplayRun = replayRun; fReplayEvent = replayEvent; }
+    static void ResetReplay() { fReplayRun = -1; fReplayEvent = 0; }
+    
+    //  Reseeds the engine of the calling thread, called before the primaries of an event are generated
+    static void SeedEvent(G4int runID, G4int eventID);
+    
+    //  Prints the run seed and the engine of the run
+    static void PrintRunSeed(G4int runID);
+    
+private:
+    static long     fRunSeed;
+    static G4int    fReplayRun;
+    static G4int    fReplayEvent;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,107 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef ReactionKinematicsCache_h
+#define ReactionKinematicsCache_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+///////////////     REACTION KINEMATICS - Tabulation     ///////////////////
+const G4double      ReactionKinematics_ThetaStep = 0.002;   // deg
+const G4double      ReactionKinematics_ExStep = 0.001;      // MeV
+const G4int         ReactionKinematics_MaxPoints = 4000001; // per table
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Tabulated binary reaction kinematics
+///
+/// The ejectile and recoil kinetic energies and the recoil angle of a reaction
+/// (masses in u, beam energy in MeV, see BiRelKin.hh) are computed once on a
+/// grid of ejectile scattering angles (deg) and recoil excitation energies
+/// (MeV), and bilinearly interpolated thereafter. The interpolation error,
+/// sampled at the centres of all the grid cells, is reported when the table is
+/// built.
+
+class ReactionKinematicsTable
+{
+public:
+    ReactionKinematicsTable(const G4double* m, G4double T0, G4double thetaMin, G4double thetaMax, G4double ExMin, G4double ExMax);
+    
+    G4bool IsInside(G4double ThetaSCAT, G4double Ex) const
+    {
+        return ThetaSCAT >= fThetaMin && ThetaSCAT <= fThetaMax && Ex >= fExMin && Ex <= fExMax;
+    }
+    
+    //  Within the tabulated range only, see IsInside()
+    void Interpolate(G4double ThetaSCAT, G4double Ex, G4double& T2, G4double& T3, G4double& ThetaRecoil) const;
+    
+    //  Exact kinematics, outside of the tabulated range
+    void Solve(G4double ThetaSCAT, G4double Ex, G4double& T2, G4double& T3, G4double& ThetaRecoil) const;
+    
+    //  Maximum interpolation errors of T2 (MeV), T3 (MeV) and ThetaRecoil (deg)
+    G4double GetErrorBound(G4int quantity) const { return fErrorBound[quantity]; }
+    
+private:
+    G4double                fMass[4];
+    G4double                fT0;
+    
+    G4double                fThetaMin, fThetaMax, fThetaStep;
+    G4double                fExMin, fExMax, fExStep;
+    G4int                   fNofThetaPoints, fNofExPoints;
+    
+    //  T2, T3 and ThetaRecoil per grid point, the scattering angle running fastest
+    std::vector<G4double>   fTable;
+    
+    G4double                fErrorBound[3];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Cache of the kinematics tables, keyed by the masses, the beam energy and the
+/// tabulated ranges of the scattering angle and excitation energy. A table is
+/// built on its first request and shared, read only, by all the threads.
+
+class ReactionKinematicsCache
+{
+public:
+    static const ReactionKinematicsTable* GetTable(const G4double* m, G4double T0, G4double thetaMin, G4double thetaMax, G4double ExMin, G4double ExMax);
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,151 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef ResponseMatrix_h
+#define ResponseMatrix_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+///////////////     RESPONSE MATRIX - Defaults     ///////////////////
+const G4double      ResponseMatrix_DefaultIncidentMin = 50.;      // keV
+const G4double      ResponseMatrix_DefaultIncidentMax = 3050.;    // keV
+const G4int         ResponseMatrix_DefaultIncidentBins = 300;
+const G4double      ResponseMatrix_DefaultDepositMax = 3100.;     // keV
+const G4int         ResponseMatrix_DefaultDepositBins = 1550;
+const char* const   ResponseMatrix_DefaultFileName = "K600_response.RSPM";
+
+////    The crystals of the response matrices, the NAIS crystals and the four crystals of every LEPS
+enum ResponseArray
+{
+    kResponse_NAIS = 0,
+    kResponse_LEPS,
+    numberOf_ResponseArrays
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Binary response matrix file format
+///
+/// A response matrix file holds this header, followed by every matrix of a
+/// crystal with any deposit: its record, the number of events of every incident
+/// energy bin (nofIncidentBins doubles) and the weighted counts of the
+/// deposited energy bins of every incident energy bin (nofIncidentBins rows of
+/// nofDepositBins floats). The energies are in keV, the deposited energy bins
+/// start at 0, and the numbers are written in the byte order of the host.
+
+struct ResponseMatrixFileHeader
+{
+    char        magic[8];       // "K600RSPM"
+    int         version;
+    int         nofIncidentBins;
+    int         nofDepositBins;
+    int         nofMatrices;
+    double      incidentMin, incidentMax;
+    double      depositMax;
+    char        reserved[16];   // pads the header to 64 bytes
+};
+
+struct ResponseMatrixRecord
+{
+    int         array;          // ResponseArray
+    int         detector;       // NAIS or LEPS number
+    int         crystal;        // LEPS crystal, 0 for a NAIS
+    int         reserved;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Response matrices of the NAIS and LEPS crystals for the unfolding of their spectra
+///
+/// Once active, the particle gun fires the incident energy bin i of the grid in
+/// the events whose event ID modulo the number of bins is i, at the centre of the
+/// bin or uniformly within it. The generator must be in its gun mode, without
+/// any efficiency curve, any other setting is refused with a fatal exception on
+/// its first event. The energies of every crystal after the resolution smearing
+/// of EndOfEventAction, which would be written to the ntuple, are binned into
+/// the dense matrix of the crystal, weighted with the statistical weight of the
+/// event, the matrix being allocated on the first deposit in the crystal. The counts are accumulated and reduced in double
+/// precision, such that a bin of more than 2^24 events keeps counting and
+/// small weights are not lost, and only rounded to floats in the file.
+///
+/// Every thread fills its own matrices, registered once per thread. The
+/// master reduces the matrices of all the threads at the end of a run, once
+/// the worker threads have finished theirs, without any locking, and writes
+/// them to a response matrix file.
+
+class ResponseMatrix
+{
+public:
+    static void SetActive(G4bool active) { fActive = active; }
+    static G4bool IsActive() { return fActive; }
+    
+    static void SetIncidentGrid(G4double min, G4double max, G4int nofBins);
+    static void SetDepositGrid(G4double max, G4int nofBins);
+    static void SetUniformInBin(G4bool uniform) { fUniformInBin = uniform; }
+    static void SetFileName(const G4String& fileName) { fFileName = fileName; }
+    
+    //  The incident energy bin of an event, and an incident energy of the bin
+    static G4int GetIncidentBin(G4int eventID) { return eventID%fNofIncidentBins; }
+    static G4double GenerateIncidentEnergy(G4int eventID);
+    
+    //  Called by the master at the start of a run
+    static void BeginOfRun();
+    
+    //  A measured energy of a crystal within the current event (keV)
+    static void ScoreEnergy(ResponseArray array, G4int detector, G4int crystal, G4double energy);
+    
+    //  Bins the measured energies of the event into the row of its incident energy
+    static void EndOfEvent(G4int eventID, G4double weight);
+    
+    //  Reduces the matrices of all the threads and writes them, called by the master at the end of a run
+    static void WriteMatrices();
+    
+private:
+    static G4bool       fActive;
+    static G4double     fIncidentMin, fIncidentMax;
+    static G4int        fNofIncidentBins;
+    static G4double     fDepositMax;
+    static G4int        fNofDepositBins;
+    static G4bool       fUniformInBin;
+    static G4String     fFileName;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
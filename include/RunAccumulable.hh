@@ -0,0 +1,124 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef RunAccumulable_h
+#define RunAccumulable_h 1
+
+#include "G4Cache.hh"
+#include "G4AutoLock.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Base of the counters of a run, reset and merged by the RunAccumulableManager
+
+class VRunAccumulable
+{
+public:
+    VRunAccumulable();
+    virtual ~VRunAccumulable();
+    
+    virtual void Reset() = 0;
+    virtual void Merge() = 0;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Counters of a run, accumulated by every thread without locking
+///
+/// Stands in for G4Accumulable and G4AccumulableManager, which only come with
+/// Geant4 10.2. Every thread accumulates into its own instance of T, which it
+/// adds to the merged instance at the end of a run, the master then reads the
+/// merged instance. T is default constructed empty and provides
+/// Merge(const T&), which adds the counters of another instance.
+
+template <class T>
+class RunAccumulable : public VRunAccumulable
+{
+public:
+    RunAccumulable() { G4MUTEXINIT(fMutex); }
+    virtual ~RunAccumulable() { G4MUTEXDESTROY(fMutex); }
+    
+    //  The instance of the calling thread
+    T& GetLocal() { return fLocal.Get(); }
+    
+    //  The merged instance, complete once every thread has merged
+    const T& GetMerged() const { return fMerged; }
+    
+    virtual void Reset()
+    {
+        G4AutoLock lock(&fMutex);
+        fMerged = T();
+    }
+    
+    //  Adds the instance of the calling thread to the merged instance and resets it
+    virtual void Merge()
+    {
+        G4AutoLock lock(&fMutex);
+        fMerged.Merge(fLocal.Get());
+        fLocal.Put(T());
+    }
+    
+private:
+    G4Cache<T>  fLocal;
+    T           fMerged;
+    G4Mutex     fMutex;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// The RunAccumulables of all the modules, driven by the RunAction
+
+class RunAccumulableManager
+{
+public:
+    //  Called by the master at the start of a run
+    static void Reset();
+    
+    //  Called by every thread at the end of a run, before the master reads the merged instances
+    static void Merge();
+    
+private:
+    friend class VRunAccumulable;
+    
+    //  Filled during the static initialisation, before any thread is started
+    static std::vector<VRunAccumulable*>& GetAccumulables();
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
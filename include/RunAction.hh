@@ -42,6 +42,9 @@
 
 class G4Run;
 
+////    DataTreeSim, GeometryAnalysisTree and InputVariableTree
+const G4int numberOf_Ntuples = 3;
+
 /// Run action class
 ///
 /// It accumulates statistic and computes dispersion of the energy deposit
@@ -68,6 +71,12 @@ public:
     
     virtual void BeginOfRunAction(const G4Run*);
     virtual void   EndOfRunAction(const G4Run*);
+    
+    //  The column of the statistical weight of the event, the last column of every ntuple
+    G4int GetEventWeightColumn(G4int ntupleId) const { return fEventWeightColumn[ntupleId]; }
+    
+private:
+    G4int   fEventWeightColumn[numberOf_Ntuples];
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,127 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef StackingAction_h
+#define StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+#include <set>
+#include <map>
+
+class G4Navigator;
+class G4EmCalculator;
+class G4ParticleDefinition;
+class StackingMessenger;
+
+///////////////     STACKING - Defaults     ///////////////////
+const G4bool        StackingAction_KillNeutrinos = true;    // they leave the world without interacting
+const G4bool        StackingAction_RangeRejection = false;  // electrons which cannot leave their volume, enabled by /K600/stack/rangeRejection
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+////    The reasons for which a secondary is killed, in the order of the rules
+enum StackingKill
+{
+    kKillParticle = 0,      // a killed particle type
+    kKillEnergyFloor,       // below the kinetic-energy floor of its particle type
+    kKillCreationVolume,    // created within a killed logical volume
+    kKillRange,             // its range is shorter than the distance to the boundary of its volume
+    numberOf_StackingKills
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Rules of the StackingAction, set from macros by the StackingMessenger
+
+struct StackingSettings
+{
+    StackingSettings();
+    
+    std::set<const G4ParticleDefinition*>           killedParticles;
+    std::map<const G4ParticleDefinition*, G4double> energyFloors;
+    std::set<G4String>                              killedVolumes;      // logical volume names
+    G4bool                                          rangeRejection;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Stacking action class
+///
+/// Secondaries which cannot contribute to any detector are killed before they
+/// are tracked, the primaries are always tracked. The rules (/K600/stack/) kill
+/// by particle type, by a kinetic-energy floor per particle type and by the
+/// logical volume of creation. Once enabled (/K600/stack/rangeRejection true),
+/// electrons created outside the sensitive volumes are killed when their range
+/// within the material of their creation is shorter than their distance to the
+/// nearest boundary (the safety, which accounts for the daughter volumes), such
+/// that they can never reach a detector. The bremsstrahlung of these electrons is thereby neglected. The
+/// positrons are never range rejected, their annihilation photons may well
+/// reach a detector.
+///
+/// The number of killed secondaries and their kinetic energy per rule are
+/// counted in a RunAccumulable and printed at the end of every run.
+
+class StackingAction : public G4UserStackingAction
+{
+public:
+    StackingAction();
+    virtual ~StackingAction();
+    
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track);
+    
+    StackingSettings& GetSettings() { return fSettings; }
+    
+    //  Called by the master at the end of a run, once the counters are merged
+    static void PrintCounters();
+    
+private:
+    G4double GetSafety(const G4ThreeVector& position);
+    
+    StackingSettings    fSettings;
+    StackingMessenger*  fMessenger;
+    
+    //  Navigator of the safety, apart from the navigator of the tracking
+    G4Navigator*        fNavigator;
+    G4EmCalculator*     fEmCalculator;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -40,17 +40,17 @@
 #include "G4UserSteppingAction.hh"
 #include "globals.hh"
 #include "G4ThreeVector.hh"
+#include "DetectorConstruction.hh"
 
-class DetectorConstruction;
 class EventAction;
+class G4LogicalVolume;
+class G4VPhysicalVolume;
 
 /// Stepping action class.
 ///
-/// In UserSteppingAction() there are collected the energy deposit and track
-/// lengths of charged particles in Absober and Gap layers and
-/// updated in EventAction.
-
-const G4double    xShift = 4*(cos(40) + tan(40)*cos(50));
+/// The detectors are scored by their sensitive detectors. In UserSteppingAction()
+/// there are collected the total energy deposition and the geometry analysis
+/// variables, which are updated in EventAction.
 
 class SteppingAction : public G4UserSteppingAction
 {
@@ -62,73 +62,25 @@ public:
     virtual void UserSteppingAction(const G4Step* step);
     
 private:
+    //  Geometry analysis, dispatched on the ScoringVolumeType of the step
+    void ScoreGeometryAnalysis(const G4Step* step, const G4VPhysicalVolume* volume, ScoringVolumeType volumeType);
+    
     const DetectorConstruction* fDetConstruction;
     EventAction*  fEventAction;
     
-    G4double    fCharge;
-    G4double    fMass;
-    G4ThreeVector worldPosition;
-    G4ThreeVector localPosition;
-    
-    
-    ////    PADDLE DETECTOR - Plastic Scintillator
-    G4double    edepPADDLE;
-    G4int       PADDLENo;
+    //  The last resolved logical volume and its type, consecutive steps mostly remain within the same volume
+    const G4LogicalVolume*  fLastLogicalVolume;
+    ScoringVolumeType       fLastVolumeType;
     
-    ////    VDC DETECTOR - Plastic Scintillator
-    G4double    edepVDC;
-    G4int       WireChamberNo;
-    G4int       hit_StoredChannelNo;
-    
-    //  Local Position
-    G4double    xPosL;
-    G4double    yPosL;
-    G4double    zPosL;
+    G4ThreeVector worldPosition;
     
     //  World Position
     G4double    xPosW;
     G4double    yPosW;
     G4double    zPosW;
     
-    G4double    xOffset;
-    
-    ////    TIARA DETECTOR
-    G4double    edepTIARA_AA;
-    G4int       TIARANo;
-    G4int       TIARA_RowNo;
-    G4int       TIARA_SectorNo;
-    
-    ////    CLOVER DETECTOR
-    G4double    edepCLOVER_HPGeCrystal;
-    G4int       CLOVERNo;
-    G4int       CLOVER_HPGeCrystalNo;
-    
-    ////    CLOVER BGO-Crystal, Compton Supression Shield
-    G4double    edepCLOVER_BGOCrystal;
-    
-    ////    LEPS DETECTOR
-    G4double    edepLEPS_HPGeCrystal;
-    G4int       LEPSNo;
-    G4int       LEPS_HPGeCrystalNo;
-
-    ////    NAIS DETECTOR
-    G4double    edepNAIS_NaICrystal;
-    G4int       NAISNo;
-
-
-    ////    PARAFFIN BOX
-    G4double    edepParaffinBox;
-
-    ////    IRON BOX
-    G4double    edepIronBox;
-    
     ////    GENERAL
-    G4double    interactiontime;
-    G4int       iTS; // Interaction Time Sample
     G4int       channelID;
-    G4String    volumeName;
-
-    
     
     //////////////////////////////////
     //      GEOMETRY ANALYSIS
@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef TIARAHit_h
+#define TIARAHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+/// TIARA hit class
+///
+/// It defines the data members to store the energy deposited within a single
+/// ring/sector channel of a TIARA detector during one time sample, together
+/// with the theta and phi (deg) of the first interaction within that channel.
+
+class TIARAHit : public G4VHit
+{
+public:
+    TIARAHit(G4int TIARANo, G4int rowNo, G4int sectorNo, G4int timeSample);
+    virtual ~TIARAHit();
+    
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+    
+    // methods to handle data
+    void Add(G4double edep) {fEdep += edep;};
+    void SetAngles(G4double theta, G4double phi) {fTheta = theta; fPhi = phi;};
+    
+    // get methods
+    G4int       GetTIARANo() const      {return fTIARANo;};
+    G4int       GetRowNo() const        {return fRowNo;};
+    G4int       GetSectorNo() const     {return fSectorNo;};
+    G4int       GetTimeSample() const   {return fTimeSample;};
+    G4double    GetEdep() const         {return fEdep;};
+    G4double    GetTheta() const        {return fTheta;};
+    G4double    GetPhi() const          {return fPhi;};
+    
+private:
+    G4int       fTIARANo;
+    G4int       fRowNo;
+    G4int       fSectorNo;
+    G4int       fTimeSample;
+    G4double    fEdep;      // MeV
+    G4double    fTheta;     // deg
+    G4double    fPhi;       // deg
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+typedef G4THitsCollection<TIARAHit> TIARAHitsCollection;
+
+extern G4ThreadLocal G4Allocator<TIARAHit>* TIARAHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* TIARAHit::operator new(size_t)
+{
+    if(!TIARAHitAllocator) TIARAHitAllocator = new G4Allocator<TIARAHit>;
+    return (void *) TIARAHitAllocator->MallocSingle();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void TIARAHit::operator delete(void *hit)
+{
+    TIARAHitAllocator->FreeSingle((TIARAHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
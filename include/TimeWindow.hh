@@ -0,0 +1,91 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef TimeWindow_h
+#define TimeWindow_h 1
+
+#include "globals.hh"
+
+class G4Track;
+
+///////////////     TIME WINDOW - Defaults     ///////////////////
+const G4bool        TimeWindow_DefaultActive = true;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Global time window of the tracking
+///
+/// The tracks whose global time exceeds the longest sampled time of the present
+/// detectors (the sampling constants of EventAction.hh) are killed by the
+/// TimeWindowProcess, since none of their hits could be recorded. The long-lived
+/// products of the radioactive decays are thereby no longer tracked. The limit
+/// is resolved by the master at the start of every run, unless it is set with
+/// /K600/timeWindow/limit, and is read by the worker threads during the run.
+///
+/// The killed tracks are counted per particle type in a RunAccumulable and
+/// printed at the end of every run.
+
+class TimeWindow
+{
+public:
+    static void SetActive(G4bool active) { fActive = active; }
+    static G4bool IsActive() { return fActive; }
+    
+    //  A fixed limit of the global time, 0 for the longest sampled time of the present detectors
+    static void SetLimit(G4double limit) { fLimit = limit; }
+    
+    //  The limit of the current run, DBL_MAX when inactive
+    static G4double GetRunLimit() { return fRunLimit; }
+    
+    //  Called by the master at the start of a run, resolves the limit
+    static void BeginOfRun();
+    
+    //  Called by the TimeWindowProcess for every killed track
+    static void CountKilledTrack(const G4Track& track);
+    
+    //  Called by the master at the end of a run, once the counters are merged
+    static void PrintCounters();
+    
+private:
+    static G4bool                       fActive;
+    static G4double                     fLimit;
+    static G4double                     fRunLimit;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#ifndef TimeWindowProcess_h
+#define TimeWindowProcess_h 1
+
+#include "G4VProcess.hh"
+#include "G4ParticleChange.hh"
+#include "globals.hh"
+
+/// Special cut of the global time, see TimeWindow
+///
+/// A track beyond the time limit of the run proposes a zero step, through which
+/// it is killed without depositing its energy.
+
+class TimeWindowProcess : public G4VProcess
+{
+public:
+    TimeWindowProcess(const G4String& name = "TimeWindow");
+    virtual ~TimeWindowProcess();
+    
+    virtual G4double PostStepGetPhysicalInteractionLength(const G4Track& track, G4double previousStepSize, G4ForceCondition* condition);
+    virtual G4VParticleChange* PostStepDoIt(const G4Track& track, const G4Step& step);
+    
+    ////    No along step and at rest actions
+    virtual G4double AlongStepGetPhysicalInteractionLength(const G4Track&, G4double, G4double, G4double&, G4GPILSelection*) { return -1.; }
+    virtual G4double AtRestGetPhysicalInteractionLength(const G4Track&, G4ForceCondition*) { return -1.; }
+    virtual G4VParticleChange* AlongStepDoIt(const G4Track&, const G4Step&) { return 0; }
+    virtual G4VParticleChange* AtRestDoIt(const G4Track&, const G4Step&) { return 0; }
+    
+private:
+    G4ParticleChange    fParticleChange;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,142 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef TransferMap_h
+#define TransferMap_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////
+//              K600 SPECTROMETER - TRANSFER MAP FAST SIMULATION
+//////////////////////////////////////////////////////////////////////////
+
+const G4bool        TransferMap_Calibrate = false;  // Full tracking, the transfer maps of the present magnets are fitted at the end of the run
+const G4bool        TransferMap_Apply = false;      // The present magnets are traversed with their fitted transfer maps
+const G4int         TransferMap_Order = 3;          // Total order of the polynomial transfer maps
+
+const G4int         TransferMap_MaxOrder = 5;
+const G4int         TransferMap_MaxNumberOfTerms = 792;     // (TransferMap_MaxOrder + numberOf_TransferMapInputs)! / (TransferMap_MaxOrder! numberOf_TransferMapInputs!)
+const G4bool        TransferMap_FastSimulation = TransferMap_Apply && !TransferMap_Calibrate;
+
+enum TransferMapMagnet
+{
+    kTransferMap_Quadrupole = 0,
+    kTransferMap_Dipole1,
+    kTransferMap_Dipole2,
+    numberOf_TransferMapMagnets
+};
+
+//  Entrance position (3), entrance direction (3) and rigidity
+const G4int         numberOf_TransferMapInputs = 7;
+//  Exit position (3), exit direction (3) and path length
+const G4int         numberOf_TransferMapOutputs = 7;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+/// Polynomial ion-optical transfer map of a magnet
+///
+/// The map relates the state of a charged particle at the entrance of a magnet
+/// envelope to its state at the exit, both in the local frame of the envelope.
+/// Each output is a polynomial of the inputs, normalised to [-1,1] over the
+/// fitted phase space, up to a given total order. The coefficients are fitted
+/// by least squares to the samples of a full tracking calibration run, inputs
+/// which are constant over the calibration sample (for example the coordinate
+/// normal to a flat entrance face) are dropped from the polynomial and any
+/// state outside the fitted phase space is left to the full tracking.
+///
+/// The maps are written as text files, together with a description of the
+/// magnet setting for which they were fitted, such that a map is not applied
+/// to another setting of the magnet.
+
+class TransferMap
+{
+public:
+    TransferMap(G4int order);
+    ~TransferMap();
+    
+    //  The inputs of a particle at the entrance, in the local frame of the envelope, rigidity = momentum/charge
+    static void GetInputs(const G4ThreeVector& localPosition, const G4ThreeVector& localDirection, G4double momentum, G4double charge, G4double* inputs);
+    
+    //  The file of the transfer map of a magnet, within the working directory
+    static G4String GetFileName(G4int magnet);
+    
+    //  Least squares fit to the samples, consecutive rows of inputs followed by outputs
+    G4bool Fit(const std::vector<G4double>& samples);
+    
+    //  Whether the inputs lie within the fitted phase space
+    G4bool IsInside(const G4double* inputs) const;
+    
+    void Evaluate(const G4double* inputs, G4double* outputs) const;
+    
+    G4bool Write(const G4String& fileName, const G4String& setting) const;
+    
+    //  Returns 0 if the file is missing, or if it was fitted for another magnet setting
+    static TransferMap* Read(const G4String& fileName, const G4String& setting);
+    
+    G4int GetOrder() const { return fOrder; }
+    G4int GetNumberOfTerms() const { return (G4int) fExponents.size()/numberOf_TransferMapInputs; }
+    G4double GetResidual(G4int output) const { return fResidual[output]; }
+    
+private:
+    void BuildTerms();
+    void SetBounds(const G4double* minimum, const G4double* maximum);
+    void EvaluateTerms(const G4double* inputs, G4double* terms) const;
+    
+    G4int                       fOrder;
+    
+    //  Exponents of the inputs, numberOf_TransferMapInputs per term
+    std::vector<G4int>          fExponents;
+    
+    //  Fitted phase space, the normalisation of a dropped input is zero
+    G4double                    fMinimum[numberOf_TransferMapInputs];
+    G4double                    fMaximum[numberOf_TransferMapInputs];
+    G4double                    fCentre[numberOf_TransferMapInputs];
+    G4double                    fNormalisation[numberOf_TransferMapInputs];
+    G4double                    fTolerance[numberOf_TransferMapInputs];
+    
+    //  Coefficients, numberOf_TransferMapOutputs per term
+    std::vector<G4double>       fCoefficients;
+    
+    //  RMS residuals of the fit
+    G4double                    fResidual[numberOf_TransferMapOutputs];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
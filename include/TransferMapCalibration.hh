@@ -0,0 +1,79 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef TransferMapCalibration_h
+#define TransferMapCalibration_h 1
+
+#include "TransferMap.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Step;
+
+/// Calibration of the K600 transfer maps
+///
+/// During a calibration run the magnets are tracked in full, and every
+/// traversal of a magnet envelope by a charged particle is recorded as a
+/// sample of its transfer map by the SteppingAction. At the end of the run the
+/// samples of the worker threads are merged, and the maps are fitted on the
+/// master and written to the working directory.
+
+class TransferMapCalibration
+{
+public:
+    //  The description of the magnet setting, stored with its transfer map
+    static void SetMagnetSetting(G4int magnet, const G4String& setting);
+    static const G4String& GetMagnetSetting(G4int magnet);
+    
+    //  A step within the envelope of the magnet, entering and/or leaving it
+    static void RecordEntrance(G4int magnet, const G4Step* step);
+    static void RecordExit(G4int magnet, const G4Step* step);
+    
+    //  Merges the samples of the calling thread, at the end of the run
+    static void Merge();
+    
+    //  Fits and writes the transfer maps of the merged samples, on the master
+    static void Fit();
+    
+private:
+    static G4String                 fMagnetSetting[numberOf_TransferMapMagnets];
+    static std::vector<G4double>    fSamples[numberOf_TransferMapMagnets];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
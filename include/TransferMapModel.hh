@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef TransferMapModel_h
+#define TransferMapModel_h 1
+
+#include "G4VFastSimulationModel.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class TransferMap;
+class G4Region;
+
+/// Fast simulation of the transport through a K600 magnet
+///
+/// The model is triggered by a charged particle entering the envelope of the
+/// magnet within the fitted phase space of its transfer map, and moves the
+/// particle directly to its exit point on the envelope surface. Any other
+/// particle within the envelope is left to the full tracking.
+
+class TransferMapModel : public G4VFastSimulationModel
+{
+public:
+    TransferMapModel(const G4String& name, G4Region* envelope, const TransferMap* transferMap);
+    virtual ~TransferMapModel();
+    
+    virtual G4bool IsApplicable(const G4ParticleDefinition& particle);
+    virtual G4bool ModelTrigger(const G4FastTrack& fastTrack);
+    virtual void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep);
+    
+private:
+    const TransferMap*  fTransferMap;
+    
+    //  The exit of the triggering track, evaluated by ModelTrigger() (the models are thread local)
+    G4ThreeVector       fExitPosition;
+    G4ThreeVector       fExitDirection;
+    G4double            fPathLength;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,151 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef VDCHit_h
+#define VDCHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+/// VDC hit classes
+///
+/// VDCHit stores the energy deposited (keV) in the drift cell of a single signal wire,
+/// together with the energy weighted z-position (keV*mm) and time (keV*ns).
+/// The wire channels are numbered X1:(0->197), U1:(198->340), X2:(341->538), U2:(539->681).
+///
+/// VDCTraverseHit stores, for the primary particle, the local positions of the last
+/// step point before (PRE) and the first step point after (POST) a wireplane.
+
+class VDCHit : public G4VHit
+{
+public:
+    VDCHit(G4int channelID);
+    virtual ~VDCHit();
+    
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+    
+    // methods to handle data
+    void Add(G4double edep, G4double EW_zpos, G4double EW_t)
+    {
+        fEdep += edep;
+        fEW_zpos += EW_zpos;
+        fEW_t += EW_t;
+    };
+    
+    // get methods
+    G4int       GetChannelID() const    {return fChannelID;};
+    G4double    GetEdep() const         {return fEdep;};
+    G4double    GetEW_zpos() const      {return fEW_zpos;};
+    G4double    GetEW_t() const         {return fEW_t;};
+    
+private:
+    G4int       fChannelID;
+    G4double    fEdep;
+    G4double    fEW_zpos;
+    G4double    fEW_t;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class VDCTraverseHit : public G4VHit
+{
+public:
+    VDCTraverseHit(G4int wireplaneNo);
+    virtual ~VDCTraverseHit();
+    
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+    
+    // set methods
+    void SetPREPosition(const G4ThreeVector& position)  {fPREPosition = position; fPRE = true;};
+    void SetPOSTPosition(const G4ThreeVector& position) {fPOSTPosition = position; fPOST = true;};
+    
+    // get methods
+    G4int           GetWireplaneNo() const      {return fWireplaneNo;};
+    G4bool          HasPRE() const              {return fPRE;};
+    G4bool          HasPOST() const             {return fPOST;};
+    G4ThreeVector   GetPREPosition() const      {return fPREPosition;};
+    G4ThreeVector   GetPOSTPosition() const     {return fPOSTPosition;};
+    
+private:
+    G4int           fWireplaneNo;
+    G4bool          fPRE;
+    G4bool          fPOST;
+    G4ThreeVector   fPREPosition;   // mm
+    G4ThreeVector   fPOSTPosition;  // mm
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+typedef G4THitsCollection<VDCHit> VDCHitsCollection;
+typedef G4THitsCollection<VDCTraverseHit> VDCTraverseHitsCollection;
+
+extern G4ThreadLocal G4Allocator<VDCHit>* VDCHitAllocator;
+extern G4ThreadLocal G4Allocator<VDCTraverseHit>* VDCTraverseHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* VDCHit::operator new(size_t)
+{
+    if(!VDCHitAllocator) VDCHitAllocator = new G4Allocator<VDCHit>;
+    return (void *) VDCHitAllocator->MallocSingle();
+}
+
+inline void VDCHit::operator delete(void *hit)
+{
+    VDCHitAllocator->FreeSingle((VDCHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* VDCTraverseHit::operator new(size_t)
+{
+    if(!VDCTraverseHitAllocator) VDCTraverseHitAllocator = new G4Allocator<VDCTraverseHit>;
+    return (void *) VDCTraverseHitAllocator->MallocSingle();
+}
+
+inline void VDCTraverseHit::operator delete(void *hit)
+{
+    VDCTraverseHitAllocator->FreeSingle((VDCTraverseHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
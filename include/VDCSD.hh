@@ -0,0 +1,97 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef VDCSD_h
+#define VDCSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "VDCHit.hh"
+
+#include <vector>
+
+class G4Step;
+class G4HCofThisEvent;
+class G4LogicalVolume;
+
+const G4double    xShift = 4*(cos(40) + tan(40)*cos(50));
+const G4int       numberOf_VDC_Channels = 682;
+
+/// VDC sensitive detector class
+///
+/// In ProcessHits(), the drift cell of a step within a VDC sense region
+/// (copy number = wireplane number, X1:0, U1:1, X2:2, U2:3) is determined from the
+/// local position in closed form and the energy deposit is accumulated within the hit of
+/// that signal wire channel, found through a channel-indexed table in constant time.
+/// The number of wire channels per event is limited to hit_buffersize.
+/// Steps within a wireplane volume, the mother of the parameterised wires placed
+/// within a sense region, are referred to that sense region.
+/// The PRE and POST wireplane traversal positions of the primary particle are stored
+/// within a second hits collection.
+
+class VDCSD : public G4VSensitiveDetector
+{
+public:
+    VDCSD(const G4String& name, const G4String& hitsCollectionName, const G4String& traverseHitsCollectionName);
+    virtual ~VDCSD();
+    
+    // methods from base class
+    virtual void   Initialize(G4HCofThisEvent* hitCollection);
+    virtual G4bool ProcessHits(G4Step* step, G4TouchableHistory* history);
+    
+    //  Registers a wireplane volume, a daughter of the VDC sense regions
+    void AddWireplaneVolume(const G4LogicalVolume* volume) {fWireplaneVolumes.push_back(volume);};
+    
+private:
+    G4bool IsWireplaneVolume(const G4LogicalVolume* volume) const;
+    
+    void FillHit(G4int channelID, G4double edep, G4double EW_zpos, G4double EW_t);
+    
+    VDCHitsCollection*          fHitsCollection;
+    VDCTraverseHitsCollection*  fTraverseHitsCollection;
+    
+    //  The traversal hit of each wireplane within the current event, 0 if not yet traversed
+    VDCTraverseHit*             fTraverseHit[4];
+    
+    //  Wire channel -> index within fHitsCollection, -1 if not yet hit within this event
+    std::vector<G4int>          fHitIndex;
+    std::vector<G4int>          fTouchedChannels;
+    
+    std::vector<const G4LogicalVolume*>   fWireplaneVolumes;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
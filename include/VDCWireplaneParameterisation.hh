@@ -0,0 +1,119 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#ifndef VDCWireplaneParameterisation_h
+#define VDCWireplaneParameterisation_h 1
+
+#include "G4VPVParameterisation.hh"
+#include "G4RotationMatrix.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4VPhysicalVolume;
+class G4Tubs;
+
+//  Dummy declarations to get rid of warnings
+class G4Box;
+class G4Trd;
+class G4Trap;
+class G4Cons;
+class G4Orb;
+class G4Sphere;
+class G4Ellipsoid;
+class G4Torus;
+class G4Para;
+class G4Hype;
+class G4Polycone;
+class G4Polyhedra;
+
+/// VDC wireplane parameterisation
+///
+/// Places every wire of a VDC wireplane, the signal wires, the guard wires and the
+/// two thick guard wires at the edges, as copies of a single G4Tubs within a
+/// wireplane volume. The wires are ordered along x with alternating guard and
+/// signal wires, copy 0 and the last copy being the thick guard wires.
+/// The wire axis, centred on the wire position within the plane, is clipped
+/// analytically to the rectangular wire window of the plane, replacing the
+/// boolean subtraction of the frame from each individual wire.
+
+class VDCWireplaneParameterisation : public G4VPVParameterisation
+{
+public:
+    VDCWireplaneParameterisation(G4int nofSignalWires,
+                                 G4double signalWirePitch,
+                                 const G4RotationMatrix& wireRotation,
+                                 G4double wireHalfLength,
+                                 G4double windowHalfX,
+                                 G4double windowHalfY);
+    virtual ~VDCWireplaneParameterisation();
+    
+    G4int GetNoOfWires() const {return G4int(fPosition.size());};
+    
+    virtual void ComputeTransformation(const G4int copyNo, G4VPhysicalVolume* physVol) const;
+    
+    virtual void ComputeDimensions(G4Tubs& wire, const G4int copyNo, const G4VPhysicalVolume* physVol) const;
+    
+private:
+    //  Dummy declarations to get rid of warnings
+    void ComputeDimensions (G4Box&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Trd&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Trap&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Cons&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Sphere&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Orb&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Ellipsoid&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Torus&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Para&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Hype&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Polycone&,const G4int,const G4VPhysicalVolume*) const {}
+    void ComputeDimensions (G4Polyhedra&,const G4int,const G4VPhysicalVolume*) const {}
+    
+    //  Restricts the axis interval [tMin, tMax] of a wire to |x0 + t*u| <= halfWidth
+    static void ClipAxis(G4double x0, G4double u, G4double halfWidth, G4double& tMin, G4double& tMax);
+    
+    //  Frame rotation of the wires, the inverse of wireRotation
+    G4RotationMatrix*           fRotation;
+    
+    std::vector<G4ThreeVector>  fPosition;
+    std::vector<G4double>       fHalfLength;
+    std::vector<G4double>       fRadius;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
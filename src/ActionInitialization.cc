@@ -39,6 +39,7 @@
 #include "RunAction.hh"
 #include "EventAction.hh"
 #include "SteppingAction.hh"
+#include "StackingAction.hh"
 #include "DetectorConstruction.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -66,10 +67,12 @@ void ActionInitialization::BuildForMaster() const
 void ActionInitialization::Build() const
 {
     SetUserAction(new PrimaryGeneratorAction);
-    SetUserAction(new RunAction);
-    EventAction* eventAction = new EventAction;
+    RunAction* runAction = new RunAction;
+    SetUserAction(runAction);
+    EventAction* eventAction = new EventAction(runAction);
     SetUserAction(eventAction);
     SetUserAction(new SteppingAction(fDetConstruction,eventAction));
+    SetUserAction(new StackingAction);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
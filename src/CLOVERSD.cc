@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "CLOVERSD.hh"
+#include "EventAction.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
+#include "G4SDManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Gamma.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CLOVERSD::CLOVERSD(const G4String& name, const G4String& hitsCollectionName)
+: G4VSensitiveDetector(name),
+fHitsCollection(0),
+fHitIndex(numberOf_CLOVER*4*CLOVER_TotalTimeSamples, -1)
+{
+    collectionName.insert(hitsCollectionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CLOVERSD::~CLOVERSD()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CLOVERSD::Initialize(G4HCofThisEvent* hce)
+{
+    // Create hits collection
+    fHitsCollection = new CrystalHitsCollection(SensitiveDetectorName, collectionName[0]);
+    
+    // Add this collection in hce
+    G4int hcID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
+    hce->AddHitsCollection(hcID, fHitsCollection);
+    
+    // Reset the crystals which were hit within the previous event
+    for(size_t i=0; i<fTouchedIndices.size(); i++) fHitIndex[fTouchedIndices[i]] = -1;
+    fTouchedIndices.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CLOVERSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+    if(step->GetTrack()->GetDefinition() != G4Gamma::Definition()) return false;
+    
+    G4StepPoint* preStepPoint = step->GetPreStepPoint();
+    
+    G4double interactiontime = preStepPoint->GetGlobalTime()/ns;
+    if(interactiontime >= CLOVER_TotalSampledTime) return false;
+    
+    G4int channelID = preStepPoint->GetTouchableHandle()->GetCopyNumber();
+    G4int iTS = interactiontime/CLOVER_SamplingTime;
+    G4int index = channelID*CLOVER_TotalTimeSamples + iTS;
+    
+    if(fHitIndex[index] < 0)
+    {
+        G4int CLOVERNo = channelID/4;
+        G4int CLOVER_HPGeCrystalNo = channelID%4;
+        G4double initialE = preStepPoint->GetKineticEnergy()/keV;
+        
+        fHitIndex[index] = fHitsCollection->insert(new CrystalHit(CLOVERNo, CLOVER_HPGeCrystalNo, iTS, initialE)) - 1;
+        fTouchedIndices.push_back(index);
+    }
+    
+    (*fHitsCollection)[fHitIndex[index]]->Add(step->GetTotalEnergyDeposit()/keV);
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
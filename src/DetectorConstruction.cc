@@ -36,6 +36,16 @@
 //
 
 #include "DetectorConstruction.hh"
+#include "TIARASD.hh"
+#include "VDCSD.hh"
+#include "PADDLESD.hh"
+#include "CLOVERSD.hh"
+#include "LEPSSD.hh"
+#include "NAISSD.hh"
+#include "BoxSD.hh"
+#include "EventAction.hh"
+#include "VDCWireplaneParameterisation.hh"
+#include "DetectorRegionMessenger.hh"
 
 #include "G4NistManager.hh"
 #include "G4Box.hh"
@@ -56,6 +66,7 @@
 #include "G4Cons.hh"
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
+#include "G4PVParameterised.hh"
 #include "G4SDManager.hh"
 #include "G4GeometryTolerance.hh"
 #include "G4GeometryManager.hh"
@@ -68,6 +79,7 @@
 #include "G4VisAttributes.hh"
 #include "G4Colour.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
 #include "globals.hh"
 
 #include "G4GlobalMagFieldMessenger.hh"
@@ -89,8 +101,16 @@
 #include "G4Mag_UsualEqRhs.hh"
 #include "G4AutoDelete.hh"
 
-#include "CADMesh.hh"
+#include "MeshRegistry.hh"
 #include "MagneticFieldMapping.hh"
+#include "TransferMapModel.hh"
+#include "TransferMapCalibration.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+
+#include <sstream>
+#include <algorithm>
 //#include "G4BlineTracer.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -109,15 +129,33 @@ G4ThreadLocal G4FieldManager* DetectorConstruction::fieldManagerMagneticField_K6
 
 DetectorConstruction::DetectorConstruction()
 : G4VUserDetectorConstruction(),
-fAbsorberPV(0), fGapPV(0), fCheckOverlaps(false), PhysiCLOVER_HPGeCrystal(0), PhysiCLOVER_Shield_BGOCrystal(0), PhysiCLOVER_Shield_PMT(0), PhysiTIARA_AA_RS(0), PhysiPADDLE(0), PhysiK600_Quadrupole(0), PhysiK600_Dipole1(0), PhysiK600_Dipole2(0), PhysiHAGAR_NaICrystal(0), PhysiHAGAR_Annulus(0), PhysiHAGAR_FrontDisc(0), Physical_LEPS_HPGeCrystal(0),PhysiNAIS_NaICrystal(0)
+fRegionMessenger(0), fAbsorberPV(0), fGapPV(0), fCheckOverlaps(false), PhysiVDC_X_WIRE(0), VDC_X_WireplaneParam(0), PhysiVDC_U_WIRE(0), VDC_U_WireplaneParam(0), PhysiCLOVER_HPGeCrystal(0), PhysiCLOVER_Shield_BGOCrystal(0), PhysiCLOVER_Shield_PMT(0), PhysiTIARA_AA_RS(0), PhysiPADDLE(0), PhysiK600_Quadrupole(0), PhysiK600_Dipole1(0), PhysiK600_Dipole2(0), PhysiHAGAR_NaICrystal(0), PhysiHAGAR_Annulus(0), PhysiHAGAR_FrontDisc(0), Physical_LEPS_HPGeCrystal(0),PhysiNAIS_NaICrystal(0), fMeshRegistry(0)
 {
     WorldSize = 15.*m;
+    
+    fMeshRegistry = new MeshRegistry();
+    fRegionMessenger = new DetectorRegionMessenger();
+    
+    for(G4int i=0; i<numberOf_TransferMapMagnets; i++)
+    {
+        fTransferMapRegion[i] = 0;
+        fTransferMap[i] = 0;
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 DetectorConstruction::~DetectorConstruction()
 {
+    delete VDC_X_WireplaneParam;
+    delete VDC_U_WireplaneParam;
+    delete fMeshRegistry;
+    delete fRegionMessenger;
+    
+    for(G4int i=0; i<numberOf_TransferMapMagnets; i++)
+    {
+        delete fTransferMap[i];
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -683,6 +721,10 @@ void DetectorConstruction::DefineMaterials()
 
 G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 {
+    fScoringVolumes.clear();
+    fInstrumentedVolumes.clear();
+    for(G4int i=0; i<numberOf_DetectorRegions; i++) fRegionVolumes[i].clear();
+    
     //////////////////////////////////////
     //          Get Elements            //
     //////////////////////////////////////
@@ -779,6 +821,135 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     char    meshType[] = "PLY";
 
     
+    //////////////////////////////////////////////////////////
+    //                  CADMesh REQUESTS                    //
+    //////////////////////////////////////////////////////////
+    
+    ////    Every mesh of the geometry is requested before any volume is built and all
+    ////    of them are loaded concurrently by a single call to the mesh registry
+    
+    G4bool BACTAR_Presence = K600_BACTAR_sidesOn_Presence || K600_BACTAR_sidesOff_Presence || K600_BACTAR_beamRightSideOff_Presence || K600_BACTAR_beamLeftSideOff_Presence;
+    
+    G4bool CLOVER_AnyPresent = false;
+    G4bool CLOVER_Shield_AnyPresent = false;
+    
+    for(G4int i=0; i<numberOf_CLOVER; i++)
+    {
+        if(CLOVER_Presence[i]) CLOVER_AnyPresent = true;
+        if(CLOVER_Shield_Presence[i]) CLOVER_Shield_AnyPresent = true;
+    }
+    
+    //////////////////////////////////////////////////////////
+    //              Scattering Chamber - CADMesh
+    
+    G4int mesh_BACTAR = -1;
+    
+    if(K600_BACTAR_sidesOn_Presence)
+    {
+        sprintf(meshPath, "../K600/Mesh-Models/STRUCTURES/BACTAR/BACTAR_sidesOn.ply");
+    }
+    if(K600_BACTAR_sidesOff_Presence)
+    {
+        sprintf(meshPath, "../K600/Mesh-Models/STRUCTURES/BACTAR/BACTAR_sidesOff.ply");
+    }
+    if(K600_BACTAR_beamRightSideOff_Presence)
+    {
+        sprintf(meshPath, "../K600/Mesh-Models/STRUCTURES/BACTAR/BACTAR_beamRightSideOff.ply");
+    }
+    if(K600_BACTAR_beamLeftSideOff_Presence)
+    {
+        sprintf(meshPath, "../K600/Mesh-Models/STRUCTURES/BACTAR/BACTAR_beamLightSideOff.ply");
+    }
+    
+    if(BACTAR_Presence)
+    {
+        G4ThreeVector offset_BACTAR = G4ThreeVector(0*cm, 0*cm, 0*cm);
+        
+        mesh_BACTAR = fMeshRegistry->Request(meshPath, meshType, mm, offset_BACTAR, false);
+    }
+    
+    //////////////////////////////////////////////////////////
+    //              CLOVER - CADMesh
+    
+    G4double CLOVERtoShield_displacement = 10;  // cm
+    
+    G4ThreeVector offset_CLOVERInternalVacuum = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
+    G4ThreeVector offset_CLOVEREncasement = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
+    G4ThreeVector offset_CLOVERHPGeCrystal1 = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
+    G4ThreeVector offset_CLOVERHPGeCrystal2 = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
+    G4ThreeVector offset_CLOVERHPGeCrystal3 = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
+    G4ThreeVector offset_CLOVERHPGeCrystal4 = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
+    
+    G4int mesh_CLOVERInternalVacuum = -1;
+    G4int mesh_CLOVEREncasement = -1;
+    G4int mesh_CLOVERHPGeCrystal1 = -1;
+    G4int mesh_CLOVERHPGeCrystal2 = -1;
+    G4int mesh_CLOVERHPGeCrystal3 = -1;
+    G4int mesh_CLOVERHPGeCrystal4 = -1;
+    
+    if(CLOVER_AnyPresent)
+    {
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/CLOVER-InternalVacuum/CloverInternalVacuum.ply");
+        mesh_CLOVERInternalVacuum = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVERInternalVacuum, false);
+        
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Clover-Encasement/CloverEncasement.ply");
+        mesh_CLOVEREncasement = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVEREncasement, false);
+        
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/HPGe-Crystals/HPGe-Crystal1.ply");
+        mesh_CLOVERHPGeCrystal1 = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVERHPGeCrystal1, false);
+        
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/HPGe-Crystals/HPGe-Crystal2.ply");
+        mesh_CLOVERHPGeCrystal2 = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVERHPGeCrystal2, false);
+        
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/HPGe-Crystals/HPGe-Crystal3.ply");
+        mesh_CLOVERHPGeCrystal3 = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVERHPGeCrystal3, false);
+        
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/HPGe-Crystals/HPGe-Crystal4.ply");
+        mesh_CLOVERHPGeCrystal4 = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVERHPGeCrystal4, false);
+    }
+    
+    //////////////////////////////////////////////////////////
+    //              CLOVER Shield - CADMesh
+    
+    G4ThreeVector offset_CLOVER_Shield_Body = G4ThreeVector(0*cm, 0*cm, 0*cm);
+    G4ThreeVector offset_CLOVER_Shield_Heavimet = G4ThreeVector(0*cm, 0*cm, 0*cm);
+    G4ThreeVector offset_CLOVER_Shield_BGOCrystals = G4ThreeVector(0*cm, 0*cm, 0*cm);
+    G4ThreeVector offset_CLOVER_Shield_PMT = G4ThreeVector(0*cm, 0*cm, 0*cm);
+    G4ThreeVector offset_CLOVER_Shield_PMTConArray = G4ThreeVector(0*cm, 0*cm, 0*cm);
+    
+    G4int mesh_CLOVER_Shield_Body = -1;
+    G4int mesh_CLOVER_Shield_Heavimet = -1;
+    G4int mesh_CLOVER_Shield_PMTConArray = -1;
+    G4int mesh_CLOVER_Shield_BGOCrystal[16];
+    G4int mesh_CLOVER_Shield_PMT[16];
+    
+    if(CLOVER_Shield_AnyPresent)
+    {
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/Body/Body.ply");
+        mesh_CLOVER_Shield_Body = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVER_Shield_Body, false);
+        
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/Heavimet-Shield/HeavimetShield.ply");
+        mesh_CLOVER_Shield_Heavimet = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVER_Shield_Heavimet, false);
+        
+        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMT-Connectors/PMT-ConnecterArray.ply");
+        mesh_CLOVER_Shield_PMTConArray = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVER_Shield_PMTConArray, false);
+        
+        for(G4int k=0; k<16; k++)
+        {
+            sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal%d.ply", k+1);
+            mesh_CLOVER_Shield_BGOCrystal[k] = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
+        }
+        
+        for(G4int k=0; k<16; k++)
+        {
+            sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT%d.ply", k+1);
+            mesh_CLOVER_Shield_PMT[k] = fMeshRegistry->Request(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
+        }
+    }
+    
+    fMeshRegistry->Load();
+
+    
     //////////////////////////////////////////////////////////
     //                      WORLD                           //
     //////////////////////////////////////////////////////////
@@ -798,6 +969,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                    false,                    //no boolean operation
                                    0);                       //copy number
     
+    RegisterScoringVolume(LogicWorld, kWorld);
+    
     
     
     //////////////////////////////////////////////////////////
@@ -936,7 +1109,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                       0,               // copy number
                       fCheckOverlaps); // checking overlaps
 
-    
+        RegisterScoringVolume(Logic_PARAFFINBOX, kParaffinBox);
     }
     
     /*
@@ -988,6 +1161,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     
     
     G4ThreeVector positionIronBox = G4ThreeVector(0.,3.0*cm,0.);
+    AmBeSource_position = positionVacuumChamber + positionIronBox;
 
     
     if(IRONBOX_Presence == true)
@@ -1001,7 +1175,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                           0,               // copy number
                           fCheckOverlaps); // checking overlaps
         
-        
+        RegisterScoringVolume(Logic_IRONBOX, kIronBox);
     }
     
     
@@ -1092,31 +1266,9 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     //              Scattering Chamber - CADMesh
     //////////////////////////////////////////////////////////
     
-    if(K600_BACTAR_sidesOn_Presence)
-    {
-        sprintf(meshPath, "../K600/Mesh-Models/STRUCTURES/BACTAR/BACTAR_sidesOn.ply");
-    }
-    if(K600_BACTAR_sidesOff_Presence)
-    {
-        sprintf(meshPath, "../K600/Mesh-Models/STRUCTURES/BACTAR/BACTAR_sidesOff.ply");
-    }
-    if(K600_BACTAR_beamRightSideOff_Presence)
-    {
-        sprintf(meshPath, "../K600/Mesh-Models/STRUCTURES/BACTAR/BACTAR_beamRightSideOff.ply");
-    }
-    if(K600_BACTAR_beamLeftSideOff_Presence)
-    {
-        sprintf(meshPath, "../K600/Mesh-Models/STRUCTURES/BACTAR/BACTAR_beamLightSideOff.ply");
-    }
-
-    
-    if(K600_BACTAR_sidesOn_Presence || K600_BACTAR_sidesOff_Presence || K600_BACTAR_beamRightSideOff_Presence || K600_BACTAR_beamLeftSideOff_Presence)
+    if(BACTAR_Presence)
     {
-        G4ThreeVector offset_BACTAR = G4ThreeVector(0*cm, 0*cm, 0*cm);
-        
-        CADMesh * mesh_BACTAR = new CADMesh(meshPath, meshType, mm, offset_BACTAR, false);
-        
-        G4VSolid * SolidBACTAR = mesh_BACTAR->TessellatedMesh();
+        G4VSolid * SolidBACTAR = fMeshRegistry->GetSolid(mesh_BACTAR);
         
         G4LogicalVolume* LogicBACTAR = new G4LogicalVolume(SolidBACTAR, G4_Al_Material, "BACTAR", 0, 0, 0);
         
@@ -1757,6 +1909,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                                          i*128 + l + j*8,  // copy number
                                                          fCheckOverlaps); // checking overlaps
                     
+                    RegisterScoringVolume(Logic_TIARA_AA_RS[j][l], kTIARA_AA_RS);
                 }
             }
             
@@ -1772,6 +1925,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                                         i,  // copy number
                                                         fCheckOverlaps); // checking overlaps
             
+            RegisterScoringVolume(Logic_TIARA_SiliconWafer[i], kTIARA_SiliconWafer);
             
             ////////////////////////////////
             //      TIARA PCB
@@ -1785,6 +1939,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                               0,               // copy number
                               fCheckOverlaps); // checking overlaps
             
+            RegisterScoringVolume(Logic_TIARA_PCB, kTIARA_PCB);
+            
             /*
              ////////////////////////////////////////////
              //      TIARA 2M Windows, Front and Back
@@ -1842,6 +1998,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                               0,               // copy number
                               fCheckOverlaps); // checking overlaps
             
+            RegisterRegionVolume(Logic_TIARA_Assembly[i], kTIARARegion);
+            
             
         }
     }
@@ -1881,7 +2039,6 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     ///////////////////////////////////////////////
     //      VDC - STESALIT STANDARD PCB FRAME
     G4Box* Solid_StesalitPCB_StdFrame = new G4Box("Solid_StesalitPCB_StdFrame", (936./2)*mm, (240./2)*mm, (5.5/2)*mm);
-    G4Box* Solid_Wire_subtraction = new G4Box("Solid_Wire_subtraction", (2000./2)*mm, (1000./2)*mm, (10./2)*mm);
     
     ///////////////////////////////////////////////
     //      VDC - PCB FRAME
@@ -1945,8 +2102,6 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     
     G4VSolid* Solid_VDC_Stesalit_XU_Frame = new G4SubtractionSolid("Solid_VDC_Stesalit_XU_Frame", Solid_StesalitPCB_StdFrame, punch3, 0, position_punch[2]);
     
-    G4VSolid* Solid_Wire_subtraction2 = new G4SubtractionSolid("Solid_VDC_Stesalit_XU_Frame", Solid_Wire_subtraction, punch3, 0, position_punch[2]);
-    
     G4LogicalVolume* Logic_VDC_XU_Frame = new G4LogicalVolume(Solid_VDC_Stesalit_XU_Frame, G4_Al_Material, "Logic_VDC_XU_Frame",0,0,0);
     
     
@@ -2000,79 +2155,27 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     
     
     ///////////////////////////////////////////////
-    //      VDC - X WIRES
-    G4Tubs* Solid_VDC_X_WIRE = new G4Tubs("Solid_VDC_X_WIRE", 0.*um, 20.*um, 100./2*mm, 0.*deg, 360.*deg);
+    //      VDC - WIREPLANES
+    ////    Each wireplane volume spans the wire window of the X-WIRE/U-WIRE frames (punch3),
+    ////    the wires within it are placed by a VDCWireplaneParameterisation (see VDC INITIALISATION)
+    G4Box* Solid_VDC_WIREPLANE = new G4Box("Solid_VDC_WIREPLANE", (800./2)*mm, (100./2)*mm, 100.*um);
     
-    G4LogicalVolume* Logic_VDC_X_WIRE = new G4LogicalVolume(Solid_VDC_X_WIRE, G4_W_Material, "Logic_VDC_X_WIRE",0,0,0);
+    G4LogicalVolume* Logic_VDC_X_WIREPLANE = new G4LogicalVolume(Solid_VDC_WIREPLANE, VDC_SR_Gas_Material, "Logic_VDC_X_WIREPLANE",0,0,0);
+    G4LogicalVolume* Logic_VDC_U_WIREPLANE = new G4LogicalVolume(Solid_VDC_WIREPLANE, VDC_SR_Gas_Material, "Logic_VDC_U_WIREPLANE",0,0,0);
     
     ///////////////////////////////////////////////
-    //      VDC - X GUARD WIRES
-    G4Tubs* Solid_VDC_X_GUARDWIRE = new G4Tubs("Solid_VDC_X_GUARDWIRE", 0.*um, 50.*um, 100./2*mm, 0.*deg, 360.*deg);
-    
-    G4LogicalVolume* Logic_VDC_X_GUARDWIRE = new G4LogicalVolume(Solid_VDC_X_GUARDWIRE, G4_W_Material, "Logic_VDC_X_GUARDWIRE",0,0,0);
-    
-    
-    ///////////////////////////////////////////////
-    //      VDC - X GUARD WIRES, THICK
-    G4Tubs* Solid_VDC_X_GUARDWIRE_THICK = new G4Tubs("Solid_VDC_X_GUARDWIRE_THICK", 0.*um, 100.*um, 100./2*mm, 0.*deg, 360.*deg);
-    
-    G4LogicalVolume* Logic_VDC_X_GUARDWIRE_Thick = new G4LogicalVolume(Solid_VDC_X_GUARDWIRE_THICK, G4_W_Material, "Logic_VDC_X_GUARDWIRE_Thick",0,0,0);
-    
-    ///////////////////////////////////////////////
-    //      VDC - U WIRES
-    G4Tubs* Solid_VDC_U_WIRE_Full = new G4Tubs("Solid_VDC_U_WIRE", 0.*um, 20.*um, 150./2*mm, 0.*deg, 360.*deg);
-    
-    G4RotationMatrix* rm_U_WIRE = new G4RotationMatrix();
-    rm_U_WIRE->rotateY(90.*deg);
-    rm_U_WIRE->rotateZ((90.-40.)*deg);
-    
-    G4VSolid* Solid_VDC_U_WIRE;
-    G4ThreeVector   offset_VDC_U_WIRE_subtraction;
-    
-    G4LogicalVolume* Logic_VDC_U_WIRE[143];
+    //      VDC - X WIRES, signal wires, guard wires and thick guard wires
+    ////    The dimensions are set for each wire by the parameterisation
+    G4Tubs* Solid_VDC_X_WIRE = new G4Tubs("Solid_VDC_X_WIRE", 0.*um, 20.*um, 100./2*mm, 0.*deg, 360.*deg);
     
-    for(G4int k=0; k<143; k++)
-    {
-        offset_VDC_U_WIRE_subtraction = G4ThreeVector( 0*mm, (-k + 71)*4*mm, (k - 71)*(4/tan(50*deg))*mm);
-        
-        Solid_VDC_U_WIRE = new G4SubtractionSolid("Solid_VDC_U_WIRE", Solid_VDC_U_WIRE_Full, Solid_Wire_subtraction2, rm_U_WIRE, offset_VDC_U_WIRE_subtraction);
-        
-        Logic_VDC_U_WIRE[k] = new G4LogicalVolume(Solid_VDC_U_WIRE, G4_W_Material, "Logic_VDC_U_WIRE",0,0,0);
-    }
+    G4LogicalVolume* Logic_VDC_X_WIRE = new G4LogicalVolume(Solid_VDC_X_WIRE, G4_W_Material, "Logic_VDC_X_WIRE",0,0,0);
     
     ///////////////////////////////////////////////
-    //      VDC - U GUARD WIRES
-    G4Tubs* Solid_VDC_U_GUARDWIRE_Full = new G4Tubs("Solid_VDC_U_GUARDWIRE", 0.*um, 50.*um, 150./2*mm, 0.*deg, 360.*deg);
+    //      VDC - U WIRES, signal wires, guard wires and thick guard wires
+    ////    The dimensions are set for each wire by the parameterisation
+    G4Tubs* Solid_VDC_U_WIRE = new G4Tubs("Solid_VDC_U_WIRE", 0.*um, 20.*um, 150./2*mm, 0.*deg, 360.*deg);
     
-    G4VSolid* Solid_VDC_U_GUARDWIRE;
-    G4LogicalVolume* Logic_VDC_U_GUARDWIRE[144];
-    
-    for(G4int k=0; k<144; k++)
-    {
-        offset_VDC_U_WIRE_subtraction = G4ThreeVector( 0*mm, (-k + 71.5)*4*mm, (k - 71.5)*(4/tan(50*deg))*mm);
-        
-        Solid_VDC_U_GUARDWIRE = new G4SubtractionSolid("Solid_VDC_U_WIRE", Solid_VDC_U_GUARDWIRE_Full, Solid_Wire_subtraction2, rm_U_WIRE, offset_VDC_U_WIRE_subtraction);
-        
-        Logic_VDC_U_GUARDWIRE[k] = new G4LogicalVolume(Solid_VDC_U_GUARDWIRE, G4_W_Material, "Logic_VDC_U_GUARDWIRE",0,0,0);
-        
-    }
-    
-    ////////////////////////////////////////////////
-    //      VDC - U GUARD WIRES, Thick
-    G4Tubs* Solid_VDC_U_GUARDWIRE_Thick_Full = new G4Tubs("Solid_VDC_U_GUARDWIRE_Thick", 0.*um, 100.*um, 150./2*mm, 0.*deg, 360.*deg);
-    
-    G4VSolid* Solid_VDC_U_GUARDWIRE_Thick;
-    
-    G4LogicalVolume*    Logic_VDC_U_GUARDWIRE_Thick[2];
-    
-    for(G4int k=0; k<2; k++)
-    {
-        offset_VDC_U_WIRE_subtraction = G4ThreeVector( 0*mm, (-k*144. + 72.)*4*mm, (k*144. - 72.)*(4/tan(50*deg))*mm);
-        
-        Solid_VDC_U_GUARDWIRE_Thick = new G4SubtractionSolid("Solid_VDC_U_WIRE_Thick", Solid_VDC_U_GUARDWIRE_Thick_Full, Solid_Wire_subtraction2, rm_U_WIRE, offset_VDC_U_WIRE_subtraction);
-        
-        Logic_VDC_U_GUARDWIRE_Thick[k] = new G4LogicalVolume(Solid_VDC_U_GUARDWIRE_Thick, G4_W_Material, "Logic_VDC_U_GUARDWIRE_Thick",0,0,0);
-    }
+    G4LogicalVolume* Logic_VDC_U_WIRE = new G4LogicalVolume(Solid_VDC_U_WIRE, G4_W_Material, "Logic_VDC_U_WIRE",0,0,0);
     
     
     ////////////////////////////////////////////////
@@ -2119,14 +2222,42 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     
     G4int usds;
     
-    G4ThreeVector   offset_VDC_X_WIRE;
     VDC_X_WIRE_rotm.rotateX(90.*deg);
     
-    G4ThreeVector   offset_VDC_U_WIRE;
     VDC_U_WIRE_rotm.rotateX(-90.*deg);
     VDC_U_WIRE_rotm.rotateY(-90.*deg);
     VDC_U_WIRE_rotm.rotateZ(40.*deg);
     
+    G4ThreeVector   offset_VDC_WIREPLANE[2];
+    offset_VDC_WIREPLANE[0] = G4ThreeVector( 0.*mm, 0.*mm, (-4000. - 20./2)*um);
+    offset_VDC_WIREPLANE[1] = G4ThreeVector( 0.*mm, 0.*mm, (4000. - 20./2)*um);
+    
+    //////////////////////////////////////////////
+    //      VDC - X WIRES
+    ////    198 signal wires and 199 guard wires at a pitch of 2 mm, between 2 thick guard wires at -398 and 398 mm
+    VDC_X_WireplaneParam = new VDCWireplaneParameterisation(198, 4.*mm, VDC_X_WIRE_rotm, 100./2*mm, 800./2*mm, 100./2*mm);
+    
+    PhysiVDC_X_WIRE = new G4PVParameterised("VDC_X_WIRE",
+                                            Logic_VDC_X_WIRE,
+                                            Logic_VDC_X_WIREPLANE,
+                                            kXAxis,
+                                            VDC_X_WireplaneParam->GetNoOfWires(),
+                                            VDC_X_WireplaneParam,
+                                            fCheckOverlaps); // checking overlaps
+    
+    //////////////////////////////////////////////
+    //      VDC - U WIRES
+    ////    143 signal wires and 144 guard wires, spaced by 4/sin(50 deg) mm along x between 2 thick guard wires
+    VDC_U_WireplaneParam = new VDCWireplaneParameterisation(143, (4/sin(50.*deg))*mm, VDC_U_WIRE_rotm, 150./2*mm, 800./2*mm, 100./2*mm);
+    
+    PhysiVDC_U_WIRE = new G4PVParameterised("VDC_U_WIRE",
+                                            Logic_VDC_U_WIRE,
+                                            Logic_VDC_U_WIREPLANE,
+                                            kUndefined,
+                                            VDC_U_WireplaneParam->GetNoOfWires(),
+                                            VDC_U_WireplaneParam,
+                                            fCheckOverlaps); // checking overlaps
+    
     
     for(G4int i=0; i<2; i++)
     {
@@ -2215,115 +2346,18 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                   i*2 + j,    // copy number
                                   fCheckOverlaps); // checking overlaps
                 
-                if(j==0)
-                {
-                    //////////////////////////////////////////////
-                    //      VDC - U WIRES
-                    for(G4int k=0; k<143; k++)
-                    {
-                        //offset_VDC_U_WIRE = G4ThreeVector( (k - 71)*4*tan(40*deg)*mm, 0.*mm, (4000. - 20./2)*um);
-                        offset_VDC_U_WIRE = G4ThreeVector( (k - 71)*(4/sin(50.*deg))*mm, 0.*mm, (-4000. - 20./2)*um);
-                        
-                        VDC_U_WIRE_transform = G4Transform3D(VDC_U_WIRE_rotm, offset_VDC_U_WIRE);
-                        
-                        PhysiVDC_U_WIRE = new G4PVPlacement(VDC_U_WIRE_transform,
-                                                            Logic_VDC_U_WIRE[k],
-                                                            "VDC_U_WIRE",
-                                                            Logic_VDC_SenseRegion_USDS[i][j],
-                                                            false,    // no boolean operations
-                                                            i*143 + k,    // copy number
-                                                            fCheckOverlaps); // checking overlaps
-                        
-                    }
-                    
-                    //////////////////////////////////////////////
-                    //      VDC - U GUARD WIRES
-                    for(G4int k=0; k<144; k++)
-                    {
-                        offset_VDC_U_WIRE = G4ThreeVector( (k - 71.5)*(4/sin(50.*deg))*mm, 0.*mm, (-4000. - 20./2)*um);
-                        VDC_U_WIRE_transform = G4Transform3D(VDC_U_WIRE_rotm, offset_VDC_U_WIRE);
-                        
-                        new G4PVPlacement(VDC_U_WIRE_transform,
-                                          Logic_VDC_U_GUARDWIRE[k],
-                                          "VDC_U_GUARDWIRE",
-                                          Logic_VDC_SenseRegion_USDS[i][j],
-                                          false,    // no boolean operations
-                                          i*144 + k,    // copy number
-                                          fCheckOverlaps); // checking overlaps
-                        
-                    }
-                    
-                    //////////////////////////////////////////////
-                    //      VDC - U GUARD WIRES, Thick
-                    for(G4int k=0; k<2; k++)
-                    {
-                        offset_VDC_U_WIRE = G4ThreeVector( (k*144. - 72.)*(4/sin(50.*deg))*mm, 0.*mm, (-4000. - 20./2)*um);
-                        VDC_U_WIRE_transform = G4Transform3D(VDC_U_WIRE_rotm, offset_VDC_U_WIRE);
-                        
-                        new G4PVPlacement(VDC_U_WIRE_transform,
-                                          Logic_VDC_U_GUARDWIRE_Thick[k],
-                                          "VDC_U_GUARDWIRE_Thick",
-                                          Logic_VDC_SenseRegion_USDS[i][j],
-                                          false,    // no boolean operations
-                                          i*2 + k,    // copy number
-                                          fCheckOverlaps);
-                        
-                    }
-                }
+                //////////////////////////////////////////////
+                //      VDC - U WIREPLANE (j==0) and X WIREPLANE (j==1)
+                new G4PVPlacement(0,    // no rotation
+                                  offset_VDC_WIREPLANE[j],
+                                  (j==0) ? Logic_VDC_U_WIREPLANE : Logic_VDC_X_WIREPLANE,
+                                  (j==0) ? "VDC_U_WIREPLANE" : "VDC_X_WIREPLANE",
+                                  Logic_VDC_SenseRegion_USDS[i][j],
+                                  false,    // no boolean operations
+                                  i*2 + j,    // copy number
+                                  fCheckOverlaps); // checking overlaps
                 
-                if(j==1)
-                {
-                    //////////////////////////////////////////////
-                    //      VDC - X WIRES
-                    for(G4int k=0; k<198; k++)
-                    {
-                        offset_VDC_X_WIRE = G4ThreeVector( ( (k*4.) - 394.)*mm, 0.*mm, (4000. - 20./2)*um);
-                        VDC_X_WIRE_transform = G4Transform3D(VDC_X_WIRE_rotm, offset_VDC_X_WIRE);
-                        
-                        PhysiVDC_X_WIRE = new G4PVPlacement(VDC_X_WIRE_transform,
-                                                            Logic_VDC_X_WIRE,
-                                                            "VDC_X_WIRE",
-                                                            Logic_VDC_SenseRegion_USDS[i][j],
-                                                            false,    // no boolean operations
-                                                            i*198 + k,    // copy number
-                                                            fCheckOverlaps); // checking overlaps
-                        
-                    }
-                    
-                    //////////////////////////////////////////////
-                    //      VDC - X GUARD WIRES
-                    for(G4int k=0; k<199; k++)
-                    {
-                        offset_VDC_X_WIRE = G4ThreeVector( ( (k*4.) - 396.)*mm, 0.*mm, (4000. - 20./2)*um);
-                        VDC_X_WIRE_transform = G4Transform3D(VDC_X_WIRE_rotm, offset_VDC_X_WIRE);
-                        
-                        new G4PVPlacement(VDC_X_WIRE_transform,
-                                          Logic_VDC_X_GUARDWIRE,
-                                          "VDC_X_GUARDWIRE",
-                                          Logic_VDC_SenseRegion_USDS[i][j],
-                                          false,    // no boolean operations
-                                          i*199 + k,    // copy number
-                                          fCheckOverlaps); // checking overlaps
-                        
-                    }
-                    
-                    //////////////////////////////////////////////
-                    //      VDC - X GUARD WIRES, Thick
-                    for(G4int k=0; k<2; k++)
-                    {
-                        offset_VDC_X_WIRE = G4ThreeVector( ( (k*2.*398.) - 398.)*mm, 0.*mm, (4000. - 20./2)*um);
-                        VDC_X_WIRE_transform = G4Transform3D(VDC_X_WIRE_rotm, offset_VDC_X_WIRE);
-                        
-                        new G4PVPlacement(VDC_X_WIRE_transform,
-                                          Logic_VDC_X_GUARDWIRE_Thick,
-                                          "VDC_X_GUARDWIRE_Thick",
-                                          Logic_VDC_SenseRegion_USDS[i][j],
-                                          false,    // no boolean operations
-                                          i*2 + k,    // copy number
-                                          fCheckOverlaps);
-                        
-                    }
-                }
+                RegisterScoringVolume((j==0) ? Logic_VDC_U_WIREPLANE : Logic_VDC_X_WIREPLANE, kVDC_Wireplane);
             }
         }
     }
@@ -2350,6 +2384,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                                                   i*2 + j,               // copy number
                                                                   fCheckOverlaps); // checking overlaps
                 
+                RegisterScoringVolume(Logic_VDC_SenseRegion_USDS[i][j], kVDC_SenseRegion);
+                
                 ////////////////////////////////////////
                 //      VDC - ALUMINIUM FRAME
                 VDC_Al_Frame_transform = G4Transform3D(VDC_Al_Frame_rotm[j], offset_VDC_Al_Frame[j]);
@@ -2387,6 +2423,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                                       i,               // copy number
                                                       fCheckOverlaps); // checking overlaps
             
+            RegisterRegionVolume(Logic_VDC_ASSEMBLY[i], kVDCRegion);
+            
         }
     }
     
@@ -2430,6 +2468,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                             i,                  // copy number
                                             fCheckOverlaps);    // checking overlaps
             
+            RegisterScoringVolume(Logic_PADDLE[i], kPADDLE);
         }
     }
     
@@ -2519,67 +2558,27 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     //             CLOVER DEFINITION           //
     /////////////////////////////////////////////
     
-    G4double CLOVERtoShield_displacement = 10;  // cm
-    
-    G4ThreeVector offset_CLOVERInternalVacuum = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
-    G4ThreeVector offset_CLOVEREncasement = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
-    G4ThreeVector offset_CLOVERHPGeCrystal1 = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
-    G4ThreeVector offset_CLOVERHPGeCrystal2 = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
-    G4ThreeVector offset_CLOVERHPGeCrystal3 = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
-    G4ThreeVector offset_CLOVERHPGeCrystal4 = G4ThreeVector(0*cm, 0*cm, -CLOVERtoShield_displacement*cm);
-    
     G4LogicalVolume * Logic_CLOVER_InternalVacuum[numberOf_CLOVER];
     G4LogicalVolume * Logic_CLOVER_Encasement;
     G4LogicalVolume * Logic_CLOVER_HPGeCrystal[4];
     
-    if( CLOVER_Presence[0] || CLOVER_Presence[1] || CLOVER_Presence[2] || CLOVER_Presence[3] || CLOVER_Presence[4] || CLOVER_Presence[5] || CLOVER_Presence[6] || CLOVER_Presence[7] )
+    if(CLOVER_AnyPresent)
     {
-        //////////////////////////////////////////////////////////
-        //              CLOVER Internal Vacuum - CADMesh
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/CLOVER-InternalVacuum/CloverInternalVacuum.ply");
-
-        CADMesh * mesh_CLOVERInternalVacuum = new CADMesh(meshPath, meshType, mm, offset_CLOVERInternalVacuum, false);
-        
-        G4VSolid * Solid_CLOVERInternalVacuum = mesh_CLOVERInternalVacuum->TessellatedMesh();
+        G4VSolid * Solid_CLOVERInternalVacuum = fMeshRegistry->GetSolid(mesh_CLOVERInternalVacuum);
         
         for(G4int i=0; i<numberOf_CLOVER; i++)
         {
             Logic_CLOVER_InternalVacuum[i] = new G4LogicalVolume(Solid_CLOVERInternalVacuum, G4_Galactic_Material, "LogicCLOVERInternalVacuum", 0, 0, 0);
         }
         
-        
-        ///////////////////////////////////////////////////////
-        //              CLOVER Encasement - CADMesh
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Clover-Encasement/CloverEncasement.ply");
-
-        CADMesh * mesh_CLOVEREncasement = new CADMesh(meshPath, meshType, mm, offset_CLOVEREncasement, false);
-        
-        G4VSolid * Solid_CLOVEREncasement = mesh_CLOVEREncasement->TessellatedMesh();
+        G4VSolid * Solid_CLOVEREncasement = fMeshRegistry->GetSolid(mesh_CLOVEREncasement);
         
         Logic_CLOVER_Encasement = new G4LogicalVolume(Solid_CLOVEREncasement, G4_Al_Material, "LogicCLOVERCloverEncasement", 0, 0, 0);
         
-        
-        //////////////////////////////////////////////////////////
-        //              CLOVER HPGeCrystals - CADMesh
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/HPGe-Crystals/HPGe-Crystal1.ply");
-        CADMesh * mesh_CLOVERHPGeCrystal1 = new CADMesh(meshPath, meshType, mm, offset_CLOVERHPGeCrystal1, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/HPGe-Crystals/HPGe-Crystal2.ply");
-        CADMesh * mesh_CLOVERHPGeCrystal2 = new CADMesh(meshPath, meshType, mm, offset_CLOVERHPGeCrystal2, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/HPGe-Crystals/HPGe-Crystal3.ply");
-        CADMesh * mesh_CLOVERHPGeCrystal3 = new CADMesh(meshPath, meshType, mm, offset_CLOVERHPGeCrystal3, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/HPGe-Crystals/HPGe-Crystal4.ply");
-        CADMesh * mesh_CLOVERHPGeCrystal4 = new CADMesh(meshPath, meshType, mm, offset_CLOVERHPGeCrystal4, false);
-        
-        G4VSolid * Solid_HPGeCrystal1 = mesh_CLOVERHPGeCrystal1->TessellatedMesh();
-        G4VSolid * Solid_HPGeCrystal2 = mesh_CLOVERHPGeCrystal2->TessellatedMesh();
-        G4VSolid * Solid_HPGeCrystal3 = mesh_CLOVERHPGeCrystal3->TessellatedMesh();
-        G4VSolid * Solid_HPGeCrystal4 = mesh_CLOVERHPGeCrystal4->TessellatedMesh();
+        G4VSolid * Solid_HPGeCrystal1 = fMeshRegistry->GetSolid(mesh_CLOVERHPGeCrystal1);
+        G4VSolid * Solid_HPGeCrystal2 = fMeshRegistry->GetSolid(mesh_CLOVERHPGeCrystal2);
+        G4VSolid * Solid_HPGeCrystal3 = fMeshRegistry->GetSolid(mesh_CLOVERHPGeCrystal3);
+        G4VSolid * Solid_HPGeCrystal4 = fMeshRegistry->GetSolid(mesh_CLOVERHPGeCrystal4);
         
         Logic_CLOVER_HPGeCrystal[0] = new G4LogicalVolume(Solid_HPGeCrystal1, G4_Ge_Material,"LogicCLOVERHPGeCrystal",0,0,0);
         Logic_CLOVER_HPGeCrystal[1] = new G4LogicalVolume(Solid_HPGeCrystal2, G4_Ge_Material,"LogicCLOVERHPGeCrystal",0,0,0);
@@ -2593,207 +2592,28 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     //              CLOVER SHIELD
     ////////////////////////////////////////////
     
-    G4ThreeVector offset_CLOVER_Shield_Body = G4ThreeVector(0*cm, 0*cm, 0*cm);
-    G4ThreeVector offset_CLOVER_Shield_Heavimet = G4ThreeVector(0*cm, 0*cm, 0*cm);
-    G4ThreeVector offset_CLOVER_Shield_BGOCrystals = G4ThreeVector(0*cm, 0*cm, 0*cm);
-    G4ThreeVector offset_CLOVER_Shield_PMT = G4ThreeVector(0*cm, 0*cm, 0*cm);
-    G4ThreeVector offset_CLOVER_Shield_PMTConArray = G4ThreeVector(0*cm, 0*cm, 0*cm);
-    
     G4LogicalVolume* Logic_CLOVER_Shield_Body;
     G4LogicalVolume* Logic_CLOVER_Shield_Heavimet;
     G4LogicalVolume* Logic_CLOVER_Shield_PMTConArray;
     G4LogicalVolume* Logic_CLOVER_Shield_BGOCrystal[16];
     G4LogicalVolume* Logic_CLOVER_Shield_PMT[16];
     
-    if( CLOVER_Shield_Presence[0] || CLOVER_Shield_Presence[1] || CLOVER_Shield_Presence[2] || CLOVER_Shield_Presence[3] || CLOVER_Shield_Presence[4] || CLOVER_Shield_Presence[5] || CLOVER_Shield_Presence[6] || CLOVER_Shield_Presence[7] || CLOVER_Shield_Presence[8])
+    if(CLOVER_Shield_AnyPresent)
     {
-        ///////////////////////////////////////////////////////
-        //              CLOVER Shield Body - CADMesh
-        ///////////////////////////////////////////////////////
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/Body/Body.ply");
-        CADMesh * mesh_CLOVER_Shield_Body = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_Body, false);
-        
-        G4VSolid * Solid_CLOVER_Shield_Body = mesh_CLOVER_Shield_Body->TessellatedMesh();
-        
-        Logic_CLOVER_Shield_Body = new G4LogicalVolume(Solid_CLOVER_Shield_Body, G4_Al_Material, "LogicCLOVERShieldBody", 0, 0, 0);
-        
-        ///////////////////////////////////////////////////////
-        //              CLOVER Shield Heavimet - CADMesh
-        ///////////////////////////////////////////////////////
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/Heavimet-Shield/HeavimetShield.ply");
-        CADMesh * mesh_CLOVER_Shield_Heavimet = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_Heavimet, false);
-        
-        G4VSolid * Solid_CLOVER_Shield_Heavimet = mesh_CLOVER_Shield_Heavimet->TessellatedMesh();
-        
-        Logic_CLOVER_Shield_Heavimet = new G4LogicalVolume(Solid_CLOVER_Shield_Heavimet, Heavimet_Material, "LogicCLOVERShieldHeavimet", 0, 0, 0);
-        
-        ///////////////////////////////////////////////////////
-        //      CLOVER Shield PMT Connecter Array - CADMesh
-        ///////////////////////////////////////////////////////
-        
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMT-Connectors/PMT-ConnecterArray.ply");
-        CADMesh * mesh_CLOVER_Shield_PMTConArray = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMTConArray, false);
-        
-        G4VSolid * Solid_CLOVER_Shield_PMTConArray = mesh_CLOVER_Shield_PMTConArray->TessellatedMesh();
-        
-        Logic_CLOVER_Shield_PMTConArray = new G4LogicalVolume(Solid_CLOVER_Shield_PMTConArray, G4_Al_Material, "LogicCLOVERShieldHeavimet", 0, 0, 0);
+        Logic_CLOVER_Shield_Body = new G4LogicalVolume(fMeshRegistry->GetSolid(mesh_CLOVER_Shield_Body), G4_Al_Material, "LogicCLOVERShieldBody", 0, 0, 0);
         
+        Logic_CLOVER_Shield_Heavimet = new G4LogicalVolume(fMeshRegistry->GetSolid(mesh_CLOVER_Shield_Heavimet), Heavimet_Material, "LogicCLOVERShieldHeavimet", 0, 0, 0);
         
-        ///////////////////////////////////////////////////////
-        //      CLOVER Shield BGO Crystals - CADMesh
-        ///////////////////////////////////////////////////////
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal1.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal1 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal2.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal2 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal3.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal3 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal4.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal4 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal5.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal5 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal6.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal6 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal7.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal7 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal8.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal8 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal9.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal9 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal10.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal10 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal11.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal11 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal12.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal12 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal13.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal13 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal14.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal14 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal15.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal15 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/BGO-Crystals/BGO-Crystal16.ply");
-        CADMesh * mesh_CLOVER_Shield_BGOCrystal16 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_BGOCrystals, false);
-        
-        G4VSolid * Solid_CLOVER_Shield_BGOCrystal[16];
-        
-        Solid_CLOVER_Shield_BGOCrystal[0] = mesh_CLOVER_Shield_BGOCrystal1->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[1] = mesh_CLOVER_Shield_BGOCrystal2->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[2] = mesh_CLOVER_Shield_BGOCrystal3->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[3] = mesh_CLOVER_Shield_BGOCrystal4->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[4] = mesh_CLOVER_Shield_BGOCrystal5->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[5] = mesh_CLOVER_Shield_BGOCrystal6->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[6] = mesh_CLOVER_Shield_BGOCrystal7->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[7] = mesh_CLOVER_Shield_BGOCrystal8->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[8] = mesh_CLOVER_Shield_BGOCrystal9->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[9] = mesh_CLOVER_Shield_BGOCrystal10->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[10] = mesh_CLOVER_Shield_BGOCrystal11->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[11] = mesh_CLOVER_Shield_BGOCrystal12->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[12] = mesh_CLOVER_Shield_BGOCrystal13->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[13] = mesh_CLOVER_Shield_BGOCrystal14->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[14] = mesh_CLOVER_Shield_BGOCrystal15->TessellatedMesh();
-        Solid_CLOVER_Shield_BGOCrystal[15] = mesh_CLOVER_Shield_BGOCrystal16->TessellatedMesh();
-        
+        Logic_CLOVER_Shield_PMTConArray = new G4LogicalVolume(fMeshRegistry->GetSolid(mesh_CLOVER_Shield_PMTConArray), G4_Al_Material, "LogicCLOVERShieldHeavimet", 0, 0, 0);
         
         for (G4int k=0; k<16; k++)
         {
-            Logic_CLOVER_Shield_BGOCrystal[k] = new G4LogicalVolume(Solid_CLOVER_Shield_BGOCrystal[k], G4_BGO_Material,"LogicCLOVERShieldBGOCrystal",0,0,0);
+            Logic_CLOVER_Shield_BGOCrystal[k] = new G4LogicalVolume(fMeshRegistry->GetSolid(mesh_CLOVER_Shield_BGOCrystal[k]), G4_BGO_Material,"LogicCLOVERShieldBGOCrystal",0,0,0);
         }
         
-        ////////////////////////////////////
-        //      CLOVER Shield PMT's
-        ////////////////////////////////////
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT1.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT1 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT2.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT2 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT3.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT3 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT4.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT4 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT5.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT5 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT6.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT6 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT7.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT7 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT8.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT8 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT9.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT9 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT10.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT10 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT11.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT11 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT12.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT12 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT13.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT13 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT14.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT14 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT15.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT15 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        sprintf(meshPath, "../K600/Mesh-Models/DETECTORS/CLOVER/Shield/PMTs/PMT16.ply");
-        CADMesh * mesh_CLOVER_Shield_PMT16 = new CADMesh(meshPath, meshType, mm, offset_CLOVER_Shield_PMT, false);
-        
-        
-        G4VSolid * Solid_CLOVER_Shield_PMT[16];
-        
-        Solid_CLOVER_Shield_PMT[0] = mesh_CLOVER_Shield_PMT1->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[1] = mesh_CLOVER_Shield_PMT2->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[2] = mesh_CLOVER_Shield_PMT3->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[3] = mesh_CLOVER_Shield_PMT4->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[4] = mesh_CLOVER_Shield_PMT5->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[5] = mesh_CLOVER_Shield_PMT6->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[6] = mesh_CLOVER_Shield_PMT7->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[7] = mesh_CLOVER_Shield_PMT8->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[8] = mesh_CLOVER_Shield_PMT9->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[9] = mesh_CLOVER_Shield_PMT10->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[10] = mesh_CLOVER_Shield_PMT11->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[11] = mesh_CLOVER_Shield_PMT12->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[12] = mesh_CLOVER_Shield_PMT13->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[13] = mesh_CLOVER_Shield_PMT14->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[14] = mesh_CLOVER_Shield_PMT15->TessellatedMesh();
-        Solid_CLOVER_Shield_PMT[15] = mesh_CLOVER_Shield_PMT16->TessellatedMesh();
-        
         for (G4int k=0; k<16; k++)
         {
-            Logic_CLOVER_Shield_PMT[k] = new G4LogicalVolume(Solid_CLOVER_Shield_PMT[k], G4_Al_Material,"LogicCLOVERShieldPMT",0,0,0);
+            Logic_CLOVER_Shield_PMT[k] = new G4LogicalVolume(fMeshRegistry->GetSolid(mesh_CLOVER_Shield_PMT[k]), G4_Al_Material,"LogicCLOVERShieldPMT",0,0,0);
         }
     }
     
@@ -2840,6 +2660,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                                             i*4 + j,               // copy number
                                                             fCheckOverlaps); // checking overlaps
                 
+                RegisterScoringVolume(Logic_CLOVER_HPGeCrystal[j], kCLOVER_HPGeCrystal);
+                RegisterRegionVolume(Logic_CLOVER_HPGeCrystal[j], kCrystalRegion);
             }
             
             
@@ -2851,6 +2673,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                               i,               // copy number
                               fCheckOverlaps); // checking overlaps
             
+            RegisterInstrumentedVolume(CLOVER_position[i], CLOVER_BoundingRadius*mm);
         }
         
         /////////////////////////////
@@ -2901,6 +2724,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                               i,               // copy number
                               fCheckOverlaps); // checking overlaps
             
+            RegisterRegionVolume(Logic_CLOVER_Shield_Heavimet, kShieldRegion);
+            for(G4int j=0; j<16; j++) RegisterRegionVolume(Logic_CLOVER_Shield_BGOCrystal[j], kShieldRegion);
         }
     }
     
@@ -3007,6 +2832,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                                               j + (i*4),               // copy number
                                                               fCheckOverlaps); // checking overlaps
                 
+                RegisterScoringVolume(Logic_LEPS_HPGeCrystal, kLEPS_HPGeCrystal);
+                RegisterRegionVolume(Logic_LEPS_HPGeCrystal, kCrystalRegion);
             }
             
             new G4PVPlacement(LEPS_InternalVacuum_transform[i],
@@ -3017,7 +2844,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                               i,               // copy number
                               fCheckOverlaps); // checking overlaps
             
-            
+            RegisterInstrumentedVolume(LEPS_position[i], LEPS_BoundingRadius*mm);
         }
         
     }
@@ -3066,6 +2893,9 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                                      i,               // copy number
                                                      fCheckOverlaps); // checking overlaps
             
+            RegisterScoringVolume(Logic_NAIS_NaICrystal, kNAIS_NaICrystal);
+            RegisterRegionVolume(Logic_NAIS_NaICrystal, kCrystalRegion);
+            RegisterInstrumentedVolume(NAIS_position[i], NAIS_BoundingRadius*mm);
         }
         
     }
@@ -3125,7 +2955,11 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
             
             G4double z_Q_Offset = 4.4*mm+ 100*cm;
             
-            G4MagneticField* PurgMagField = new MagneticFieldMapping("../K600/MagneticFieldMaps/Quadrupole_MagneticFieldMap.TABLE", z_Q_Offset);
+            ////    The binary field map is mapped when it has been produced by the FieldMapConverter, otherwise the .TABLE field map is parsed
+            const char* fieldMapFile = "../K600/MagneticFieldMaps/Quadrupole_MagneticFieldMap.FMAP";
+            if(!std::ifstream(fieldMapFile).good()) fieldMapFile = "../K600/MagneticFieldMaps/Quadrupole_MagneticFieldMap.TABLE";
+            
+            G4MagneticField* PurgMagField = new MagneticFieldMapping(fieldMapFile, z_Q_Offset);
             fEquationMagneticField_K600_Q = new G4Mag_UsualEqRhs(PurgMagField);
             
             fieldManagerMagneticField_K600_Q = new G4FieldManager(PurgMagField);
@@ -3150,6 +2984,14 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                                  0,               // copy number
                                                  fCheckOverlaps); // checking overlaps
         
+        ////    The transfer map is only valid for the field setting of its calibration run
+        std::ostringstream K600_Q_setting;
+        K600_Q_setting.precision(17);
+        if(Ideal_Quadrupole) K600_Q_setting << "ideal quadrupole, gradient " << K600_Q_gradient/(tesla/m) << " T/m";
+        if(Mapped_Quadrupole) K600_Q_setting << "mapped quadrupole, Quadrupole_MagneticFieldMap";
+        
+        SetupTransferMap(kTransferMap_Quadrupole, Logic_K600_Quadrupole, kK600_Quadrupole, K600_Q_setting.str());
+        
     }
     
     //////////////////////////////////////////////////////
@@ -3202,6 +3044,12 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                               0,               // copy number
                                               fCheckOverlaps); // checking overlaps
         
+        std::ostringstream K600_D1_setting;
+        K600_D1_setting.precision(17);
+        K600_D1_setting << "uniform dipole, field " << K600_Dipole1_BZ/tesla << " T";
+        
+        SetupTransferMap(kTransferMap_Dipole1, Logic_K600_Dipole1, kK600_Dipole1, K600_D1_setting.str());
+        
     }
     
     
@@ -3244,6 +3092,12 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
                                               0,               // copy number
                                               fCheckOverlaps); // checking overlaps
         
+        std::ostringstream K600_D2_setting;
+        K600_D2_setting.precision(17);
+        K600_D2_setting << "uniform dipole, field " << K600_Dipole2_BZ/tesla << " T";
+        
+        SetupTransferMap(kTransferMap_Dipole2, Logic_K600_Dipole2, kK600_Dipole2, K600_D2_setting.str());
+        
         
     }
     
@@ -3326,43 +3180,19 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     G4VisAttributes* VDC_X_WIRE_VisAtt = new G4VisAttributes(G4Colour(0., 0.7, 0.7));
     VDC_X_WIRE_VisAtt->SetForceSolid(true);
     
-    //  VDC - X GUARD WIRES
-    G4VisAttributes* VDC_X_GUARDWIRE_VisAtt = new G4VisAttributes(G4Colour(1.0, 1.0, 1.0));
-    VDC_X_GUARDWIRE_VisAtt->SetVisibility(false);
-    VDC_X_GUARDWIRE_VisAtt->SetForceSolid(true);
-    
     //  VDC - U WIRES
     G4VisAttributes* VDC_U_WIRE_VisAtt = new G4VisAttributes(G4Colour(1.0, 1.0, 0.));
     VDC_U_WIRE_VisAtt->SetForceSolid(true);
     
-    //  VDC - U GUARD WIRES
-    G4VisAttributes* VDC_U_GUARDWIRE_VisAtt = new G4VisAttributes(G4Colour(1.0, 1.0, 1.0));
-    VDC_U_GUARDWIRE_VisAtt->SetVisibility(false);
-    VDC_U_GUARDWIRE_VisAtt->SetForceSolid(true);
-    
     Logic_VDC_GasFrame->SetVisAttributes(VDC_GasFrame_VisAtt);
     Logic_VDC_XU_Frame->SetVisAttributes(VDC_XU_Frame_VisAtt);
     Logic_VDC_XU_PCBFrame->SetVisAttributes(VDC_XU_PCBFrame_VisAtt);
     Logic_VDC_Al_Frame->SetVisAttributes(VDC_Al_Frame_VisAtt);
     Logic_VDC_MYLAR_Plane->SetVisAttributes(VDC_MYLAR_Plane_VisAtt);
     Logic_VDC_X_WIRE->SetVisAttributes(VDC_X_WIRE_VisAtt);
-    Logic_VDC_X_GUARDWIRE->SetVisAttributes(VDC_X_GUARDWIRE_VisAtt);
-    Logic_VDC_X_GUARDWIRE_Thick->SetVisAttributes(VDC_X_GUARDWIRE_VisAtt);
-    
-    for(G4int k=0; k<143; k++)
-    {
-        Logic_VDC_U_WIRE[k]->SetVisAttributes(VDC_U_WIRE_VisAtt);
-    }
-    
-    for(G4int k=0; k<144; k++)
-    {
-        Logic_VDC_U_GUARDWIRE[k]->SetVisAttributes(VDC_U_GUARDWIRE_VisAtt);
-    }
-    
-    for(G4int k=0; k<2; k++)
-    {
-        Logic_VDC_U_GUARDWIRE_Thick[k]->SetVisAttributes(VDC_U_GUARDWIRE_VisAtt);
-    }
+    Logic_VDC_U_WIRE->SetVisAttributes(VDC_U_WIRE_VisAtt);
+    Logic_VDC_X_WIREPLANE->SetVisAttributes(G4VisAttributes::Invisible);
+    Logic_VDC_U_WIREPLANE->SetVisAttributes(G4VisAttributes::Invisible);
     
     for(G4int k=0; k<3; k++)
     {
@@ -3478,6 +3308,9 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     //
     //always return the physical World
     //
+    ////    Production cuts and step limits per detector region
+    SetupRegions();
+    
     return PhysiWorld;
     
     
@@ -3501,3 +3334,207 @@ void DetectorConstruction::ConstructField()
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::ConstructSDandField()
+{
+    ////    One sensitive detector per detector family, attached only to the registered scoring volumes of the detectors which are present.
+    ////    Each detector may be switched off at run time with /hits/inactivate <SD name>
+    G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+    
+    G4VSensitiveDetector* TIARA_SD = 0;
+    VDCSD* VDC_SD = 0;
+    G4VSensitiveDetector* PADDLE_SD = 0;
+    G4VSensitiveDetector* CLOVER_SD = 0;
+    G4VSensitiveDetector* ParaffinBox_SD = 0;
+    G4VSensitiveDetector* IronBox_SD = 0;
+    G4VSensitiveDetector* LEPS_SD = 0;
+    G4VSensitiveDetector* NAIS_SD = 0;
+    
+    std::map<G4LogicalVolume*, ScoringVolumeType>::const_iterator it;
+    
+    for(it = fScoringVolumes.begin(); it != fScoringVolumes.end(); it++)
+    {
+        G4VSensitiveDetector* aSD = 0;
+        
+        switch(it->second)
+        {
+            case kTIARA_AA_RS:
+                if(!TIARA_SD) TIARA_SD = new TIARASD("TIARA", "TIARAHitsCollection");
+                aSD = TIARA_SD;
+                break;
+                
+            case kVDC_SenseRegion:
+                if(!VDC_SD) VDC_SD = new VDCSD("VDC", "VDCHitsCollection", "VDCTraverseHitsCollection");
+                aSD = VDC_SD;
+                break;
+                
+            case kVDC_Wireplane:
+                if(!VDC_SD) VDC_SD = new VDCSD("VDC", "VDCHitsCollection", "VDCTraverseHitsCollection");
+                VDC_SD->AddWireplaneVolume(it->first);
+                aSD = VDC_SD;
+                break;
+                
+            case kPADDLE:
+                if(!PADDLE_SD) PADDLE_SD = new PADDLESD("PADDLE", "PADDLEHitsCollection");
+                aSD = PADDLE_SD;
+                break;
+                
+            case kCLOVER_HPGeCrystal:
+                if(!CLOVER_SD) CLOVER_SD = new CLOVERSD("CLOVER", "CLOVERHitsCollection");
+                aSD = CLOVER_SD;
+                break;
+                
+            case kParaffinBox:
+                if(!ParaffinBox_SD) ParaffinBox_SD = new BoxSD("ParaffinBox", "ParaffinBoxHitsCollection");
+                aSD = ParaffinBox_SD;
+                break;
+                
+            case kIronBox:
+                if(!IronBox_SD) IronBox_SD = new BoxSD("IronBox", "IronBoxHitsCollection");
+                aSD = IronBox_SD;
+                break;
+                
+            case kLEPS_HPGeCrystal:
+                if(!LEPS_SD) LEPS_SD = new LEPSSD("LEPS", "LEPSHitsCollection");
+                aSD = LEPS_SD;
+                break;
+                
+            case kNAIS_NaICrystal:
+                if(!NAIS_SD) NAIS_SD = new NAISSD("NAIS", "NAISHitsCollection");
+                aSD = NAIS_SD;
+                break;
+                
+            default:
+                break;
+        }
+        
+        if(aSD)
+        {
+            if(!sdManager->FindSensitiveDetector(aSD->GetFullPathName(), false)) sdManager->AddNewDetector(aSD);
+            SetSensitiveDetector(it->first, aSD);
+        }
+    }
+    
+    ////    Transfer map fast simulation, the models are thread local while the envelope regions and transfer maps are shared
+    for(G4int i=0; i<numberOf_TransferMapMagnets; i++)
+    {
+        if(!fTransferMapRegion[i]) continue;
+        
+        TransferMapModel* transferMapModel = new TransferMapModel(fTransferMapRegion[i]->GetName() + "_Model", fTransferMapRegion[i], fTransferMap[i]);
+        G4AutoDelete::Register(transferMapModel);
+    }
+    
+    ////    Global magnetic field messenger
+    ConstructField();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetupTransferMap(TransferMapMagnet magnet, G4LogicalVolume* logicalVolume, ScoringVolumeType type, const G4String& setting)
+{
+    ////    The calibration run samples the full tracking through the magnet
+    if(TransferMap_Calibrate)
+    {
+        TransferMapCalibration::SetMagnetSetting(magnet, setting);
+        RegisterScoringVolume(logicalVolume, type);
+    }
+    
+    ////    Without a valid transfer map, the magnet is tracked in full
+    if(TransferMap_FastSimulation)
+    {
+        G4String fileName = TransferMap::GetFileName(magnet);
+        fTransferMap[magnet] = TransferMap::Read(fileName, setting);
+        
+        if(fTransferMap[magnet])
+        {
+            G4cout << "---> The " << logicalVolume->GetName() << " is transported with the order " << fTransferMap[magnet]->GetOrder() << " transfer map " << fileName << G4endl;
+            
+            fTransferMapRegion[magnet] = new G4Region(logicalVolume->GetName() + "_TransferMap");
+            fTransferMapRegion[magnet]->AddRootLogicalVolume(logicalVolume);
+        }
+        else
+        {
+            G4cout << "---> No transfer map " << fileName << " is available, the " << logicalVolume->GetName() << " is tracked in full" << G4endl;
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double DetectorConstruction::GetLongestSampledTime() const
+{
+    ////    The sampled times of EventAction.hh, the ParaffinBox and IronBox scorers are not digitised in time
+    G4double longestSampledTime = 0.;
+    
+    std::map<G4LogicalVolume*, ScoringVolumeType>::const_iterator it;
+    for(it = fScoringVolumes.begin(); it != fScoringVolumes.end(); it++)
+    {
+        G4double sampledTime = 0.;
+        
+        switch(it->second)
+        {
+            case kTIARA_AA_RS:
+                sampledTime = TIARA_TotalSampledTime;
+                break;
+                
+            case kVDC_SenseRegion:
+            case kVDC_Wireplane:
+                sampledTime = VDC_TotalSampledTime;
+                break;
+                
+            case kPADDLE:
+                sampledTime = PADDLE_TotalSampledTime;
+                break;
+                
+            case kCLOVER_HPGeCrystal:
+                sampledTime = std::max(CLOVER_TotalSampledTime, CLOVER_Shield_BGO_TotalSampledTime);
+                break;
+                
+            case kLEPS_HPGeCrystal:
+                sampledTime = LEPS_TotalSampledTime;
+                break;
+                
+            case kNAIS_NaICrystal:
+                sampledTime = NAIS_TotalSampledTime;
+                break;
+                
+            default:
+                break;
+        }
+        
+        longestSampledTime = std::max(longestSampledTime, sampledTime);
+    }
+    
+    return longestSampledTime;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetupRegions()
+{
+    G4RegionStore* regionStore = G4RegionStore::GetInstance();
+    
+    for(G4int i=0; i<numberOf_DetectorRegions; i++)
+    {
+        if(fRegionVolumes[i].empty()) continue;
+        
+        ////    A region keeps the cuts and limits set from macros should the geometry be rebuilt
+        G4Region* region = regionStore->GetRegion(DetectorRegion_Name[i], false);
+        if(!region)
+        {
+            region = new G4Region(DetectorRegion_Name[i]);
+            
+            G4ProductionCuts* productionCuts = new G4ProductionCuts();
+            productionCuts->SetProductionCut(DetectorRegion_ProductionCut[i]*mm);
+            region->SetProductionCuts(productionCuts);
+            
+            if(DetectorRegion_MaxStep[i] > 0.) region->SetUserLimits(new G4UserLimits(DetectorRegion_MaxStep[i]*mm));
+        }
+        
+        for(size_t j=0; j<fRegionVolumes[i].size(); j++) region->AddRootLogicalVolume(fRegionVolumes[i][j]);
+        
+        G4cout << "---> The " << DetectorRegion_Name[i] << " region holds " << fRegionVolumes[i].size() << " root volumes, production cut " << G4BestUnit(region->GetProductionCuts()->GetProductionCut(0), "Length") << G4endl;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,141 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "DetectorRegionMessenger.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4UserLimits.hh"
+
+#include <sstream>
+#include <cfloat>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorRegionMessenger::DetectorRegionMessenger()
+: G4UImessenger()
+{
+    fRegionDirectory = new G4UIdirectory("/K600/region/");
+    fRegionDirectory->SetGuidance("Production cuts and maximum steps of the detector regions (VDC, TIARA, Crystals, Shields) and of the World region");
+    
+    fProductionCutCmd = CreateRegionCommand("/K600/region/productionCut", "Production cut (range) of all particles within the region");
+    fMaxStepCmd = CreateRegionCommand("/K600/region/maxStep", "Maximum step of the charged particles within the region, 0 for none");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorRegionMessenger::~DetectorRegionMessenger()
+{
+    delete fProductionCutCmd;
+    delete fMaxStepCmd;
+    delete fRegionDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcommand* DetectorRegionMessenger::CreateRegionCommand(const char* name, const char* guidance)
+{
+    G4String regionNames = "World";
+    for(G4int i=0; i<numberOf_DetectorRegions; i++) regionNames += G4String(" ") + DetectorRegion_Name[i];
+    
+    G4UIcommand* command = new G4UIcommand(name, this);
+    command->SetGuidance(guidance);
+    G4UIparameter* region = new G4UIparameter("region", 's', false);
+    region->SetParameterCandidates(regionNames);
+    command->SetParameter(region);
+    G4UIparameter* value = new G4UIparameter("value", 'd', false);
+    value->SetParameterRange("value >= 0.");
+    command->SetParameter(value);
+    G4UIparameter* unit = new G4UIparameter("unit", 's', true);
+    unit->SetDefaultValue("mm");
+    unit->SetParameterCandidates("um mm cm m");
+    command->SetParameter(unit);
+    command->SetToBeBroadcasted(false);
+    command->AvailableForStates(G4State_Idle);
+    return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4Region* DetectorRegionMessenger::GetRegion(const G4String& name) const
+{
+    return G4RegionStore::GetInstance()->GetRegion(name == "World" ? G4String("DefaultRegionForTheWorld") : name, false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorRegionMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    G4String regionName, unit;
+    G4double value;
+    std::istringstream values(newValue);
+    values >> regionName >> value >> unit;
+    value *= G4UIcommand::ValueOf(unit);
+    
+    G4Region* region = GetRegion(regionName);
+    if(!region)
+    {
+        G4cerr << "The region " << regionName << " is not present within the geometry, the command is ignored" << G4endl;
+        return;
+    }
+    
+    if(command == fProductionCutCmd)
+    {
+        G4ProductionCuts* productionCuts = region->GetProductionCuts();
+        if(!productionCuts)
+        {
+            productionCuts = new G4ProductionCuts();
+            region->SetProductionCuts(productionCuts);
+        }
+        productionCuts->SetProductionCut(value);
+    }
+    else if(command == fMaxStepCmd)
+    {
+        ////    Applied by the G4StepLimiter to the volumes of the region without their own user limits
+        if(value <= 0.) value = DBL_MAX;
+        G4UserLimits* userLimits = region->GetUserLimits();
+        if(userLimits) userLimits->SetMaxAllowedStep(value);
+        else region->SetUserLimits(new G4UserLimits(value));
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,239 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "EfficiencyCurve.hh"
+#include "DetectorConstruction.hh"
+#include "RunAccumulable.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    const char* const   arrayName[numberOf_EfficiencyArrays] = {"CLOVER", "LEPS", "NAIS"};
+    const G4int         arraySize[numberOf_EfficiencyArrays] = {numberOf_CLOVER, numberOf_LEPS, numberOf_NAIS};
+    const G4int         arrayOffset[numberOf_EfficiencyArrays] = {0, numberOf_CLOVER, numberOf_CLOVER + numberOf_LEPS};
+    const G4int         numberOfDetectors = numberOf_CLOVER + numberOf_LEPS + numberOf_NAIS;
+    
+    const char* const   countName[numberOf_EfficiencyCounts] = {"Total", "FullEnergy", "SingleEscape", "DoubleEscape"};
+    
+    struct EfficiencyCounts
+    {
+        ////    The merged counts take the size of the first counts merged, that of the energies of the run
+        void Merge(const EfficiencyCounts& other)
+        {
+            if(other.sum.empty()) return;
+            
+            if(sum.empty())
+            {
+                nofEvents.assign(other.nofEvents.size(), 0.);
+                sum.assign(other.sum.size(), 0.);
+                sum2.assign(other.sum2.size(), 0.);
+            }
+            if(other.sum.size() != sum.size()) return;
+            
+            for(size_t i=0; i<nofEvents.size(); i++) nofEvents[i] += other.nofEvents[i];
+            for(size_t i=0; i<sum.size(); i++)
+            {
+                sum[i] += other.sum[i];
+                sum2[i] += other.sum2[i];
+            }
+        }
+        
+        std::vector<std::pair<G4int, G4double> >    eventEnergies;  // the measured energies of the current event per detector
+        std::vector<G4int>                          eventFlags;     // one bit per count of a detector
+        std::vector<G4double>                       nofEvents;
+        std::vector<G4double>                       sum;
+        std::vector<G4double>                       sum2;
+    };
+    
+    RunAccumulable<EfficiencyCounts> efficiencyCounts;
+    
+    size_t CountIndex(G4int energyIndex, G4int detector, G4int count)
+    {
+        return (energyIndex*numberOfDetectors + detector)*numberOf_EfficiencyCounts + count;
+    }
+    
+    ////    The efficiency, the mean weight per event, and its statistical error
+    void Efficiency(G4double sum, G4double sum2, G4double n, G4double& efficiency, G4double& error)
+    {
+        efficiency = n > 0. ? sum/n : 0.;
+        error = n > 0. ? std::sqrt(std::max(0., sum2/n - efficiency*efficiency)/n) : 0.;
+    }
+}
+
+std::vector<G4double>   EfficiencyCurve::fEnergies;
+G4double                EfficiencyCurve::fPeakWindow = EfficiencyCurve_DefaultPeakWindow*keV;
+G4String                EfficiencyCurve::fFileName = EfficiencyCurve_DefaultFileName;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EfficiencyCurve::BeginOfRun()
+{
+    if(!IsActive()) return;
+    
+    G4cout << "\n---> Efficiency curve of " << fEnergies.size() << " gamma-ray energies, interleaved over the events:";
+    for(size_t i=0; i<fEnergies.size(); i++) G4cout << " " << fEnergies[i]/keV;
+    G4cout << " keV, fired by the particle gun, which must be in its gun mode (/K600/gun/mode gun)" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EfficiencyCurve::ScoreEnergy(EfficiencyArray array, G4int detector, G4double energy)
+{
+    if(detector < 0 || detector >= arraySize[array] || energy <= 0.) return;
+    
+    efficiencyCounts.GetLocal().eventEnergies.push_back(std::make_pair(arrayOffset[array] + detector, energy*keV));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EfficiencyCurve::EndOfEvent(G4int eventID, G4double weight)
+{
+    EfficiencyCounts& counts = efficiencyCounts.GetLocal();
+    
+    ////    The counts of the thread follow the energies of the run
+    const size_t nofCounts = fEnergies.size()*numberOfDetectors*numberOf_EfficiencyCounts;
+    if(counts.sum.size() != nofCounts)
+    {
+        counts.nofEvents.assign(fEnergies.size(), 0.);
+        counts.sum.assign(nofCounts, 0.);
+        counts.sum2.assign(nofCounts, 0.);
+    }
+    
+    const G4int energyIndex = GetEnergyIndex(eventID);
+    const G4double energy = fEnergies[energyIndex];
+    
+    counts.nofEvents[energyIndex] += 1.;
+    
+    ////    Every detector counts at most once per count, whichever its number of time samples
+    std::vector<G4int>& flags = counts.eventFlags;
+    flags.assign(numberOfDetectors, 0);
+    
+    for(size_t n=0; n<counts.eventEnergies.size(); n++)
+    {
+        G4int detector = counts.eventEnergies[n].first;
+        G4double measured = counts.eventEnergies[n].second;
+        
+        flags[detector] |= 1 << kEfficiency_Total;
+        if(std::fabs(measured - energy) <= fPeakWindow) flags[detector] |= 1 << kEfficiency_FullEnergy;
+        
+        ////    The escape peaks above the pair production threshold
+        if(energy > 2*electron_mass_c2)
+        {
+            if(std::fabs(measured - (energy - electron_mass_c2)) <= fPeakWindow) flags[detector] |= 1 << kEfficiency_SingleEscape;
+            if(std::fabs(measured - (energy - 2*electron_mass_c2)) <= fPeakWindow) flags[detector] |= 1 << kEfficiency_DoubleEscape;
+        }
+    }
+    counts.eventEnergies.clear();
+    
+    for(G4int detector=0; detector<numberOfDetectors; detector++)
+    {
+        if(!flags[detector]) continue;
+        
+        for(G4int count=0; count<numberOf_EfficiencyCounts; count++)
+        {
+            if(!(flags[detector] & (1 << count))) continue;
+            
+            size_t index = CountIndex(energyIndex, detector, count);
+            counts.sum[index] += weight;
+            counts.sum2[index] += weight*weight;
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EfficiencyCurve::WriteTables()
+{
+    const EfficiencyCounts& counts = efficiencyCounts.GetMerged();
+    
+    if(!IsActive() || counts.sum.size() != fEnergies.size()*numberOfDetectors*numberOf_EfficiencyCounts) return;
+    
+    std::ofstream file(fFileName.c_str());
+    if(!file)
+    {
+        G4cerr << "EfficiencyCurve: cannot write " << fFileName << G4endl;
+        return;
+    }
+    
+    ////    A table per detector with any count, one line per energy
+    G4int nofTables = 0;
+    
+    for(G4int array=0; array<numberOf_EfficiencyArrays; array++)
+    {
+        for(G4int i=0; i<arraySize[array]; i++)
+        {
+            const G4int detector = arrayOffset[array] + i;
+            
+            G4bool counted = false;
+            for(size_t e=0; e<fEnergies.size(); e++) counted = counted || counts.sum[CountIndex(e, detector, kEfficiency_Total)] > 0.;
+            if(!counted) continue;
+            
+            file << "# " << arrayName[array] << " " << i << "\n";
+            file << "# Energy(keV) Events";
+            for(G4int count=0; count<numberOf_EfficiencyCounts; count++) file << " " << countName[count] << " Error";
+            file << "\n";
+            
+            for(size_t e=0; e<fEnergies.size(); e++)
+            {
+                file << std::setw(12) << fEnergies[e]/keV << " " << std::setw(10) << counts.nofEvents[e];
+                
+                for(G4int count=0; count<numberOf_EfficiencyCounts; count++)
+                {
+                    size_t index = CountIndex(e, detector, count);
+                    G4double efficiency, error;
+                    Efficiency(counts.sum[index], counts.sum2[index], counts.nofEvents[e], efficiency, error);
+                    file << " " << std::setw(12) << efficiency << " " << std::setw(12) << error;
+                }
+                file << "\n";
+            }
+            file << "\n";
+            
+            nofTables++;
+        }
+    }
+    
+    G4cout << "\n---> Efficiency curves of " << nofTables << " detectors written to " << fFileName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
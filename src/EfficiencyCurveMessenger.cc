@@ -0,0 +1,135 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "EfficiencyCurveMessenger.hh"
+#include "EfficiencyCurve.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EfficiencyCurveMessenger::EfficiencyCurveMessenger()
+: G4UImessenger()
+{
+    fEfficiencyDirectory = new G4UIdirectory("/K600/efficiency/");
+    fEfficiencyDirectory->SetGuidance("Efficiency curves of the CLOVER, LEPS and NAIS detectors, with the gun mode of the generator");
+    
+    fEnergiesCmd = new G4UIcmdWithAString("/K600/efficiency/energies", this);
+    fEnergiesCmd->SetGuidance("The gamma-ray energies fired in turn by the particle gun, followed by their unit (keV by default)");
+    fEnergiesCmd->SetGuidance("e.g. /K600/efficiency/energies 121.78 244.70 344.28 778.90 1408.01 keV, none for the normal operation of the gun");
+    fEnergiesCmd->SetParameterName("energies", false);
+    fEnergiesCmd->SetToBeBroadcasted(false);
+    fEnergiesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fAddEnergyCmd = new G4UIcmdWithADoubleAndUnit("/K600/efficiency/addEnergy", this);
+    fAddEnergyCmd->SetGuidance("Adds a gamma-ray energy to the list");
+    fAddEnergyCmd->SetParameterName("energy", false);
+    fAddEnergyCmd->SetRange("energy > 0.");
+    fAddEnergyCmd->SetUnitCategory("Energy");
+    fAddEnergyCmd->SetDefaultUnit("keV");
+    fAddEnergyCmd->SetToBeBroadcasted(false);
+    fAddEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fPeakWindowCmd = new G4UIcmdWithADoubleAndUnit("/K600/efficiency/peakWindow", this);
+    fPeakWindowCmd->SetGuidance("Half width of the full-energy and escape peaks");
+    fPeakWindowCmd->SetParameterName("window", false);
+    fPeakWindowCmd->SetRange("window > 0.");
+    fPeakWindowCmd->SetUnitCategory("Energy");
+    fPeakWindowCmd->SetDefaultUnit("keV");
+    fPeakWindowCmd->SetToBeBroadcasted(false);
+    fPeakWindowCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fFileNameCmd = new G4UIcmdWithAString("/K600/efficiency/fileName", this);
+    fFileNameCmd->SetGuidance("The file of the efficiency tables, written at the end of every run");
+    fFileNameCmd->SetParameterName("fileName", false);
+    fFileNameCmd->SetToBeBroadcasted(false);
+    fFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EfficiencyCurveMessenger::~EfficiencyCurveMessenger()
+{
+    delete fEnergiesCmd;
+    delete fAddEnergyCmd;
+    delete fPeakWindowCmd;
+    delete fFileNameCmd;
+    delete fEfficiencyDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EfficiencyCurveMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if(command == fEnergiesCmd)
+    {
+        EfficiencyCurve::ClearEnergies();
+        if(newValue == "none") return;
+        
+        ////    The numbers of the list, the last word being their unit if it is not a number
+        std::istringstream words(newValue);
+        std::vector<G4double> energies;
+        G4double unit = keV;
+        G4String word;
+        while(words >> word)
+        {
+            std::istringstream number(word);
+            G4double energy;
+            if(number >> energy) energies.push_back(energy);
+            else unit = G4UIcommand::ValueOf(word);
+        }
+        
+        if(unit <= 0.)
+        {
+            G4cerr << "EfficiencyCurve: unknown unit of the energies " << newValue << G4endl;
+            return;
+        }
+        
+        for(size_t i=0; i<energies.size(); i++) EfficiencyCurve::AddEnergy(energies[i]*unit);
+    }
+    else if(command == fAddEnergyCmd) EfficiencyCurve::AddEnergy(fAddEnergyCmd->GetNewDoubleValue(newValue));
+    else if(command == fPeakWindowCmd) EfficiencyCurve::SetPeakWindow(fPeakWindowCmd->GetNewDoubleValue(newValue));
+    else if(command == fFileNameCmd) EfficiencyCurve::SetFileName(newValue);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
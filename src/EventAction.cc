@@ -36,14 +36,28 @@
 
 #include "EventAction.hh"
 #include "RunAction.hh"
+#include "ProgressMonitor.hh"
+#include "ImportanceBiasing.hh"
+#include "EfficiencyCurve.hh"
+#include "ResponseMatrix.hh"
+#include "PrimaryVertexWeight.hh"
 #include "Analysis.hh"
 
+#include "TIARAHit.hh"
+#include "VDCHit.hh"
+#include "PADDLEHit.hh"
+#include "CrystalHit.hh"
+
 #include "G4RunManager.hh"
 #include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SDManager.hh"
 #include "G4UnitsTable.hh"
 
 #include "Randomize.hh"
 #include <iomanip>
+#include <algorithm>
 
 #include <fstream>
 #include <string>
@@ -52,8 +66,10 @@ using namespace std;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-EventAction::EventAction()
+EventAction::EventAction(RunAction* runAction)
 : G4UserEventAction(),
+fRunAction(runAction),
+fEventWeight(1.),
 fEnergyAbs(0.),
 fEnergyGap(0.),
 fTrackLAbs(0.),
@@ -68,8 +84,21 @@ OffsetPADDLE(0),
 GainLEPS(1.0),
 OffsetLEPS(0.0),
 GainNAIS(1.0),
-OffsetNAIS(0.0)
-{}
+OffsetNAIS(0.0),
+fHCIDsInitialised(false),
+fTIARA_HCID(-1),
+fVDC_HCID(-1),
+fVDCTraverse_HCID(-1),
+fPADDLE_HCID(-1),
+fCLOVER_HCID(-1),
+fParaffinBox_HCID(-1),
+fIronBox_HCID(-1),
+fLEPS_HCID(-1),
+fNAIS_HCID(-1),
+VDC_nofSlots(0)
+{
+    ClearAllChannels();
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -88,6 +117,10 @@ void EventAction::BeginOfEventAction(const G4Event* evt)
     
     evtNb = evt->GetEventID();
     
+    ////    The primaries are generated before the event is processed, a biased generator sets the weights of its vertices
+    fEventWeight = 1.;
+    for(G4int i=0; i<evt->GetNumberOfPrimaryVertex(); i++) fEventWeight *= PrimaryVertexWeight::GetWeight(evt->GetPrimaryVertex(i));
+    
     GA_LineOfSight = true;
     
     if(GA_MODE)
@@ -126,108 +159,12 @@ void EventAction::BeginOfEventAction(const G4Event* evt)
     
     
     /////////////////////////////////////////////////////
+    ////    Only the channels which were filled within the previous event are reset
+    ClearTouchedChannels();
     
-    for(G4int i=0; i<9; i++)
-    {
-        CLOVER_iEDep[i] = 0.0;
-        
-        for (G4int k=0; k<CLOVER_TotalTimeSamples; k++)
-        {
-            CLOVER_EDep[i][k] = 0;
-            
-            for(G4int j=0; j<4; j++)
-            {
-                CLOVER_HPGeCrystal_EDep[i][j][k] = 0;
-                CLOVER_BGO_EDep[i][j][k] = 0;
-                CLOVER_HPGeCrystal_EDepVETO[i][j][k] = false;
-            }
-        }
-        
-        for (G4int m=0; m<CLOVER_Shield_BGO_TotalTimeSamples; m++)
-        {
-            for(G4int l=0; l<16; l++)
-            {
-                CLOVER_BGO_EDep[i][l][m] = 0;
-            }
-        }
-    }
-    
-
-        
-
-    PARAFFINBOX_EDep = 0.0;
-    PARAFFINBOX_iEDep = 0.0;
-    
-    IRONBOX_EDep = 0.0;
-    IRONBOX_iEDep = 0.0;
-    
-    
-    
-    
-    for(G4int i=0; i<8; i++)
-    {
-        for(G4int k=0; k<LEPS_TotalTimeSamples; k++)
-        {
-            LEPS_EDep[i][k] = 0.;
-
-            for(G4int j=0; j<4; j++)
-            {
-                LEPS_HPGeCrystal_EDep[i][j][k] = 0;
-            }
-        }
-    }
-
-    for(G4int i=0; i<5; i++)
-    {
-        for(G4int k=0; k<NAIS_TotalTimeSamples; k++)
-        {
-            NAIS_EDep[i][k] = 0.;
-            
-        }
-    }
-    
-    
-    for(G4int i=0; i<5; i++)
-    {
-        for(G4int k = 0; k<TIARA_TotalTimeSamples; k++)
-        {
-            for(G4int j=0; j<16; j++)
-            {
-                for(G4int l=0; l<8; l++)
-                {
-                    for(G4int m=0; m<8; m++)
-                    {
-                        TIARA_AA[i][j][l][m][k] = 0;
-                    }
-                }
-            }
-        }
-    }
-    
-    for(G4int i=0; i<3; i++)
-    {
-        for (G4int k=0; k<PADDLE_TotalTimeSamples; k++)
-        {
-            PADDLE_Trig[i] = 0;
-            
-            PADDLE_EDep[i][k] = 0;
-            PADDLE_TOF[i][k] = 0;
-            
-            PADDLE_EWpositionX[i][k] = 0;
-            PADDLE_EWpositionY[i][k] = 0;
-            
-            PADDLE_positionX[i][k] = 0;
-            PADDLE_positionY[i][k] = 0;
-        }
-    }
-    
-    for(G4int j=0; j<4; j++)
+    for(G4int i=0; i<4; i++)
     {
-        for (G4int k=0; k<hit_buffersize; k++)
-        {
-            if(j==0) VDC_Observables[j][k] = -1;
-            else{VDC_Observables[j][k] = 0;}
-        }
+        WireplaneTraversePOST[i] = false;
     }
     
     ////    Input Variables
@@ -240,14 +177,29 @@ void EventAction::BeginOfEventAction(const G4Event* evt)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void EventAction::AddWeightedNtupleRow(G4int ntupleId)
+{
+    G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+    
+    analysisManager->FillNtupleDColumn(ntupleId, fRunAction->GetEventWeightColumn(ntupleId), fEventWeight);
+    analysisManager->AddNtupleRow(ntupleId);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void EventAction::EndOfEventAction(const G4Event* event)
 {
+    ProgressMonitor::EventDone();
+    
     // Accumulate statistics
     //
     
     // get analysis manager
     G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
     
+    // accumulate the hits of the sensitive detectors
+    ReadHitsCollections(event);
+    
     
     ////////////////////////////////////////////////////////
     //
@@ -255,53 +207,49 @@ void EventAction::EndOfEventAction(const G4Event* event)
     //
     ////////////////////////////////////////////////////////
     
-    for(G4int i=0; i<5; i++)
+    std::sort(TIARA_Touched.begin(), TIARA_Touched.end());
+    
+    for(size_t n=0; n<TIARA_Touched.size(); n++)
     {
-        for(G4int k = 0; k<TIARA_TotalTimeSamples; k++)
+        G4int i, j, l, k;
+        DecodeTIARAKey(TIARA_Touched[n], i, j, l, k);
+        
+        ////    Processing the Energies of the TIARA Detectors
+        //TIARA_AA[i][j][l][0][k] = G4RandGauss::shoot(TIARA_AA[i][j][l][0][k], (0.010/2.3548));
+        //if(TIARA_AA[i][j][l][0][k] >= G4RandGauss::shoot(TIARA_AA_ThresholdEnergy, 0.1))
+        
+        if(TIARA_AA[i][j][l][0][k] >= TIARA_AA_ThresholdEnergy)
         {
-            for(G4int j=0; j<16; j++)
-            {
-                for(G4int l=0; l<8; l++)
-                {
-                    ////    Processing the Energies of the TIARA Detectors
-                    //TIARA_AA[i][j][l][0][k] = G4RandGauss::shoot(TIARA_AA[i][j][l][0][k], (0.010/2.3548));
-                    //if(TIARA_AA[i][j][l][0][k] >= G4RandGauss::shoot(TIARA_AA_ThresholdEnergy, 0.1))
-                    
-                    if(TIARA_AA[i][j][l][0][k] >= TIARA_AA_ThresholdEnergy)
-                    {
-                        TIARA_AA[i][j][l][0][k] = G4RandGauss::shoot(TIARA_AA[i][j][l][0][k], 0.036);
-                        
-                        ////      Counts versus Energy for each TIARA
-                        //analysisManager->FillH1(1+i, GainTIARA*TIARA_AA[i][j][l][0][k] + OffsetTIARA);
-                        
-                        ////      Counts versus Energy for the Entire TIARA Array
-                        //analysisManager->FillH1(6, GainTIARA*TIARA_AA[i][j][l][0][k] +  OffsetTIARA);
-                        
-                        ////////////////////////////////////////////////////////////
-                        ////                Filling DataTreeSim
-                        //analysisManager->FillNtupleIColumn(0, 0, i);
-                        //analysisManager->FillNtupleIColumn(0, 1, j);
-                        //analysisManager->FillNtupleIColumn(0, 2, k);
-                        
-                        
-                        //      TIARANo
-                        analysisManager->FillNtupleIColumn(0, 0, i);
-                        //      TIARA_RowNo
-                        analysisManager->FillNtupleIColumn(0, 1, j);
-                        //      TIARA_SectorNo
-                        analysisManager->FillNtupleIColumn(0, 2, l);
-                        //      Energy
-                        analysisManager->FillNtupleDColumn(0, 3, TIARA_AA[i][j][l][0][k]);
-                        //      Theta
-                        analysisManager->FillNtupleDColumn(0, 4, TIARA_AA[i][j][l][1][k]);
-                        //      Phi
-                        analysisManager->FillNtupleDColumn(0, 5, TIARA_AA[i][j][l][2][k]);
-                        
-                        analysisManager->AddNtupleRow(0);
-                        
-                    }
-                }
-            }
+            TIARA_AA[i][j][l][0][k] = G4RandGauss::shoot(TIARA_AA[i][j][l][0][k], 0.036);
+            
+            ////      Counts versus Energy for each TIARA
+            //analysisManager->FillH1(1+i, GainTIARA*TIARA_AA[i][j][l][0][k] + OffsetTIARA, fEventWeight);
+            
+            ////      Counts versus Energy for the Entire TIARA Array
+            //analysisManager->FillH1(6, GainTIARA*TIARA_AA[i][j][l][0][k] +  OffsetTIARA, fEventWeight);
+            
+            ////////////////////////////////////////////////////////////
+            ////                Filling DataTreeSim
+            //analysisManager->FillNtupleIColumn(0, 0, i);
+            //analysisManager->FillNtupleIColumn(0, 1, j);
+            //analysisManager->FillNtupleIColumn(0, 2, k);
+            
+            
+            //      TIARANo
+            analysisManager->FillNtupleIColumn(0, 0, i);
+            //      TIARA_RowNo
+            analysisManager->FillNtupleIColumn(0, 1, j);
+            //      TIARA_SectorNo
+            analysisManager->FillNtupleIColumn(0, 2, l);
+            //      Energy
+            analysisManager->FillNtupleDColumn(0, 3, TIARA_AA[i][j][l][0][k]);
+            //      Theta
+            analysisManager->FillNtupleDColumn(0, 4, TIARA_AA[i][j][l][1][k]);
+            //      Phi
+            analysisManager->FillNtupleDColumn(0, 5, TIARA_AA[i][j][l][2][k]);
+            
+            AddWeightedNtupleRow(0);
+            
         }
     }
     
@@ -316,40 +264,42 @@ void EventAction::EndOfEventAction(const G4Event* event)
     OffsetPADDLE = 0.0;
     
     
-    for(G4int i=0; i<3; i++)
+    std::sort(PADDLE_Touched.begin(), PADDLE_Touched.end());
+    
+    for(size_t n=0; n<PADDLE_Touched.size(); n++)
     {
-        for (G4int k=0; k<PADDLE_TotalTimeSamples; k++)
+        G4int i = PADDLE_Touched[n]/PADDLE_TotalTimeSamples;
+        G4int k = PADDLE_Touched[n]%PADDLE_TotalTimeSamples;
+        
+        ////              Calculating energy weighted positions
+        PADDLE_positionX[i][k] = G4RandGauss::shoot(PADDLE_EWpositionX[i][k]/PADDLE_EDep[i][k], 4.8);
+        PADDLE_positionY[i][k] = PADDLE_EWpositionY[i][k]/PADDLE_EDep[i][k];
+        
+        ////              Calculating a Gaussian Smeared Energy Deposition
+        PADDLE_EDep[i][k] = G4RandGauss::shoot(PADDLE_EDep[i][k], 0.10*PADDLE_EDep[i][k]);
+        
+        if( PADDLE_EDep[i][k] >= G4RandGauss::shoot(PADDLE_ThresholdEnergy, 0.01*PADDLE_ThresholdEnergy))
         {
-            ////              Calculating energy weighted positions
-            PADDLE_positionX[i][k] = G4RandGauss::shoot(PADDLE_EWpositionX[i][k]/PADDLE_EDep[i][k], 4.8);
-            PADDLE_positionY[i][k] = PADDLE_EWpositionY[i][k]/PADDLE_EDep[i][k];
+            ////////////////////////////////////////////////////////
+            //      PADDLE DETECTORS - 1D, Counts versus Energy
+            ////////////////////////////////////////////////////////
             
-            ////              Calculating a Gaussian Smeared Energy Deposition
-            PADDLE_EDep[i][k] = G4RandGauss::shoot(PADDLE_EDep[i][k], 0.10*PADDLE_EDep[i][k]);
+            //analysisManager->FillH1(i+7, GainPADDLE*PADDLE_EDep[i][k] + OffsetPADDLE, fEventWeight);
+            
+            PADDLE_TOF[i][k] = G4RandGauss::shoot(PADDLE_TOF[i][k], 0.05*PADDLE_TOF[i][k]);
+            
+            
+            ////////////////////////////////////////////////////////////////////
+            //              PADDLE DETECTORS - 2D, Position versus Energy
+            ////////////////////////////////////////////////////////////////////
+            //analysisManager->FillH2(i+1, PADDLE_positionX[i][k], PADDLE_positionY[i][k], PADDLE_EDep[i][k]*fEventWeight);
+            
+            ////////////////////////////////////////////////////////////////////
+            //              PADDLE DETECTORS - 2D, Energy versus T.O.F.
+            ////////////////////////////////////////////////////////////////////
+            
+            //analysisManager->FillH2(i+4, PADDLE_TOF[i][k], GainPADDLE*PADDLE_EDep[i][k] + OffsetPADDLE, fEventWeight);
             
-            if( PADDLE_EDep[i][k] >= G4RandGauss::shoot(PADDLE_ThresholdEnergy, 0.01*PADDLE_ThresholdEnergy))
-            {
-                ////////////////////////////////////////////////////////
-                //      PADDLE DETECTORS - 1D, Counts versus Energy
-                ////////////////////////////////////////////////////////
-                
-                //analysisManager->FillH1(i+7, GainPADDLE*PADDLE_EDep[i][k] + OffsetPADDLE, 1);
-                
-                PADDLE_TOF[i][k] = G4RandGauss::shoot(PADDLE_TOF[i][k], 0.05*PADDLE_TOF[i][k]);
-                
-                
-                ////////////////////////////////////////////////////////////////////
-                //              PADDLE DETECTORS - 2D, Position versus Energy
-                ////////////////////////////////////////////////////////////////////
-                //analysisManager->FillH2(i+1, PADDLE_positionX[i][k], PADDLE_positionY[i][k], PADDLE_EDep[i][k]);
-                
-                ////////////////////////////////////////////////////////////////////
-                //              PADDLE DETECTORS - 2D, Energy versus T.O.F.
-                ////////////////////////////////////////////////////////////////////
-                
-                //analysisManager->FillH2(i+4, PADDLE_TOF[i][k], GainPADDLE*PADDLE_EDep[i][k] + OffsetPADDLE, 1);
-                
-            }
         }
     }
     
@@ -363,66 +313,67 @@ void EventAction::EndOfEventAction(const G4Event* event)
     ////////////////////////////////////////////////////////
     bool eventTriggered_CLOVER = false;
 
-    for(G4int i=0; i<9; i++)
+    std::sort(CLOVER_HPGeCrystal_Touched.begin(), CLOVER_HPGeCrystal_Touched.end());
+    
+    for(size_t n=0; n<CLOVER_HPGeCrystal_Touched.size(); n++)
     {
-        for(G4int k=0; k<CLOVER_TotalTimeSamples; k++)
+        G4int j = CLOVER_HPGeCrystal_Touched[n]%4;
+        G4int k = (CLOVER_HPGeCrystal_Touched[n]/4)%CLOVER_TotalTimeSamples;
+        G4int i = (CLOVER_HPGeCrystal_Touched[n]/4)/CLOVER_TotalTimeSamples;
+        
+        //if(G4RandGauss::shoot(CLOVER_HPGeCrystal_EDep[i][j][k], 0.7) >= CLOVER_HPGeCrystal_ThresholdEnergy)
+      //  if(CLOVER_HPGeCrystal_EDep[i][j][k]>0.0)
+        if(CLOVER_HPGeCrystal_EDep[i][j][k]>0.0)
         {
-            for(G4int j=0; j<4; j++)
-            {
+            //cout << "HELLOOOOOOOOO" << G4endl;
 
-                //if(G4RandGauss::shoot(CLOVER_HPGeCrystal_EDep[i][j][k], 0.7) >= CLOVER_HPGeCrystal_ThresholdEnergy)
-              //  if(CLOVER_HPGeCrystal_EDep[i][j][k]>0.0)
-                if(CLOVER_HPGeCrystal_EDep[i][j][k]>0.0)
+            eventTriggered_CLOVER = true;
+            //CLOVER_HPGeCrystal_EDep[i][j][k] = G4RandGauss::shoot(CLOVER_HPGeCrystal_EDep[i][j][k], 1.7);
+            
+            if(Activate_CLOVER_ComptonSupression)
+            {
+                for(G4int l=0; l<CLOVER_ComptonSupression_TimeWindow; l++)
                 {
-                    //cout << "HELLOOOOOOOOO" << G4endl;
-
-                    eventTriggered_CLOVER = true;
-                    //CLOVER_HPGeCrystal_EDep[i][j][k] = G4RandGauss::shoot(CLOVER_HPGeCrystal_EDep[i][j][k], 1.7);
-                    
-                    if(Activate_CLOVER_ComptonSupression)
+                    for(G4int m=0; m<16; m++)
                     {
-                        for(G4int l=0; l<CLOVER_ComptonSupression_TimeWindow; l++)
+                        //      COMPTON SUPRESSION - VETO CLOVER Energy Depositions in anti-coincidence with BGO Shield Energy Deposition
+                        if (CLOVER_BGO_EDep[i][m][k+l] >= CLOVER_BGO_ThresholdEnergy)
                         {
-                            for(G4int m=0; m<16; m++)
-                            {
-                                //      COMPTON SUPRESSION - VETO CLOVER Energy Depositions in anti-coincidence with BGO Shield Energy Deposition
-                                if (CLOVER_BGO_EDep[i][m][k+l] >= CLOVER_BGO_ThresholdEnergy)
-                                {
-                                    CLOVER_HPGeCrystal_EDepVETO[i][j][k] = true;
-                                }
-                            }
+                            CLOVER_HPGeCrystal_EDepVETO[i][j][k] = true;
                         }
-                        if (CLOVER_HPGeCrystal_EDepVETO[i][j][k]) CLOVER_HPGeCrystal_EDep[i][j][k] = 0;
-                    }
-                    
-
-                    
-                    if(Activate_CLOVER_ADDBACK && CLOVER_HPGeCrystal_EDep[i][j][k] != 0)
-                    {
-                        //cout << "HELLOOOOOOOOO" << G4endl;
-
-                        //      ADDBACK
-                        CLOVER_EDep[i][k] += CLOVER_HPGeCrystal_EDep[i][j][k];
-                        
-                        //      For each Clover
-                        //analysisManager->FillH1(i+10, GainCLOVER*CLOVER_EDep[i][k] + OffsetCLOVER);
-                        
-                        //      For the Entire Clover Array
-                        //analysisManager->FillH1(19, GainCLOVER*CLOVER_EDep[i][k] +  OffsetCLOVER);
                     }
-                    
-                    else if(CLOVER_HPGeCrystal_EDep[i][j][k] != 0)
-                    {
-                        //      For each Clover
-                        //analysisManager->FillH1(i+10, GainCLOVER*CLOVER_HPGeCrystal_EDep[i][j][k] + OffsetCLOVER);
-                        
-                        //      For the Entire Clover Array
-                        //analysisManager->FillH1(19, GainCLOVER*CLOVER_HPGeCrystal_EDep[i][j][k] +  OffsetCLOVER);
-                    }
-                    
-                    
                 }
+                if (CLOVER_HPGeCrystal_EDepVETO[i][j][k]) CLOVER_HPGeCrystal_EDep[i][j][k] = 0;
             }
+            
+
+            
+            if(Activate_CLOVER_ADDBACK && CLOVER_HPGeCrystal_EDep[i][j][k] != 0)
+            {
+                //cout << "HELLOOOOOOOOO" << G4endl;
+
+                //      ADDBACK
+                CLOVER_EDep[i][k] += CLOVER_HPGeCrystal_EDep[i][j][k];
+                
+                //      For each Clover
+                //analysisManager->FillH1(i+10, GainCLOVER*CLOVER_EDep[i][k] + OffsetCLOVER, fEventWeight);
+                
+                //      For the Entire Clover Array
+                //analysisManager->FillH1(19, GainCLOVER*CLOVER_EDep[i][k] +  OffsetCLOVER, fEventWeight);
+            }
+            
+            else if(CLOVER_HPGeCrystal_EDep[i][j][k] != 0)
+            {
+                if(EfficiencyCurve::IsActive()) EfficiencyCurve::ScoreEnergy(kEfficiency_CLOVER, i, CLOVER_HPGeCrystal_EDep[i][j][k]);
+                
+                //      For each Clover
+                //analysisManager->FillH1(i+10, GainCLOVER*CLOVER_HPGeCrystal_EDep[i][j][k] + OffsetCLOVER, fEventWeight);
+                
+                //      For the Entire Clover Array
+                //analysisManager->FillH1(19, GainCLOVER*CLOVER_HPGeCrystal_EDep[i][j][k] +  OffsetCLOVER, fEventWeight);
+            }
+            
+            
         }
     }
     
@@ -431,18 +382,30 @@ void EventAction::EndOfEventAction(const G4Event* event)
     
     if(eventTriggered_CLOVER)
     {
-        for(G4int i=0; i<8; i++)
+        ////    The addback channels [i][k] of the sorted crystal keys are visited in ascending order
+        G4int lastAddbackKey = -1;
+        
+        for(size_t n=0; n<CLOVER_HPGeCrystal_Touched.size(); n++)
         {
-            for(G4int k=0; k<CLOVER_TotalTimeSamples; k++)
+            G4int addbackKey = CLOVER_HPGeCrystal_Touched[n]/4;
+            if(addbackKey == lastAddbackKey) continue;
+            lastAddbackKey = addbackKey;
+            
+            G4int i = addbackKey/CLOVER_TotalTimeSamples;
+            G4int k = addbackKey%CLOVER_TotalTimeSamples;
+            
+            if(EfficiencyCurve::IsActive()) EfficiencyCurve::ScoreEnergy(kEfficiency_CLOVER, i, CLOVER_EDep[i][k]);
+            
+            if(i<8 && CLOVER_EDep[i][k]>0.0)
             {
-                if(CLOVER_EDep[i][k]>0.0)
-                {
-                    analysisManager->FillNtupleIColumn(0, i, 1);
-                    analysisManager->FillNtupleDColumn(0, 8+i, CLOVER_EDep[i][k]);
-                    //cout << " CLOVER_EDep[i][k]:    " << CLOVER_EDep[i][k] <<  endl;
-                }
+                analysisManager->FillNtupleIColumn(0, i, 1);
+                analysisManager->FillNtupleDColumn(0, 8+i, CLOVER_EDep[i][k]);
+                //cout << " CLOVER_EDep[i][k]:    " << CLOVER_EDep[i][k] <<  endl;
             }
-            
+        }
+        
+        for(G4int i=0; i<8; i++)
+        {
             analysisManager->FillNtupleDColumn(0, 16+i, CLOVER_iEDep[i]);
             
             if(CLOVER_iEDep[i]>0.0)
@@ -460,6 +423,9 @@ void EventAction::EndOfEventAction(const G4Event* event)
     //
     ////////////////////////////////////////////////////////
     
+    ////    The energy deposits of every event, triggered or not, are tallied with both the track and the event weights
+    if(ImportanceBiasing_Active) ImportanceBiasing::ScoreEvent(fEventWeight*PARAFFINBOX_EDep, fEventWeight*IRONBOX_EDep);
+    
     bool eventTriggered_PARAFFINBOX = false;
     
     
@@ -471,7 +437,7 @@ void EventAction::EndOfEventAction(const G4Event* event)
             analysisManager->FillNtupleIColumn(0, 24, 1);
     //        cout << "PARAFFINBOX_EDep   " << PARAFFINBOX_EDep <<  endl;
             analysisManager->FillNtupleDColumn(0, 25, PARAFFINBOX_EDep);
-            //   analysisManager->FillH1(26,PARAFFINBOX_EDep);
+            //   analysisManager->FillH1(26,PARAFFINBOX_EDep, fEventWeight);
             //     cout << "PARAFFINBOX_EDep   " << PARAFFINBOX_EDep <<  endl;
                     
         }
@@ -514,7 +480,7 @@ void EventAction::EndOfEventAction(const G4Event* event)
 
     if(eventTriggered_CLOVER || eventTriggered_PARAFFINBOX || eventTriggered_IRONBOX)
     {
-        analysisManager->AddNtupleRow(0);
+        AddWeightedNtupleRow(0);
     }
     
  //   G4cout << " " << G4endl;
@@ -532,46 +498,56 @@ void EventAction::EndOfEventAction(const G4Event* event)
     OffsetLEPS = 0.0;
     bool eventTriggered_LEPS = false;
     
-    for(G4int i=0; i<8; i++)
+    std::sort(LEPS_HPGeCrystal_Touched.begin(), LEPS_HPGeCrystal_Touched.end());
+    
+    for(size_t n=0; n<LEPS_HPGeCrystal_Touched.size(); n++)
     {
-        for(G4int k=0; k<LEPS_TotalTimeSamples; k++)
+        G4int j = LEPS_HPGeCrystal_Touched[n]%4;
+        G4int k = (LEPS_HPGeCrystal_Touched[n]/4)%LEPS_TotalTimeSamples;
+        G4int i = (LEPS_HPGeCrystal_Touched[n]/4)/LEPS_TotalTimeSamples;
+        
+        ////    The addback of a LEPS is evaluated once its last touched crystal, within the time sample, has been processed
+        G4bool lastCrystalOfSample = (n+1 == LEPS_HPGeCrystal_Touched.size()) || (LEPS_HPGeCrystal_Touched[n+1]/4 != LEPS_HPGeCrystal_Touched[n]/4);
+        
+        if(G4RandGauss::shoot(LEPS_HPGeCrystal_EDep[i][j][k], 0.7) >= LEPS_HPGeCrystal_ThresholdEnergy)
         {
-            for(G4int j=0; j<4; j++)
-            {
-                if(G4RandGauss::shoot(LEPS_HPGeCrystal_EDep[i][j][k], 0.7) >= LEPS_HPGeCrystal_ThresholdEnergy)
-                {
-                    LEPS_HPGeCrystal_EDep[i][j][k] = abs(G4RandGauss::shoot(LEPS_HPGeCrystal_EDep[i][j][k], 1.7));
-                //    cout << "LEPS_HPGeCrystal_EDep[i][j][k]    " << LEPS_HPGeCrystal_EDep[i][j][k]<< "  i  j  k  " << i <<"   "<< j << "   " << k<< endl;
-                    
-                    
-                    //      ADDBACK
-                    if(Activate_LEPS_ADDBACK)
-                    {
-                       LEPS_EDep[i][k] += LEPS_HPGeCrystal_EDep[i][j][k];
-               //         cout << "1111111111LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "  i  j  k  " << i << "   " << k<< endl;
-                    }
-                }
-                
-                     //        cout << "LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "  i  j  k  " << i << "   " << k<< endl;
-            }
+            LEPS_HPGeCrystal_EDep[i][j][k] = abs(G4RandGauss::shoot(LEPS_HPGeCrystal_EDep[i][j][k], 1.7));
+        //    cout << "LEPS_HPGeCrystal_EDep[i][j][k]    " << LEPS_HPGeCrystal_EDep[i][j][k]<< "  i  j  k  " << i <<"   "<< j << "   " << k<< endl;
             
-
-        //    cout << "Activate_LEPS_ADDBACK    " << Activate_LEPS_ADDBACK << "LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "i  k  " << i <<"   "<< k << "LEPS_HPGeCrystal_ThresholdEnergy   " << LEPS_HPGeCrystal_ThresholdEnergy<< endl;
-            if(Activate_LEPS_ADDBACK && LEPS_EDep[i][k] >= LEPS_HPGeCrystal_ThresholdEnergy)
+            
+            if(ResponseMatrix::IsActive()) ResponseMatrix::ScoreEnergy(kResponse_LEPS, i, j, LEPS_HPGeCrystal_EDep[i][j][k]);
+            
+            ////    Without addback every crystal is measured on its own
+            if(!Activate_LEPS_ADDBACK && EfficiencyCurve::IsActive()) EfficiencyCurve::ScoreEnergy(kEfficiency_LEPS, i, LEPS_HPGeCrystal_EDep[i][j][k]);
+            
+            //      ADDBACK
+            if(Activate_LEPS_ADDBACK)
             {
-                analysisManager->FillNtupleIColumn(0, i, 1);
-                analysisManager->FillNtupleDColumn(0, i+8, GainLEPS*LEPS_EDep[i][k] + OffsetLEPS);
-                eventTriggered_LEPS = true;
-                
-         //   cout << "++++++++++++++++++Activate_LEPS_ADDBACK    " << Activate_LEPS_ADDBACK << "   LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "   i  k  " << i <<"   "<< k << "    LEPS_HPGeCrystal_ThresholdEnergy   " << LEPS_HPGeCrystal_ThresholdEnergy<< "    eventTriggered_LEPS   " << eventTriggered_LEPS << endl;
-                
-                
-                
+               LEPS_EDep[i][k] += LEPS_HPGeCrystal_EDep[i][j][k];
+       //         cout << "1111111111LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "  i  j  k  " << i << "   " << k<< endl;
             }
+        }
+        
+             //        cout << "LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "  i  j  k  " << i << "   " << k<< endl;
+        
+
+    //    cout << "Activate_LEPS_ADDBACK    " << Activate_LEPS_ADDBACK << "LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "i  k  " << i <<"   "<< k << "LEPS_HPGeCrystal_ThresholdEnergy   " << LEPS_HPGeCrystal_ThresholdEnergy<< endl;
+        if(lastCrystalOfSample && Activate_LEPS_ADDBACK && LEPS_EDep[i][k] >= LEPS_HPGeCrystal_ThresholdEnergy)
+        {
+            analysisManager->FillNtupleIColumn(0, i, 1);
+            analysisManager->FillNtupleDColumn(0, i+8, GainLEPS*LEPS_EDep[i][k] + OffsetLEPS);
+            eventTriggered_LEPS = true;
+            
+            if(EfficiencyCurve::IsActive()) EfficiencyCurve::ScoreEnergy(kEfficiency_LEPS, i, GainLEPS*LEPS_EDep[i][k] + OffsetLEPS);
+            
+     //   cout << "++++++++++++++++++Activate_LEPS_ADDBACK    " << Activate_LEPS_ADDBACK << "   LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "   i  k  " << i <<"   "<< k << "    LEPS_HPGeCrystal_ThresholdEnergy   " << LEPS_HPGeCrystal_ThresholdEnergy<< "    eventTriggered_LEPS   " << eventTriggered_LEPS << endl;
+            
+            
+            
         }
     }
      
-    if(eventTriggered_LEPS) analysisManager->AddNtupleRow(0);
+    if(eventTriggered_LEPS) AddWeightedNtupleRow(0);
 
     ////////////////////////////////////////////////////
     //
@@ -583,9 +559,14 @@ void EventAction::EndOfEventAction(const G4Event* event)
     OffsetNAIS = 0.0;
     bool eventTriggered_NAIS = false;
     
-    for(G4int i=0; i<5; i++)
+    std::sort(NAIS_Touched.begin(), NAIS_Touched.end());
+    
+    for(size_t n=0; n<NAIS_Touched.size(); n++)
     {
-        for(G4int k=0; k<NAIS_TotalTimeSamples; k++)
+        G4int i = NAIS_Touched[n]/NAIS_TotalTimeSamples;
+        G4int k = NAIS_Touched[n]%NAIS_TotalTimeSamples;
+        
+        if(i<5)
         {
 
                 if(G4RandGauss::shoot(NAIS_EDep[i][k], 0.7) >= NAIS_NaICrystal_ThresholdEnergy)
@@ -608,6 +589,9 @@ void EventAction::EndOfEventAction(const G4Event* event)
                 analysisManager->FillNtupleDColumn(0, i+5, GainNAIS*NAIS_EDep[i][k] + OffsetNAIS);
                 eventTriggered_NAIS = true;
                 
+                if(EfficiencyCurve::IsActive()) EfficiencyCurve::ScoreEnergy(kEfficiency_NAIS, i, GainNAIS*NAIS_EDep[i][k] + OffsetNAIS);
+                if(ResponseMatrix::IsActive()) ResponseMatrix::ScoreEnergy(kResponse_NAIS, i, 0, GainNAIS*NAIS_EDep[i][k] + OffsetNAIS);
+                
                 //   cout << "++++++++++++++++++Activate_LEPS_ADDBACK    " << Activate_LEPS_ADDBACK << "   LEPS_EDep[i][k]   " << LEPS_EDep[i][k] << "   i  k  " << i <<"   "<< k << "    LEPS_HPGeCrystal_ThresholdEnergy   " << LEPS_HPGeCrystal_ThresholdEnergy<< "    eventTriggered_LEPS   " << eventTriggered_LEPS << endl;
                 
                 
@@ -616,7 +600,13 @@ void EventAction::EndOfEventAction(const G4Event* event)
         }
     }
     
-    if(eventTriggered_NAIS) analysisManager->AddNtupleRow(0);
+    if(eventTriggered_NAIS) AddWeightedNtupleRow(0);
+    
+    ////    The measured energies of the event into the counts of its gamma-ray energy
+    if(EfficiencyCurve::IsActive()) EfficiencyCurve::EndOfEvent(event->GetEventID(), fEventWeight);
+    
+    ////    ... and the smeared energies of the NAIS and LEPS crystals into the response matrices
+    if(ResponseMatrix::IsActive()) ResponseMatrix::EndOfEvent(event->GetEventID(), fEventWeight);
     
     /*
     //analysisManager->FillNtupleIColumn(0, 0, 100);
@@ -627,7 +617,7 @@ void EventAction::EndOfEventAction(const G4Event* event)
     analysisManager->FillNtupleDColumn(0, 2, 50.);
     analysisManager->FillNtupleDColumn(0, 3, 50.);
 
-    analysisManager->AddNtupleRow(0);
+    AddWeightedNtupleRow(0);
     */
 
     
@@ -709,7 +699,7 @@ void EventAction::EndOfEventAction(const G4Event* event)
     analysisManager->FillNtupleDColumn(0, 15, WireplaneTraversePos[3][2][1]);
     
     
-    analysisManager->AddNtupleRow(0);
+    AddWeightedNtupleRow(0);
     */
     
     
@@ -730,7 +720,7 @@ void EventAction::EndOfEventAction(const G4Event* event)
         analysisManager->FillNtupleDColumn(2, 0, InputDist[0]);
         analysisManager->FillNtupleDColumn(2, 1, InputDist[1]);
         
-        analysisManager->AddNtupleRow(2);
+        AddWeightedNtupleRow(2);
         
         //G4cout << "Here is the value of InputDist[0]:    -->     " << InputDist[0] << G4endl;
         //G4cout << "Here is the value of InputDist[1]:    -->     " << InputDist[1] << G4endl;
@@ -769,7 +759,7 @@ void EventAction::EndOfEventAction(const G4Event* event)
                     //      Phi
                     analysisManager->FillNtupleDColumn(1, 4, GA_TIARA_AA[i][2]);
                     
-                    analysisManager->AddNtupleRow(1);
+                    AddWeightedNtupleRow(1);
                     
                     fileV_MMM << TIARANo << "    " << TIARA_RowNo << "    " << TIARA_SectorNo << "    " << GA_TIARA_AA[i][1] << "    " << GA_TIARA_AA[i][2] << endl;
                     
@@ -916,3 +906,370 @@ void EventAction::EndOfEventAction(const G4Event* event)
 }  
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::ReadHitsCollections(const G4Event* event)
+{
+    G4HCofThisEvent* hce = event->GetHCofThisEvent();
+    if(!hce) return;
+    
+    if(!fHCIDsInitialised)
+    {
+        G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+        
+        fTIARA_HCID = sdManager->GetCollectionID("TIARAHitsCollection");
+        fVDC_HCID = sdManager->GetCollectionID("VDCHitsCollection");
+        fVDCTraverse_HCID = sdManager->GetCollectionID("VDCTraverseHitsCollection");
+        fPADDLE_HCID = sdManager->GetCollectionID("PADDLEHitsCollection");
+        fCLOVER_HCID = sdManager->GetCollectionID("CLOVERHitsCollection");
+        fParaffinBox_HCID = sdManager->GetCollectionID("ParaffinBoxHitsCollection");
+        fIronBox_HCID = sdManager->GetCollectionID("IronBoxHitsCollection");
+        fLEPS_HCID = sdManager->GetCollectionID("LEPSHitsCollection");
+        fNAIS_HCID = sdManager->GetCollectionID("NAISHitsCollection");
+        
+        fHCIDsInitialised = true;
+    }
+    
+    ////////////////////////
+    //      TIARA
+    if(fTIARA_HCID>=0)
+    {
+        TIARAHitsCollection* hc = static_cast<TIARAHitsCollection*>(hce->GetHC(fTIARA_HCID));
+        
+        for(G4int n=0; hc && n<hc->entries(); n++)
+        {
+            TIARAHit* hit = (*hc)[n];
+            
+            FillVar_TIARA_AA(hit->GetTIARANo(), hit->GetRowNo(), hit->GetSectorNo(), 0, hit->GetTimeSample(), hit->GetEdep());
+            SetVar_TIARA_AA(hit->GetTIARANo(), hit->GetRowNo(), hit->GetSectorNo(), 1, hit->GetTimeSample(), hit->GetTheta());
+            SetVar_TIARA_AA(hit->GetTIARANo(), hit->GetRowNo(), hit->GetSectorNo(), 2, hit->GetTimeSample(), hit->GetPhi());
+            
+            TIARA_Touched.push_back(TIARAKey(hit->GetTIARANo(), hit->GetRowNo(), hit->GetSectorNo(), hit->GetTimeSample()));
+        }
+    }
+    
+    ////////////////////////
+    //      VDC
+    if(fVDC_HCID>=0)
+    {
+        VDCHitsCollection* hc = static_cast<VDCHitsCollection*>(hce->GetHC(fVDC_HCID));
+        
+        for(G4int k=0; hc && k<hc->entries() && k<hit_buffersize; k++)
+        {
+            VDCHit* hit = (*hc)[k];
+            FillVDC_Observables(k, hit->GetChannelID(), hit->GetEdep(), hit->GetEW_zpos(), hit->GetEW_t());
+            VDC_nofSlots = k+1;
+        }
+    }
+    
+    if(fVDCTraverse_HCID>=0)
+    {
+        VDCTraverseHitsCollection* hc = static_cast<VDCTraverseHitsCollection*>(hce->GetHC(fVDCTraverse_HCID));
+        
+        for(G4int n=0; hc && n<hc->entries(); n++)
+        {
+            VDCTraverseHit* hit = (*hc)[n];
+            G4int wireplaneNo = hit->GetWireplaneNo();
+            
+            if(hit->HasPRE())
+            {
+                for(G4int component=0; component<3; component++) SetVDC_WireplaneTraversePos(wireplaneNo, 0, component, hit->GetPREPosition()[component]);
+            }
+            
+            if(hit->HasPOST())
+            {
+                SetVDC_WireplaneTraversePOST(wireplaneNo, true);
+                for(G4int component=0; component<3; component++) SetVDC_WireplaneTraversePos(wireplaneNo, 1, component, hit->GetPOSTPosition()[component]);
+            }
+        }
+    }
+    
+    ////////////////////////
+    //      PADDLE
+    if(fPADDLE_HCID>=0)
+    {
+        PADDLEHitsCollection* hc = static_cast<PADDLEHitsCollection*>(hce->GetHC(fPADDLE_HCID));
+        
+        for(G4int n=0; hc && n<hc->entries(); n++)
+        {
+            PADDLEHit* hit = (*hc)[n];
+            
+            AddEnergy_PADDLE(hit->GetPADDLENo(), hit->GetTimeSample(), hit->GetEdep());
+            TagTOF_PADDLE(hit->GetPADDLENo(), hit->GetTimeSample(), hit->GetTOF());
+            AddEWpositionX_PADDLE(hit->GetPADDLENo(), hit->GetTimeSample(), hit->GetEWpositionX());
+            AddEWpositionY_PADDLE(hit->GetPADDLENo(), hit->GetTimeSample(), hit->GetEWpositionY());
+            
+            PADDLE_Touched.push_back(hit->GetPADDLENo()*PADDLE_TotalTimeSamples + hit->GetTimeSample());
+        }
+    }
+    
+    ////////////////////////
+    //      CLOVERS
+    if(fCLOVER_HCID>=0)
+    {
+        CrystalHitsCollection* hc = static_cast<CrystalHitsCollection*>(hce->GetHC(fCLOVER_HCID));
+        
+        for(G4int n=0; hc && n<hc->entries(); n++)
+        {
+            CrystalHit* hit = (*hc)[n];
+            
+            AddEnergyCLOVER_HPGeCrystal(hit->GetDetectorNo(), hit->GetCrystalNo(), hit->GetTimeSample(), hit->GetEdep());
+            CLOVER_HPGeCrystal_Touched.push_back((hit->GetDetectorNo()*CLOVER_TotalTimeSamples + hit->GetTimeSample())*4 + hit->GetCrystalNo());
+            
+            ////    The hits are stored in order of creation, the first hit of a CLOVER carries its incident energy
+            if(GetCLOVER_iEDep(hit->GetDetectorNo())==0) SetCLOVER_iEDep(hit->GetDetectorNo(), hit->GetIncidentEnergy());
+        }
+    }
+    
+    ////////////////////////
+    //      PARAFFIN BOX
+    if(fParaffinBox_HCID>=0)
+    {
+        CrystalHitsCollection* hc = static_cast<CrystalHitsCollection*>(hce->GetHC(fParaffinBox_HCID));
+        
+        if(hc && hc->entries()>0)
+        {
+            AddEnergyParaffinBox((*hc)[0]->GetEdep());
+            SetPARAFFINBOX_iEDep((*hc)[0]->GetIncidentEnergy());
+        }
+    }
+    
+    ////////////////////////
+    //      IRON BOX
+    if(fIronBox_HCID>=0)
+    {
+        CrystalHitsCollection* hc = static_cast<CrystalHitsCollection*>(hce->GetHC(fIronBox_HCID));
+        
+        if(hc && hc->entries()>0)
+        {
+            AddEnergyIronBox((*hc)[0]->GetEdep());
+            SetIRONBOX_iEDep((*hc)[0]->GetIncidentEnergy());
+        }
+    }
+    
+    ////////////////////////
+    //      LEPS
+    if(fLEPS_HCID>=0)
+    {
+        CrystalHitsCollection* hc = static_cast<CrystalHitsCollection*>(hce->GetHC(fLEPS_HCID));
+        
+        for(G4int n=0; hc && n<hc->entries(); n++)
+        {
+            CrystalHit* hit = (*hc)[n];
+            AddEnergyLEPS_HPGeCrystals(hit->GetDetectorNo(), hit->GetCrystalNo(), hit->GetTimeSample(), hit->GetEdep());
+            LEPS_HPGeCrystal_Touched.push_back((hit->GetDetectorNo()*LEPS_TotalTimeSamples + hit->GetTimeSample())*4 + hit->GetCrystalNo());
+        }
+    }
+    
+    ////////////////////////
+    //      NAIS
+    if(fNAIS_HCID>=0)
+    {
+        CrystalHitsCollection* hc = static_cast<CrystalHitsCollection*>(hce->GetHC(fNAIS_HCID));
+        
+        for(G4int n=0; hc && n<hc->entries(); n++)
+        {
+            CrystalHit* hit = (*hc)[n];
+            AddEnergyNAIS_NaICrystals(hit->GetDetectorNo(), hit->GetTimeSample(), hit->GetEdep());
+            NAIS_Touched.push_back(hit->GetDetectorNo()*NAIS_TotalTimeSamples + hit->GetTimeSample());
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::ClearAllChannels()
+{
+    for(G4int i=0; i<9; i++)
+    {
+        CLOVER_iEDep[i] = 0.0;
+        
+        for (G4int k=0; k<CLOVER_TotalTimeSamples; k++)
+        {
+            CLOVER_EDep[i][k] = 0;
+            
+            for(G4int j=0; j<4; j++)
+            {
+                CLOVER_HPGeCrystal_EDep[i][j][k] = 0;
+                CLOVER_HPGeCrystal_EDepVETO[i][j][k] = false;
+            }
+        }
+        
+        for (G4int m=0; m<CLOVER_Shield_BGO_TotalTimeSamples+CLOVER_ComptonSupression_TimeWindow; m++)
+        {
+            for(G4int l=0; l<16; l++)
+            {
+                CLOVER_BGO_EDep[i][l][m] = 0;
+            }
+        }
+    }
+    
+    PARAFFINBOX_EDep = 0.0;
+    PARAFFINBOX_iEDep = 0.0;
+    
+    IRONBOX_EDep = 0.0;
+    IRONBOX_iEDep = 0.0;
+    
+    for(G4int i=0; i<8; i++)
+    {
+        for(G4int k=0; k<LEPS_TotalTimeSamples; k++)
+        {
+            LEPS_EDep[i][k] = 0.;
+            
+            for(G4int j=0; j<4; j++)
+            {
+                LEPS_HPGeCrystal_EDep[i][j][k] = 0;
+            }
+        }
+        
+        for(G4int k=0; k<NAIS_TotalTimeSamples; k++)
+        {
+            NAIS_EDep[i][k] = 0.;
+        }
+    }
+    
+    for(G4int i=0; i<5; i++)
+    {
+        for(G4int k = 0; k<TIARA_TotalTimeSamples; k++)
+        {
+            for(G4int j=0; j<16; j++)
+            {
+                for(G4int l=0; l<8; l++)
+                {
+                    for(G4int m=0; m<3; m++)
+                    {
+                        TIARA_AA[i][j][l][m][k] = 0;
+                    }
+                }
+            }
+        }
+    }
+    
+    for(G4int i=0; i<3; i++)
+    {
+        PADDLE_Trig[i] = 0;
+        
+        for (G4int k=0; k<PADDLE_TotalTimeSamples; k++)
+        {
+            PADDLE_EDep[i][k] = 0;
+            PADDLE_TOF[i][k] = 0;
+            
+            PADDLE_EWpositionX[i][k] = 0;
+            PADDLE_EWpositionY[i][k] = 0;
+            
+            PADDLE_positionX[i][k] = 0;
+            PADDLE_positionY[i][k] = 0;
+        }
+    }
+    
+    for(G4int j=0; j<4; j++)
+    {
+        for (G4int k=0; k<hit_buffersize; k++)
+        {
+            if(j==0) VDC_Observables[j][k] = -1;
+            else{VDC_Observables[j][k] = 0;}
+        }
+    }
+    
+    TIARA_Touched.clear();
+    PADDLE_Touched.clear();
+    CLOVER_HPGeCrystal_Touched.clear();
+    LEPS_HPGeCrystal_Touched.clear();
+    NAIS_Touched.clear();
+    
+    VDC_nofSlots = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::ClearTouchedChannels()
+{
+    ////    TIARA
+    for(size_t n=0; n<TIARA_Touched.size(); n++)
+    {
+        G4int i, j, l, k;
+        DecodeTIARAKey(TIARA_Touched[n], i, j, l, k);
+        
+        for(G4int m=0; m<3; m++)
+        {
+            TIARA_AA[i][j][l][m][k] = 0;
+        }
+    }
+    TIARA_Touched.clear();
+    
+    ////    PADDLE
+    for(size_t n=0; n<PADDLE_Touched.size(); n++)
+    {
+        G4int i = PADDLE_Touched[n]/PADDLE_TotalTimeSamples;
+        G4int k = PADDLE_Touched[n]%PADDLE_TotalTimeSamples;
+        
+        PADDLE_EDep[i][k] = 0;
+        PADDLE_TOF[i][k] = 0;
+        
+        PADDLE_EWpositionX[i][k] = 0;
+        PADDLE_EWpositionY[i][k] = 0;
+        
+        PADDLE_positionX[i][k] = 0;
+        PADDLE_positionY[i][k] = 0;
+    }
+    PADDLE_Touched.clear();
+    
+    for(G4int i=0; i<3; i++)
+    {
+        PADDLE_Trig[i] = 0;
+    }
+    
+    ////    CLOVER, the addback channels are shared by the crystals of a CLOVER
+    for(size_t n=0; n<CLOVER_HPGeCrystal_Touched.size(); n++)
+    {
+        G4int j = CLOVER_HPGeCrystal_Touched[n]%4;
+        G4int k = (CLOVER_HPGeCrystal_Touched[n]/4)%CLOVER_TotalTimeSamples;
+        G4int i = (CLOVER_HPGeCrystal_Touched[n]/4)/CLOVER_TotalTimeSamples;
+        
+        CLOVER_HPGeCrystal_EDep[i][j][k] = 0;
+        CLOVER_HPGeCrystal_EDepVETO[i][j][k] = false;
+        CLOVER_EDep[i][k] = 0;
+    }
+    CLOVER_HPGeCrystal_Touched.clear();
+    
+    for(G4int i=0; i<9; i++)
+    {
+        CLOVER_iEDep[i] = 0.0;
+    }
+    
+    PARAFFINBOX_EDep = 0.0;
+    PARAFFINBOX_iEDep = 0.0;
+    
+    IRONBOX_EDep = 0.0;
+    IRONBOX_iEDep = 0.0;
+    
+    ////    LEPS
+    for(size_t n=0; n<LEPS_HPGeCrystal_Touched.size(); n++)
+    {
+        G4int j = LEPS_HPGeCrystal_Touched[n]%4;
+        G4int k = (LEPS_HPGeCrystal_Touched[n]/4)%LEPS_TotalTimeSamples;
+        G4int i = (LEPS_HPGeCrystal_Touched[n]/4)/LEPS_TotalTimeSamples;
+        
+        LEPS_HPGeCrystal_EDep[i][j][k] = 0;
+        LEPS_EDep[i][k] = 0.;
+    }
+    LEPS_HPGeCrystal_Touched.clear();
+    
+    ////    NAIS
+    for(size_t n=0; n<NAIS_Touched.size(); n++)
+    {
+        NAIS_EDep[NAIS_Touched[n]/NAIS_TotalTimeSamples][NAIS_Touched[n]%NAIS_TotalTimeSamples] = 0.;
+    }
+    NAIS_Touched.clear();
+    
+    ////    VDC, only the slots which were filled
+    for(G4int k=0; k<VDC_nofSlots; k++)
+    {
+        VDC_Observables[0][k] = -1;
+        VDC_Observables[1][k] = 0;
+        VDC_Observables[2][k] = 0;
+        VDC_Observables[3][k] = 0;
+    }
+    VDC_nofSlots = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,232 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "ImportanceBiasing.hh"
+#include "RunAccumulable.hh"
+
+#include "G4IStore.hh"
+#include "G4GeometryCell.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4Timer.hh"
+#include "G4AutoLock.hh"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    ////    The importance stores of the threads are filled one at a time
+    G4Mutex importanceBiasingMutex = G4MUTEX_INITIALIZER;
+    
+    struct ImportanceTallies
+    {
+        ImportanceTallies() : nofEvents(0)
+        {
+            for(G4int i=0; i<numberOf_ImportanceTallies; i++)
+            {
+                sum[i] = 0.;
+                sum2[i] = 0.;
+            }
+        }
+        
+        void Merge(const ImportanceTallies& other)
+        {
+            nofEvents += other.nofEvents;
+            for(G4int i=0; i<numberOf_ImportanceTallies; i++)
+            {
+                sum[i] += other.sum[i];
+                sum2[i] += other.sum2[i];
+            }
+        }
+        
+        G4long      nofEvents;
+        G4double    sum[numberOf_ImportanceTallies];
+        G4double    sum2[numberOf_ImportanceTallies];
+    };
+    
+    RunAccumulable<ImportanceTallies> importanceTallies;
+    
+    ////    Wall-clock time of the run on the master, for the figure of merit
+    G4Timer runTimer;
+    
+    void AddCell(G4IStore* store, const G4VPhysicalVolume* volume, G4double importance)
+    {
+        if(store->IsKnown(G4GeometryCell(*volume, 0))) store->ChangeImportance(importance, *volume, 0);
+        else store->AddImportanceGeometryCell(importance, *volume, 0);
+    }
+}
+
+G4bool                                  ImportanceBiasing::fAnalog = false;
+G4double                                ImportanceBiasing::fImportance[numberOf_ImportanceShells];
+std::vector<const G4VPhysicalVolume*>   ImportanceBiasing::fShells;
+const G4VPhysicalVolume*                ImportanceBiasing::fWorld = 0;
+G4bool                                  ImportanceBiasing::fHasReference = false;
+G4double                                ImportanceBiasing::fReferenceMean[numberOf_ImportanceTallies];
+G4double                                ImportanceBiasing::fReferenceError[numberOf_ImportanceTallies];
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceBiasing::SetImportance(G4int shell, G4double importance)
+{
+    if(shell < 0 || shell >= numberOf_ImportanceShells || importance < 0.)
+    {
+        G4cerr << "ImportanceBiasing: invalid importance " << importance << " of shell " << shell << G4endl;
+        return;
+    }
+    
+    fImportance[shell] = importance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double ImportanceBiasing::GetImportance(G4int shell)
+{
+    if(fAnalog) return 1.;
+    
+    return fImportance[shell] > 0. ? fImportance[shell] : ImportanceShell_Importance[shell];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceBiasing::SetCells(const std::vector<const G4VPhysicalVolume*>& shells, const G4VPhysicalVolume* world)
+{
+    fShells = shells;
+    fWorld = world;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceBiasing::BeginOfRun()
+{
+    if(fAnalog)
+    {
+        G4cout << "\n---> Importance biasing: analog run, every importance is 1" << G4endl;
+    }
+    else
+    {
+        G4cout << "\n---> Importance biasing of the " << ImportanceBiasing_Particle << "s, shell importances:";
+        for(G4int i=0; i<numberOf_ImportanceShells; i++) G4cout << " " << GetImportance(i);
+        G4cout << G4endl;
+        G4cout << "     Only the ParaffinBox and the IronBox score the track weights" << G4endl;
+    }
+    
+    runTimer.Start();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceBiasing::BeginOfThreadRun()
+{
+    if(!fWorld) return;
+    
+    G4AutoLock lock(&importanceBiasingMutex);
+    
+    G4IStore* store = G4IStore::GetInstance(ImportanceBiasing_WorldName);
+    
+    ////    The world outside the shells keeps the importance of the outermost shell
+    for(size_t i=0; i<fShells.size(); i++) AddCell(store, fShells[i], GetImportance(i));
+    AddCell(store, fWorld, GetImportance(numberOf_ImportanceShells-1));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceBiasing::ScoreEvent(G4double paraffinBoxEDep, G4double ironBoxEDep)
+{
+    ImportanceTallies& tallies = importanceTallies.GetLocal();
+    
+    const G4double eDep[numberOf_ImportanceTallies] = {paraffinBoxEDep, ironBoxEDep};
+    
+    tallies.nofEvents++;
+    for(G4int i=0; i<numberOf_ImportanceTallies; i++)
+    {
+        tallies.sum[i] += eDep[i];
+        tallies.sum2[i] += eDep[i]*eDep[i];
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceBiasing::PrintTallies()
+{
+    runTimer.Stop();
+    
+    const ImportanceTallies& tallies = importanceTallies.GetMerged();
+    const G4long nofEvents = tallies.nofEvents;
+    
+    if(nofEvents < 2) return;
+    
+    const G4double time = runTimer.GetRealElapsed();
+    
+    G4cout << "\n---> Importance biasing, " << (fAnalog ? "analog" : "biased") << " tallies of " << nofEvents << " events:" << G4endl;
+    
+    for(G4int i=0; i<numberOf_ImportanceTallies; i++)
+    {
+        const G4double mean = tallies.sum[i]/nofEvents;
+        const G4double variance = std::max(0., tallies.sum2[i]/nofEvents - mean*mean)/(nofEvents - 1);
+        const G4double error = std::sqrt(variance);
+        
+        G4cout << "     " << ImportanceTally_Name[i] << ": " << mean << " +- " << error << " keV per event";
+        
+        if(mean > 0.)
+        {
+            ////    Figure of merit 1/(R^2 T), with R the relative error of the mean
+            const G4double relativeError = error/mean;
+            G4cout << ", relative error " << 100.*relativeError << " %";
+            if(relativeError > 0. && time > 0.) G4cout << ", FOM " << 1./(relativeError*relativeError*time) << " /s";
+        }
+        G4cout << G4endl;
+        
+        if(fAnalog)
+        {
+            fReferenceMean[i] = mean;
+            fReferenceError[i] = error;
+        }
+        else if(fHasReference)
+        {
+            ////    Consistency with the last analog run
+            const G4double sigma = std::sqrt(error*error + fReferenceError[i]*fReferenceError[i]);
+            const G4double deviation = sigma > 0. ? (mean - fReferenceMean[i])/sigma : 0.;
+            G4cout << "       analog " << fReferenceMean[i] << " +- " << fReferenceError[i] << " keV, deviation " << deviation << " sigma";
+            if(std::fabs(deviation) > 3.) G4cout << "  *** INCONSISTENT ***";
+            G4cout << G4endl;
+        }
+    }
+    
+    if(fAnalog) fHasReference = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "ImportanceBiasingMessenger.hh"
+#include "ImportanceBiasing.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceBiasingMessenger::ImportanceBiasingMessenger()
+: G4UImessenger()
+{
+    fImportanceDirectory = new G4UIdirectory("/K600/importance/");
+    fImportanceDirectory->SetGuidance("Importances of the shells around the AmBe source, see ImportanceBiasing.hh");
+    
+    fAnalogCmd = new G4UIcmdWithABool("/K600/importance/analog", this);
+    fAnalogCmd->SetGuidance("Sets every importance to 1, the reference run of the biased runs");
+    fAnalogCmd->SetParameterName("flag", false);
+    fAnalogCmd->SetToBeBroadcasted(false);
+    fAnalogCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fImportanceCmd = new G4UIcommand("/K600/importance/shell", this);
+    fImportanceCmd->SetGuidance("Importance of a shell, innermost 0, 0 for its default");
+    fImportanceCmd->SetGuidance("The world outside the shells has the importance of the outermost shell");
+    G4UIparameter* shell = new G4UIparameter("shell", 'i', false);
+    std::ostringstream range;
+    range << "shell >= 0 && shell < " << numberOf_ImportanceShells;
+    shell->SetParameterRange(range.str().c_str());
+    fImportanceCmd->SetParameter(shell);
+    G4UIparameter* importance = new G4UIparameter("importance", 'd', false);
+    importance->SetParameterRange("importance >= 0.");
+    fImportanceCmd->SetParameter(importance);
+    fImportanceCmd->SetToBeBroadcasted(false);
+    fImportanceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceBiasingMessenger::~ImportanceBiasingMessenger()
+{
+    delete fAnalogCmd;
+    delete fImportanceCmd;
+    delete fImportanceDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceBiasingMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if(command == fAnalogCmd) ImportanceBiasing::SetAnalog(fAnalogCmd->GetNewBoolValue(newValue));
+    else if(command == fImportanceCmd)
+    {
+        G4int shell;
+        G4double importance;
+        std::istringstream values(newValue);
+        values >> shell >> importance;
+        ImportanceBiasing::SetImportance(shell, importance);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
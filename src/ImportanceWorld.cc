@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "ImportanceWorld.hh"
+#include "ImportanceBiasing.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4Orb.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceWorld::ImportanceWorld(const G4String& worldName, const DetectorConstruction* detector)
+: G4VUserParallelWorld(worldName),
+fDetector(detector),
+fWorldVolume(0)
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceWorld::~ImportanceWorld()
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorld::Construct()
+{
+    fWorldVolume = GetWorld();
+    
+    ////    The outermost shell is placed within the world, every other shell within the next one
+    std::vector<const G4VPhysicalVolume*> shells(numberOf_ImportanceShells);
+    G4LogicalVolume* mother = fWorldVolume->GetLogicalVolume();
+    G4ThreeVector position = fDetector->GetAmBeSourcePosition();
+    
+    for(G4int i=numberOf_ImportanceShells-1; i>=0; i--)
+    {
+        std::ostringstream name;
+        name << "ImportanceShell_" << i;
+        
+        G4Orb* solid = new G4Orb(name.str(), ImportanceShell_OuterRadius[i]*cm);
+        G4LogicalVolume* logical = new G4LogicalVolume(solid, 0, name.str());
+        
+        shells[i] = new G4PVPlacement(0,               // no rotation
+                                      position,        // at (x,y,z)
+                                      logical,         // its logical volume
+                                      name.str(),      // its name
+                                      mother,          // its mother volume
+                                      false,           // no boolean operations
+                                      0);              // copy number
+        
+        mother = logical;
+        position = G4ThreeVector();
+    }
+    
+    ImportanceBiasing::SetCells(shells, fWorldVolume);
+    
+    G4cout << "\n---> Importance biasing within " << numberOf_ImportanceShells << " shells of up to " << ImportanceShell_OuterRadius[numberOf_ImportanceShells-1] << " cm around the AmBe source" << G4endl;
+    if(!fDetector->IsNeutronShieldingPresent()) G4cout << "     Neither the ParaffinBox nor the IronBox is present" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,107 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "LEPSSD.hh"
+#include "EventAction.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
+#include "G4SDManager.hh"
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+LEPSSD::LEPSSD(const G4String& name, const G4String& hitsCollectionName)
+: G4VSensitiveDetector(name),
+fHitsCollection(0),
+fHitIndex(numberOf_LEPS*4*LEPS_TotalTimeSamples, -1)
+{
+    collectionName.insert(hitsCollectionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+LEPSSD::~LEPSSD()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LEPSSD::Initialize(G4HCofThisEvent* hce)
+{
+    // Create hits collection
+    fHitsCollection = new CrystalHitsCollection(SensitiveDetectorName, collectionName[0]);
+    
+    // Add this collection in hce
+    G4int hcID = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
+    hce->AddHitsCollection(hcID, fHitsCollection);
+    
+    // Reset the crystals which were hit within the previous event
+    for(size_t i=0; i<fTouchedIndices.size(); i++) fHitIndex[fTouchedIndices[i]] = -1;
+    fTouchedIndices.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool LEPSSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+    G4double edep = step->GetTotalEnergyDeposit()/keV;
+    if(edep==0.) return false;
+    
+    G4StepPoint* preStepPoint = step->GetPreStepPoint();
+    
+    G4double interactiontime = preStepPoint->GetGlobalTime()/ns;
+    if(interactiontime >= LEPS_TotalSampledTime) return false;
+    
+    G4int channelID = preStepPoint->GetTouchableHandle()->GetCopyNumber();
+    G4int iTS = interactiontime/LEPS_SamplingTime;
+    G4int index = channelID*LEPS_TotalTimeSamples + iTS;
+    
+    if(fHitIndex[index] < 0)
+    {
+        G4int LEPSNo = channelID/4;
+        G4int LEPS_HPGeCrystalNo = channelID%4;
+        
+        fHitIndex[index] = fHitsCollection->insert(new CrystalHit(LEPSNo, LEPS_HPGeCrystalNo, iTS, preStepPoint->GetKineticEnergy()/keV)) - 1;
+        fTouchedIndices.push_back(index);
+    }
+    
+    (*fHitsCollection)[fHitIndex[index]]->Add(edep);
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
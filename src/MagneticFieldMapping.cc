@@ -39,19 +39,79 @@
 #include "MagneticFieldMapping.hh"
 #include "G4SystemOfUnits.hh"
 
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 MagneticFieldMapping::MagneticFieldMapping( const char* filename, double zOffset )
-  :fZoffset(zOffset),invertX(false),invertY(false),invertZ(false)
+  :fField(0),fMapping(0),fMappingSize(0),fZoffset(zOffset),invertX(false),invertY(false),invertZ(false)
 {    
  
-  double lenUnit= meter;
-  double fieldUnit= tesla;
   G4cout << "\n-----------------------------------------------------------"
 	 << "\n      Magnetic field"
 	 << "\n-----------------------------------------------------------";
     
+  if ( !ReadBinary( filename ) ) {
+    ReadTable( filename );
+  }
+
+  G4cout << "\n ---> The field will be offset by " << zOffset/cm << " cm "
+	 << "\nAfter reordering if neccesary"  
+	 << "\n ---> Min values x,y,z: " 
+	 << minx/cm << " " << miny/cm << " " << minz/cm << " cm "
+	 << " \n ---> Max values x,y,z: " 
+	 << maxx/cm << " " << maxy/cm << " " << maxz/cm << " cm ";
+
+  dx = maxx - minx;
+  dy = maxy - miny;
+  dz = maxz - minz;
+  G4cout << "\n ---> Dif values x,y,z (range): " 
+	 << dx/cm << " " << dy/cm << " " << dz/cm << " cm in z "
+	 << "\n-----------------------------------------------------------" << endl;
+
+  strideZ = 4;
+  strideY = nz*strideZ;
+  strideX = ny*strideY;
+
+  // Precompute the mapping onto the grid coordinates, including the
+  // inverse spacings of the grid
+  xOrigin = invertX ? maxx : minx;
+  yOrigin = invertY ? maxy : miny;
+  zOrigin = invertZ ? maxz : minz;
+  xScale = (invertX ? -1. : 1.) * (nx-1) / dx;
+  yScale = (invertY ? -1. : 1.) * (ny-1) / dy;
+  zScale = (invertZ ? -1. : 1.) * (nz-1) / dz;
+}
+
+MagneticFieldMapping::~MagneticFieldMapping()
+{
+  if (fMapping) munmap(fMapping, fMappingSize);
+}
+
+void MagneticFieldMapping::ReadTable( const char* filename )
+{
+  double lenUnit= meter;
+  double fieldUnit= tesla;
+
   G4cout << "\n ---> " "Reading the field grid from " << filename << " ... " << endl; 
   ifstream file( filename ); // Open the file for reading.
   
+  if ( !file ) {
+    G4ExceptionDescription msg;
+    msg << "The field map " << filename << " could not be opened.";
+    G4Exception("MagneticFieldMapping::ReadTable()", "K600FieldMap001", FatalException, msg);
+    return;
+  }
+  
   // Ignore first blank line
   char buffer[256];
   file.getline(buffer,256);
@@ -64,27 +124,17 @@ MagneticFieldMapping::MagneticFieldMapping( const char* filename, double zOffset
 	 << endl;
 
   // Set up storage space for table
-  xField.resize( nx );
-  yField.resize( nx );
-  zField.resize( nx );
+  int tableStrideY = nz*4;
+  int tableStrideX = ny*tableStrideY;
+  fFieldStorage.assign( nx*tableStrideX, 0. );
+  fField = &fFieldStorage[0];
   int ix, iy, iz;
-  for (ix=0; ix<nx; ix++) {
-    xField[ix].resize(ny);
-    yField[ix].resize(ny);
-    zField[ix].resize(ny);
-    for (iy=0; iy<ny; iy++) {
-      xField[ix][iy].resize(nz);
-      yField[ix][iy].resize(nz);
-      zField[ix][iy].resize(nz);
-    }
-  }
-  
   // Ignore other header information    
   // The first line whose second character is '0' is considered to
   // be the last line of the header.
   do {
     file.getline(buffer,256);
-  } while ( buffer[1]!='0');
+  } while ( file && buffer[1]!='0');
   
   // Read in the data
   double xval,yval,zval,bx,by,bz;
@@ -98,9 +148,10 @@ MagneticFieldMapping::MagneticFieldMapping( const char* filename, double zOffset
           miny = yval * lenUnit;
           minz = zval * lenUnit;
         }
-        xField[ix][iy][iz] = bx * fieldUnit;
-        yField[ix][iy][iz] = by * fieldUnit;
-        zField[ix][iy][iz] = bz * fieldUnit;
+        double* node = &fFieldStorage[ix*tableStrideX + iy*tableStrideY + iz*4];
+        node[0] = bx * fieldUnit;
+        node[1] = by * fieldUnit;
+        node[2] = bz * fieldUnit;
       }
     }
   }
@@ -117,25 +168,112 @@ MagneticFieldMapping::MagneticFieldMapping( const char* filename, double zOffset
 	 << "\n ---> Min values x,y,z: " 
 	 << minx/cm << " " << miny/cm << " " << minz/cm << " cm "
 	 << "\n ---> Max values x,y,z: " 
-	 << maxx/cm << " " << maxy/cm << " " << maxz/cm << " cm "
-	 << "\n ---> The field will be offset by " << zOffset/cm << " cm " << endl;
+	 << maxx/cm << " " << maxy/cm << " " << maxz/cm << " cm " << endl;
 
   // Should really check that the limits are not the wrong way around.
   if (maxx < minx) {swap(maxx,minx); invertX = true;} 
   if (maxy < miny) {swap(maxy,miny); invertY = true;} 
   if (maxz < minz) {swap(maxz,minz); invertZ = true;} 
-  G4cout << "\nAfter reordering if neccesary"  
-	 << "\n ---> Min values x,y,z: " 
-	 << minx/cm << " " << miny/cm << " " << minz/cm << " cm "
-	 << " \n ---> Max values x,y,z: " 
-	 << maxx/cm << " " << maxy/cm << " " << maxz/cm << " cm ";
+}
 
-  dx = maxx - minx;
-  dy = maxy - miny;
-  dz = maxz - minz;
-  G4cout << "\n ---> Dif values x,y,z (range): " 
-	 << dx/cm << " " << dy/cm << " " << dz/cm << " cm in z "
-	 << "\n-----------------------------------------------------------" << endl;
+bool MagneticFieldMapping::ReadBinary( const char* filename )
+{
+  int fd = open(filename, O_RDONLY);
+  if (fd<0) return false;
+
+  // Only files starting with the magic of the binary format are mapped
+  MagneticFieldMapHeader header;
+  if ( read(fd, &header, sizeof(header)) != (ssize_t) sizeof(header) ||
+       memcmp(header.magic, "K600FMAP", 8) != 0 ) {
+    close(fd);
+    return false;
+  }
+
+  G4cout << "\n ---> " "Mapping the binary field grid from " << filename << " ... " << endl; 
+
+  struct stat fileStatus;
+  size_t nofValues = size_t(header.nx) * header.ny * header.nz * 4;
+  bool isValid = header.version == 1 && header.nofComponents == 4 &&
+                 header.nx > 1 && header.ny > 1 && header.nz > 1 &&
+                 fstat(fd, &fileStatus) == 0 &&
+                 size_t(fileStatus.st_size) == sizeof(header) + nofValues*sizeof(double);
+
+  void* mapping = MAP_FAILED;
+  if (isValid) {
+    // A read-only shared mapping, the pages are shared by every instance within the process
+    mapping = mmap(0, fileStatus.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+
+  if (mapping == MAP_FAILED) {
+    G4ExceptionDescription msg;
+    msg << "The binary field map " << filename << " is invalid or could not be mapped.";
+    G4Exception("MagneticFieldMapping::ReadBinary()", "K600FieldMap002", FatalException, msg);
+    return true;
+  }
+
+  fMapping = mapping;
+  fMappingSize = fileStatus.st_size;
+
+  nx = header.nx;
+  ny = header.ny;
+  nz = header.nz;
+  minx = header.minx * header.lengthUnit;
+  maxx = header.maxx * header.lengthUnit;
+  miny = header.miny * header.lengthUnit;
+  maxy = header.maxy * header.lengthUnit;
+  minz = header.minz * header.lengthUnit;
+  maxz = header.maxz * header.lengthUnit;
+  invertX = (header.flags & kInvertX) != 0;
+  invertY = (header.flags & kInvertY) != 0;
+  invertZ = (header.flags & kInvertZ) != 0;
+
+  const double* payload = reinterpret_cast<const double*>(static_cast<const char*>(fMapping) + sizeof(header));
+
+  if (header.fieldUnit == 1.) {
+    fField = payload;
+  } else {
+    // The field values are only copied if they are not in Geant4 units
+    fFieldStorage.assign(payload, payload + nofValues);
+    for (size_t i=0; i<nofValues; i++) fFieldStorage[i] *= header.fieldUnit;
+    fField = &fFieldStorage[0];
+  }
+
+  G4cout << "  [ Number of values x,y,z: " 
+	 << nx << " " << ny << " " << nz << " ] "
+	 << "\n ---> ... done mapping " << endl;
+
+  return true;
+}
+
+bool MagneticFieldMapping::WriteBinary( const char* filename ) const
+{
+  MagneticFieldMapHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, "K600FMAP", 8);
+  header.version = 1;
+  header.flags = (invertX ? kInvertX : 0) | (invertY ? kInvertY : 0) | (invertZ ? kInvertZ : 0);
+  header.nx = nx;
+  header.ny = ny;
+  header.nz = nz;
+  header.nofComponents = 4;
+  header.lengthUnit = 1.;
+  header.fieldUnit = 1.;
+  header.minx = minx;
+  header.maxx = maxx;
+  header.miny = miny;
+  header.maxy = maxy;
+  header.minz = minz;
+  header.maxz = maxz;
+
+  size_t nofValues = size_t(nx) * ny * nz * 4;
+
+  ofstream file( filename, ios::out | ios::binary );
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(fField), nofValues*sizeof(double));
+  file.close();
+
+  return !file.fail();
 }
 
 void MagneticFieldMapping::GetFieldValue(const double point[4],
@@ -151,73 +289,66 @@ void MagneticFieldMapping::GetFieldValue(const double point[4],
        y>=miny && y<=maxy && 
        z>=minz && z<=maxz ) {
     
-    // Position of given point within region, normalized to the range
-    // [0,1]
-    double xfraction = (x - minx) / dx;
-    double yfraction = (y - miny) / dy; 
-    double zfraction = (z - minz) / dz;
-
-    if (invertX) { xfraction = 1 - xfraction;}
-    if (invertY) { yfraction = 1 - yfraction;}
-    if (invertZ) { zfraction = 1 - zfraction;}
-
-    // Need addresses of these to pass to modf below.
-    // modf uses its second argument as an OUTPUT argument.
-    double xdindex, ydindex, zdindex;
+    // Position of the point in grid coordinates
+    double xgrid = (x - xOrigin) * xScale;
+    double ygrid = (y - yOrigin) * yScale;
+    double zgrid = (z - zOrigin) * zScale;
+    
+    // The indices of the nearest tabulated point whose coordinates
+    // are all less than those of the given point, a point on the upper
+    // boundary belongs to the last cell
+    int xindex = std::min(static_cast<int>(xgrid), nx-2);
+    int yindex = std::min(static_cast<int>(ygrid), ny-2);
+    int zindex = std::min(static_cast<int>(zgrid), nz-2);
     
     // Position of the point within the cuboid defined by the
     // nearest surrounding tabulated points
-    double xlocal = ( std::modf(xfraction*(nx-1), &xdindex));
-    double ylocal = ( std::modf(yfraction*(ny-1), &ydindex));
-    double zlocal = ( std::modf(zfraction*(nz-1), &zdindex));
+    double xlocal = xgrid - xindex;
+    double ylocal = ygrid - yindex;
+    double zlocal = zgrid - zindex;
     
-    // The indices of the nearest tabulated point whose coordinates
-    // are all less than those of the given point
-    int xindex = static_cast<int>(xdindex);
-    int yindex = static_cast<int>(ydindex);
-    int zindex = static_cast<int>(zdindex);
+    // The 8 corners of the cuboid and their trilinear weights
+    const double* corner = &fField[xindex*strideX + yindex*strideY + zindex*strideZ];
     
-
-#ifdef DEBUG_INTERPOLATING_FIELD
-    G4cout << "Local x,y,z: " << xlocal << " " << ylocal << " " << zlocal << endl;
-    G4cout << "Index x,y,z: " << xindex << " " << yindex << " " << zindex << endl;
-    double valx0z0, mulx0z0, valx1z0, mulx1z0;
-    double valx0z1, mulx0z1, valx1z1, mulx1z1;
-    valx0z0= table[xindex  ][0][zindex];  mulx0z0=  (1-xlocal) * (1-zlocal);
-    valx1z0= table[xindex+1][0][zindex];  mulx1z0=   xlocal    * (1-zlocal);
-    valx0z1= table[xindex  ][0][zindex+1]; mulx0z1= (1-xlocal) * zlocal;
-    valx1z1= table[xindex+1][0][zindex+1]; mulx1z1=  xlocal    * zlocal;
+    const int offset[8] = {
+      0,                 strideZ,
+      strideY,           strideY + strideZ,
+      strideX,           strideX + strideZ,
+      strideX + strideY, strideX + strideY + strideZ };
+    
+    double wx[2] = {1-xlocal, xlocal};
+    double wy[2] = {1-ylocal, ylocal};
+    double wz[2] = {1-zlocal, zlocal};
+    
+    double weight[8];
+    for (int i=0; i<8; i++) {
+      weight[i] = wx[i>>2] * wy[(i>>1)&1] * wz[i&1];
+    }
+    
+    // Full 3-dimensional version, all three components are blended at once
+#if defined(__SSE2__)
+    __m128d bxy = _mm_setzero_pd();
+    __m128d bz = _mm_setzero_pd();
+    for (int i=0; i<8; i++) {
+      const double* node = corner + offset[i];
+      __m128d w = _mm_set1_pd(weight[i]);
+      bxy = _mm_add_pd(bxy, _mm_mul_pd(w, _mm_loadu_pd(node)));
+      bz  = _mm_add_pd(bz,  _mm_mul_pd(w, _mm_loadu_pd(node+2)));
+    }
+    _mm_storeu_pd(Bfield, bxy);
+    Bfield[2] = _mm_cvtsd_f64(bz);
+#else
+    Bfield[0] = 0.0;
+    Bfield[1] = 0.0;
+    Bfield[2] = 0.0;
+    for (int i=0; i<8; i++) {
+      const double* node = corner + offset[i];
+      Bfield[0] += weight[i] * node[0];
+      Bfield[1] += weight[i] * node[1];
+      Bfield[2] += weight[i] * node[2];
+    }
 #endif
 
-        // Full 3-dimensional version
-    Bfield[0] =
-      xField[xindex  ][yindex  ][zindex  ] * (1-xlocal) * (1-ylocal) * (1-zlocal) +
-      xField[xindex  ][yindex  ][zindex+1] * (1-xlocal) * (1-ylocal) *    zlocal  +
-      xField[xindex  ][yindex+1][zindex  ] * (1-xlocal) *    ylocal  * (1-zlocal) +
-      xField[xindex  ][yindex+1][zindex+1] * (1-xlocal) *    ylocal  *    zlocal  +
-      xField[xindex+1][yindex  ][zindex  ] *    xlocal  * (1-ylocal) * (1-zlocal) +
-      xField[xindex+1][yindex  ][zindex+1] *    xlocal  * (1-ylocal) *    zlocal  +
-      xField[xindex+1][yindex+1][zindex  ] *    xlocal  *    ylocal  * (1-zlocal) +
-      xField[xindex+1][yindex+1][zindex+1] *    xlocal  *    ylocal  *    zlocal ;
-    Bfield[1] =
-      yField[xindex  ][yindex  ][zindex  ] * (1-xlocal) * (1-ylocal) * (1-zlocal) +
-      yField[xindex  ][yindex  ][zindex+1] * (1-xlocal) * (1-ylocal) *    zlocal  +
-      yField[xindex  ][yindex+1][zindex  ] * (1-xlocal) *    ylocal  * (1-zlocal) +
-      yField[xindex  ][yindex+1][zindex+1] * (1-xlocal) *    ylocal  *    zlocal  +
-      yField[xindex+1][yindex  ][zindex  ] *    xlocal  * (1-ylocal) * (1-zlocal) +
-      yField[xindex+1][yindex  ][zindex+1] *    xlocal  * (1-ylocal) *    zlocal  +
-      yField[xindex+1][yindex+1][zindex  ] *    xlocal  *    ylocal  * (1-zlocal) +
-      yField[xindex+1][yindex+1][zindex+1] *    xlocal  *    ylocal  *    zlocal ;
-    Bfield[2] =
-      zField[xindex  ][yindex  ][zindex  ] * (1-xlocal) * (1-ylocal) * (1-zlocal) +
-      zField[xindex  ][yindex  ][zindex+1] * (1-xlocal) * (1-ylocal) *    zlocal  +
-      zField[xindex  ][yindex+1][zindex  ] * (1-xlocal) *    ylocal  * (1-zlocal) +
-      zField[xindex  ][yindex+1][zindex+1] * (1-xlocal) *    ylocal  *    zlocal  +
-      zField[xindex+1][yindex  ][zindex  ] *    xlocal  * (1-ylocal) * (1-zlocal) +
-      zField[xindex+1][yindex  ][zindex+1] *    xlocal  * (1-ylocal) *    zlocal  +
-      zField[xindex+1][yindex+1][zindex  ] *    xlocal  *    ylocal  * (1-zlocal) +
-      zField[xindex+1][yindex+1][zindex+1] *    xlocal  *    ylocal  *    zlocal ;
-
   } else {
     Bfield[0] = 0.0;
     Bfield[1] = 0.0;
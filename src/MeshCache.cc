@@ -0,0 +1,351 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "MeshCache.hh"
+#include "MeshReader.hh"
+#include "CADMesh.hh"
+
+#include "G4TessellatedSolid.hh"
+#include "G4TriangularFacet.hh"
+#include "G4VFacet.hh"
+#include "G4ios.hh"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    ////    Layout of a cache file: the header, followed by the nine vertex coordinates of every triangular facet
+    const char kMeshCacheMagic[8] = {'K', '6', '0', '0', 'M', 'S', 'H', '1'};
+    
+    struct MeshCacheHeader
+    {
+        char        magic[8];
+        uint64_t    key;
+        uint64_t    nofFacets;
+    };
+    
+    ////    Version of the facets built by CADMesh, part of their cache key, to be incremented with any change to the CADMesh build used
+    const G4int kCADMeshVersion = 1;
+    
+    ////    64-bit FNV-1a hash
+    const uint64_t kFNVOffsetBasis = 14695981039346656037ULL;
+    const uint64_t kFNVPrime = 1099511628211ULL;
+    
+    uint64_t FNV1a(uint64_t hash, const void* data, size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        
+        for(size_t i=0; i<size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= kFNVPrime;
+        }
+        
+        return hash;
+    }
+    
+    ////    Read-only memory mapping of an entire file, unmapped on destruction
+    class MappedFile
+    {
+    public:
+        MappedFile(const char* fileName) : fData(0), fSize(0)
+        {
+            int fd = open(fileName, O_RDONLY);
+            if(fd<0) return;
+            
+            struct stat fileStatus;
+            if(fstat(fd, &fileStatus)==0 && fileStatus.st_size>0)
+            {
+                void* data = mmap(0, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(data!=MAP_FAILED)
+                {
+                    fData = data;
+                    fSize = fileStatus.st_size;
+                }
+            }
+            
+            close(fd);
+        }
+        
+        ~MappedFile() {if(fData) munmap(fData, fSize);}
+        
+        const void* GetData() const {return fData;}
+        size_t GetSize() const {return fSize;}
+        
+    private:
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+        
+        void*   fData;
+        size_t  fSize;
+    };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VSolid* MeshCache::TessellatedMesh(char* meshPath, char* meshType, G4double units, G4ThreeVector offset, G4bool reverse)
+{
+    MeshFacets facets;
+    LoadFacets(meshPath, meshType, units, offset, reverse, facets);
+    
+    return BuildSolid(meshPath, meshType, units, offset, reverse, facets);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MeshCache::LoadFacets(const char* meshPath, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse, MeshFacets& facets)
+{
+    MappedFile meshFile(meshPath);
+    
+    facets.isKeyValid = (meshFile.GetData()!=0);
+    if(!facets.isKeyValid) return;
+    
+    const uint64_t meshKey = ComputeKey(meshFile.GetData(), meshFile.GetSize(), meshType, units, offset, reverse);
+    
+    if(MeshReader::IsReadable(meshType))
+    {
+        facets.key = ParserKey(meshKey, "MeshReader", MeshReader::kVersion);
+        facets.isCached = ReadCache(CacheFileName(facets.key), facets.key, facets.vertices);
+        if(facets.isCached) return;
+        
+        ////    Cache miss, the mesh file is read here rather than by CADMesh on the geometry thread
+        facets.vertices.clear();
+        facets.isRead = MeshReader::Read(meshFile.GetData(), meshFile.GetSize(), meshType, units, offset, reverse, facets.vertices);
+        if(facets.isRead) return;
+        
+        std::vector<G4double>().swap(facets.vertices);
+    }
+    
+    ////    A mesh which MeshReader does not read is parsed by CADMesh, whose facets are cached under their own key
+    facets.key = ParserKey(meshKey, "CADMesh", kCADMeshVersion);
+    facets.isCached = ReadCache(CacheFileName(facets.key), facets.key, facets.vertices);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VSolid* MeshCache::BuildSolid(const char* meshPath, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse, MeshFacets& facets)
+{
+    G4VSolid* solid = 0;
+    
+    if(facets.isCached || facets.isRead)
+    {
+        G4TessellatedSolid* tessellatedSolid = new G4TessellatedSolid(meshPath);
+        
+        size_t nofFacets = facets.vertices.size()/9;
+        const G4double* vertex = nofFacets>0 ? &facets.vertices[0] : 0;
+        
+        for(size_t i=0; i<nofFacets; i++, vertex+=9)
+        {
+            tessellatedSolid->AddFacet(new G4TriangularFacet(G4ThreeVector(vertex[0], vertex[1], vertex[2]),
+                                                             G4ThreeVector(vertex[3], vertex[4], vertex[5]),
+                                                             G4ThreeVector(vertex[6], vertex[7], vertex[8]),
+                                                             ABSOLUTE));
+        }
+        
+        tessellatedSolid->SetSolidClosed(true);
+        solid = tessellatedSolid;
+        
+        ////    The facets read from the mesh file are cached for the following runs
+        if(facets.isRead) WriteCache(CacheFileName(facets.key), facets.key, facets.vertices);
+    }
+    else
+    {
+        ////    A mesh which MeshReader does not read is parsed by CADMesh, its facets are cached for the following runs
+        ////    CADMesh expects non-const strings
+        std::vector<char> path(meshPath, meshPath + strlen(meshPath) + 1);
+        std::vector<char> type(meshType, meshType + strlen(meshType) + 1);
+        
+        CADMesh* mesh = new CADMesh(&path[0], &type[0], units, offset, reverse);
+        solid = mesh->TessellatedMesh();
+        
+        if(facets.isKeyValid && solid && GetTriangularFacets(solid, facets.vertices))
+        {
+            WriteCache(CacheFileName(facets.key), facets.key, facets.vertices);
+        }
+    }
+    
+    ////    Release the facet data, the solid holds its own copy
+    std::vector<G4double>().swap(facets.vertices);
+    facets.isCached = false;
+    facets.isRead = false;
+    
+    return solid;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+uint64_t MeshCache::ComputeKey(const void* meshData, size_t meshSize, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse)
+{
+    G4double placement[4] = {units, offset.x(), offset.y(), offset.z()};
+    char orientation = reverse ? 1 : 0;
+    
+    uint64_t key = kFNVOffsetBasis;
+    key = FNV1a(key, meshData, meshSize);
+    key = FNV1a(key, meshType, strlen(meshType));
+    key = FNV1a(key, placement, sizeof(placement));
+    key = FNV1a(key, &orientation, sizeof(orientation));
+    
+    return key;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+uint64_t MeshCache::ParserKey(uint64_t meshKey, const char* parser, G4int parserVersion)
+{
+    const int32_t version = parserVersion;
+    
+    uint64_t key = FNV1a(meshKey, parser, strlen(parser));
+    key = FNV1a(key, &version, sizeof(version));
+    
+    return key;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String MeshCache::CacheDirectory()
+{
+    const char* directory = getenv("K600_MESH_CACHE");
+    
+    if(directory && directory[0]!='\0') return G4String(directory);
+    else return G4String("MeshCache");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String MeshCache::CacheFileName(uint64_t key)
+{
+    char keyName[32];
+    sprintf(keyName, "%016llx", (unsigned long long) key);
+    
+    return CacheDirectory() + "/" + keyName + ".mesh";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MeshCache::ReadCache(const G4String& cacheFileName, uint64_t key, std::vector<G4double>& vertices)
+{
+    MappedFile cacheFile(cacheFileName.c_str());
+    if(cacheFile.GetSize()<sizeof(MeshCacheHeader)) return false;
+    
+    const MeshCacheHeader* header = static_cast<const MeshCacheHeader*>(cacheFile.GetData());
+    
+    if(memcmp(header->magic, kMeshCacheMagic, sizeof(kMeshCacheMagic))!=0 || header->key!=key) return false;
+    if(cacheFile.GetSize() != sizeof(MeshCacheHeader) + header->nofFacets*9*sizeof(G4double)) return false;
+    
+    ////    The vertex data directly follows the header, which keeps it aligned within the page-aligned mapping
+    const G4double* vertex = reinterpret_cast<const G4double*>(header + 1);
+    vertices.assign(vertex, vertex + header->nofFacets*9);
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MeshCache::GetTriangularFacets(const G4VSolid* solid, std::vector<G4double>& vertices)
+{
+    const G4TessellatedSolid* tessellatedSolid = dynamic_cast<const G4TessellatedSolid*>(solid);
+    if(!tessellatedSolid) return false;
+    
+    G4int nofFacets = tessellatedSolid->GetNumberOfFacets();
+    
+    vertices.clear();
+    vertices.reserve(nofFacets*9);
+    
+    for(G4int i=0; i<nofFacets; i++)
+    {
+        const G4VFacet* facet = tessellatedSolid->GetFacet(i);
+        
+        ////    Only triangular facets are cached, any other mesh is left to CADMesh
+        if(facet->GetNumberOfVertices()!=3) return false;
+        
+        for(G4int j=0; j<3; j++)
+        {
+            G4ThreeVector v = facet->GetVertex(j);
+            vertices.push_back(v.x());
+            vertices.push_back(v.y());
+            vertices.push_back(v.z());
+        }
+    }
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MeshCache::WriteCache(const G4String& cacheFileName, uint64_t key, const std::vector<G4double>& vertices)
+{
+    const uint64_t nofFacets = vertices.size()/9;
+    
+    MeshCacheHeader header;
+    memcpy(header.magic, kMeshCacheMagic, sizeof(kMeshCacheMagic));
+    header.key = key;
+    header.nofFacets = nofFacets;
+    
+    ////    The cache file is written under a temporary name and renamed into place, such that concurrent jobs sharing a cache directory never read a partially written file
+    mkdir(CacheDirectory().c_str(), 0755);
+    
+    char suffix[32];
+    sprintf(suffix, ".%d.tmp", (int) getpid());
+    G4String temporaryFileName = cacheFileName + suffix;
+    
+    FILE* file = fopen(temporaryFileName.c_str(), "wb");
+    if(!file) return;
+    
+    G4bool isWritten = (fwrite(&header, sizeof(header), 1, file)==1);
+    if(isWritten && !vertices.empty()) isWritten = (fwrite(&vertices[0], sizeof(G4double), vertices.size(), file)==vertices.size());
+    if(fclose(file)!=0) isWritten = false;
+    
+    if(isWritten && rename(temporaryFileName.c_str(), cacheFileName.c_str())==0)
+    {
+        G4cout << "MeshCache: cached " << (unsigned long long) nofFacets << " facets in " << cacheFileName << G4endl;
+    }
+    else
+    {
+        remove(temporaryFileName.c_str());
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
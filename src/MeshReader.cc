@@ -0,0 +1,471 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+
+#include "MeshReader.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sstream>
+
+namespace
+{
+    ////    Case insensitive comparison of the mesh type
+    G4bool IsMeshType(const char* meshType, const char* name)
+    {
+        size_t length = strlen(name);
+        if(strlen(meshType)!=length) return false;
+        
+        for(size_t i=0; i<length; i++)
+        {
+            if(toupper((unsigned char) meshType[i])!=name[i]) return false;
+        }
+        
+        return true;
+    }
+    
+    G4bool IsLittleEndian()
+    {
+        const unsigned short one = 1;
+        return *reinterpret_cast<const unsigned char*>(&one)==1;
+    }
+    
+    ////    Scalar types of the PLY format
+    enum PLYType {kPLYInvalid, kPLYInt8, kPLYUInt8, kPLYInt16, kPLYUInt16, kPLYInt32, kPLYUInt32, kPLYFloat32, kPLYFloat64};
+    
+    PLYType ParsePLYType(const std::string& name)
+    {
+        if(name=="char" || name=="int8") return kPLYInt8;
+        if(name=="uchar" || name=="uint8") return kPLYUInt8;
+        if(name=="short" || name=="int16") return kPLYInt16;
+        if(name=="ushort" || name=="uint16") return kPLYUInt16;
+        if(name=="int" || name=="int32") return kPLYInt32;
+        if(name=="uint" || name=="uint32") return kPLYUInt32;
+        if(name=="float" || name=="float32") return kPLYFloat32;
+        if(name=="double" || name=="float64") return kPLYFloat64;
+        return kPLYInvalid;
+    }
+    
+    size_t PLYTypeSize(PLYType type)
+    {
+        switch(type)
+        {
+            case kPLYInt8: case kPLYUInt8: return 1;
+            case kPLYInt16: case kPLYUInt16: return 2;
+            case kPLYInt32: case kPLYUInt32: case kPLYFloat32: return 4;
+            case kPLYFloat64: return 8;
+            default: return 0;
+        }
+    }
+    
+    struct PLYProperty
+    {
+        std::string name;
+        PLYType     type;
+        PLYType     countType;  // kPLYInvalid for a scalar property
+    };
+    
+    struct PLYElement
+    {
+        std::string                 name;
+        size_t                      count;
+        std::vector<PLYProperty>    properties;
+    };
+    
+    ////    Sequential reader of the values of the PLY body, ASCII or binary of either byte order
+    class PLYBody
+    {
+    public:
+        PLYBody(const char* begin, const char* end, G4bool isASCII, G4bool isSwapped)
+        : fPosition(begin), fEnd(end), fIsASCII(isASCII), fIsSwapped(isSwapped)
+        {
+            ////    strtod needs a terminated string
+            if(fIsASCII)
+            {
+                fText.assign(begin, end);
+                fPosition = fText.c_str();
+                fEnd = fPosition + fText.size();
+            }
+        }
+        
+        G4bool Read(PLYType type, G4double& value)
+        {
+            if(fIsASCII)
+            {
+                char* next = 0;
+                value = strtod(fPosition, &next);
+                if(next==fPosition) return false;
+                
+                fPosition = next;
+                return true;
+            }
+            
+            size_t size = PLYTypeSize(type);
+            if(size==0 || size_t(fEnd - fPosition)<size) return false;
+            
+            unsigned char bytes[8];
+            memcpy(bytes, fPosition, size);
+            fPosition += size;
+            
+            if(fIsSwapped)
+            {
+                for(size_t i=0; i<size/2; i++) std::swap(bytes[i], bytes[size-1-i]);
+            }
+            
+            switch(type)
+            {
+                case kPLYInt8:      {signed char v; memcpy(&v, bytes, 1); value = v; break;}
+                case kPLYUInt8:     {unsigned char v; memcpy(&v, bytes, 1); value = v; break;}
+                case kPLYInt16:     {short v; memcpy(&v, bytes, 2); value = v; break;}
+                case kPLYUInt16:    {unsigned short v; memcpy(&v, bytes, 2); value = v; break;}
+                case kPLYInt32:     {int v; memcpy(&v, bytes, 4); value = v; break;}
+                case kPLYUInt32:    {unsigned int v; memcpy(&v, bytes, 4); value = v; break;}
+                case kPLYFloat32:   {float v; memcpy(&v, bytes, 4); value = v; break;}
+                case kPLYFloat64:   {double v; memcpy(&v, bytes, 8); value = v; break;}
+                default: return false;
+            }
+            
+            return true;
+        }
+        
+    private:
+        const char* fPosition;
+        const char* fEnd;
+        G4bool      fIsASCII;
+        G4bool      fIsSwapped;
+        std::string fText;
+    };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MeshReader::IsReadable(const char* meshType)
+{
+    return IsMeshType(meshType, "PLY") || IsMeshType(meshType, "STL");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MeshReader::Read(const void* data, size_t size, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse, std::vector<G4double>& vertices)
+{
+    if(!data) return false;
+    
+    std::vector<G4double> points;
+    std::vector<size_t> triangles;
+    
+    G4bool isRead = false;
+    if(IsMeshType(meshType, "PLY")) isRead = ReadPLY(static_cast<const char*>(data), size, points, triangles);
+    else if(IsMeshType(meshType, "STL")) isRead = ReadSTL(static_cast<const char*>(data), size, points, triangles);
+    
+    if(!isRead || triangles.empty()) return false;
+    
+    ////    The facets as placed by CADMesh
+    const size_t nofPoints = points.size()/3;
+    const G4double shift[3] = {offset.x(), offset.y(), offset.z()};
+    
+    vertices.reserve(vertices.size() + triangles.size()*3);
+    
+    for(size_t i=0; i<triangles.size(); i+=3)
+    {
+        size_t corner[3] = {triangles[i], triangles[i+1], triangles[i+2]};
+        if(reverse) std::swap(corner[0], corner[1]);
+        
+        for(G4int j=0; j<3; j++)
+        {
+            if(corner[j]>=nofPoints) return false;
+            
+            for(G4int k=0; k<3; k++) vertices.push_back(points[3*corner[j] + k]*units - shift[k]);
+        }
+    }
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MeshReader::ReadPLY(const char* data, size_t size, std::vector<G4double>& points, std::vector<size_t>& triangles)
+{
+    ////    The header, up to and including the end_header line
+    const char* const endHeaderTag = "end_header";
+    const char* headerEnd = 0;
+    
+    for(const char* line = data; line<data+size; )
+    {
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', data + size - line));
+        if(!lineEnd) return false;
+        
+        if(size_t(lineEnd - line)>=strlen(endHeaderTag) && strncmp(line, endHeaderTag, strlen(endHeaderTag))==0)
+        {
+            headerEnd = lineEnd + 1;
+            break;
+        }
+        
+        line = lineEnd + 1;
+    }
+    
+    if(!headerEnd || size<4 || strncmp(data, "ply", 3)!=0) return false;
+    
+    std::istringstream header(std::string(data, headerEnd));
+    std::string line;
+    std::getline(header, line);
+    
+    G4bool isASCII = false, isSwapped = false;
+    G4bool hasFormat = false;
+    std::vector<PLYElement> elements;
+    
+    while(std::getline(header, line))
+    {
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+        
+        if(keyword=="format")
+        {
+            std::string format;
+            words >> format;
+            
+            if(format=="ascii") isASCII = true;
+            else if(format=="binary_little_endian") isSwapped = !IsLittleEndian();
+            else if(format=="binary_big_endian") isSwapped = IsLittleEndian();
+            else return false;
+            
+            hasFormat = true;
+        }
+        else if(keyword=="element")
+        {
+            PLYElement element;
+            if(!(words >> element.name >> element.count)) return false;
+            
+            elements.push_back(element);
+        }
+        else if(keyword=="property")
+        {
+            if(elements.empty()) return false;
+            
+            PLYProperty property;
+            std::string type;
+            words >> type;
+            
+            if(type=="list")
+            {
+                std::string countType, itemType;
+                words >> countType >> itemType >> property.name;
+                
+                property.countType = ParsePLYType(countType);
+                property.type = ParsePLYType(itemType);
+                if(property.countType==kPLYInvalid) return false;
+            }
+            else
+            {
+                words >> property.name;
+                
+                property.countType = kPLYInvalid;
+                property.type = ParsePLYType(type);
+            }
+            
+            if(property.type==kPLYInvalid) return false;
+            
+            elements.back().properties.push_back(property);
+        }
+    }
+    
+    if(!hasFormat) return false;
+    
+    ////    The body, element by element
+    PLYBody body(headerEnd, data + size, isASCII, isSwapped);
+    std::vector<G4double> values;
+    
+    for(size_t e=0; e<elements.size(); e++)
+    {
+        const PLYElement& element = elements[e];
+        const G4bool isVertex = (element.name=="vertex");
+        const G4bool isFace = (element.name=="face");
+        
+        ////    Index of the x, y and z properties of a vertex
+        G4int coordinate[3] = {-1, -1, -1};
+        G4int faceIndices = -1;
+        
+        for(size_t p=0; p<element.properties.size(); p++)
+        {
+            const PLYProperty& property = element.properties[p];
+            
+            if(isVertex && property.countType==kPLYInvalid)
+            {
+                if(property.name=="x") coordinate[0] = G4int(p);
+                else if(property.name=="y") coordinate[1] = G4int(p);
+                else if(property.name=="z") coordinate[2] = G4int(p);
+            }
+            else if(isFace && property.countType!=kPLYInvalid && (property.name=="vertex_indices" || property.name=="vertex_index"))
+            {
+                faceIndices = G4int(p);
+            }
+        }
+        
+        if(isVertex && (coordinate[0]<0 || coordinate[1]<0 || coordinate[2]<0)) return false;
+        if(isFace && faceIndices<0) return false;
+        
+        if(isVertex) points.reserve(points.size() + 3*element.count);
+        if(isFace) triangles.reserve(triangles.size() + 3*element.count);
+        
+        for(size_t i=0; i<element.count; i++)
+        {
+            G4double point[3] = {0., 0., 0.};
+            
+            for(size_t p=0; p<element.properties.size(); p++)
+            {
+                const PLYProperty& property = element.properties[p];
+                G4double value;
+                
+                if(property.countType==kPLYInvalid)
+                {
+                    if(!body.Read(property.type, value)) return false;
+                    
+                    for(G4int k=0; k<3; k++) if(coordinate[k]==G4int(p)) point[k] = value;
+                    continue;
+                }
+                
+                G4double count;
+                if(!body.Read(property.countType, count) || count<0.) return false;
+                
+                values.resize(size_t(count));
+                for(size_t j=0; j<values.size(); j++)
+                {
+                    if(!body.Read(property.type, values[j])) return false;
+                }
+                
+                ////    Polygons are split into triangle fans
+                if(G4int(p)==faceIndices)
+                {
+                    for(size_t j=0; j<values.size(); j++) if(values[j]<0.) return false;
+                    
+                    for(size_t j=2; j<values.size(); j++)
+                    {
+                        triangles.push_back(size_t(values[0]));
+                        triangles.push_back(size_t(values[j-1]));
+                        triangles.push_back(size_t(values[j]));
+                    }
+                }
+            }
+            
+            if(isVertex) points.insert(points.end(), point, point + 3);
+        }
+    }
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MeshReader::ReadSTL(const char* data, size_t size, std::vector<G4double>& points, std::vector<size_t>& triangles)
+{
+    ////    A binary STL: an 80 byte header, the number of triangles and 50 bytes per triangle
+    if(size>=84)
+    {
+        unsigned char countBytes[4];
+        memcpy(countBytes, data + 80, 4);
+        
+        const size_t nofTriangles = size_t(countBytes[0]) | size_t(countBytes[1])<<8 | size_t(countBytes[2])<<16 | size_t(countBytes[3])<<24;
+        
+        if(size==84 + 50*nofTriangles)
+        {
+            PLYBody body(data + 84, data + size, false, !IsLittleEndian());
+            
+            points.reserve(9*nofTriangles);
+            triangles.reserve(3*nofTriangles);
+            
+            for(size_t i=0; i<nofTriangles; i++)
+            {
+                ////    The normal is recomputed by G4TriangularFacet
+                G4double value;
+                for(G4int k=0; k<3; k++) body.Read(kPLYFloat32, value);
+                
+                for(G4int j=0; j<3; j++)
+                {
+                    triangles.push_back(points.size()/3);
+                    
+                    for(G4int k=0; k<3; k++)
+                    {
+                        body.Read(kPLYFloat32, value);
+                        points.push_back(value);
+                    }
+                }
+                
+                body.Read(kPLYUInt16, value);
+            }
+            
+            return true;
+        }
+    }
+    
+    ////    An ASCII STL, the vertices of every loop are split into a triangle fan
+    if(size<5 || strncmp(data, "solid", 5)!=0) return false;
+    
+    std::istringstream text(std::string(data, size));
+    std::string word;
+    size_t loopStart = 0;
+    
+    while(text >> word)
+    {
+        if(word=="outer")
+        {
+            loopStart = points.size()/3;
+        }
+        else if(word=="vertex")
+        {
+            G4double point[3];
+            if(!(text >> point[0] >> point[1] >> point[2])) return false;
+            
+            points.insert(points.end(), point, point + 3);
+        }
+        else if(word=="endloop")
+        {
+            for(size_t j=loopStart+2; j<points.size()/3; j++)
+            {
+                triangles.push_back(loopStart);
+                triangles.push_back(j-1);
+                triangles.push_back(j);
+            }
+        }
+    }
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
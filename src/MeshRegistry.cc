@@ -0,0 +1,200 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "MeshRegistry.hh"
+#include "G4AutoLock.hh"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+    G4Mutex meshRegistryMutex = G4MUTEX_INITIALIZER;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MeshRegistry::MeshRegistry()
+: fNextPending(0)
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MeshRegistry::~MeshRegistry()
+{
+    ////    The solids themselves are owned by the G4SolidStore
+    for(size_t i=0; i<fEntries.size(); i++)
+    {
+        delete fEntries[i];
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int MeshRegistry::Request(const char* meshPath, const char* meshType, G4double units, const G4ThreeVector& offset, G4bool reverse)
+{
+    std::ostringstream key;
+    key.precision(17);
+    key << meshPath << '\n' << meshType << '\n' << units << ' ' << offset.x() << ' ' << offset.y() << ' ' << offset.z() << ' ' << reverse;
+    
+    std::map<G4String, G4int>::const_iterator it = fEntryIDs.find(key.str());
+    if(it != fEntryIDs.end()) return it->second;
+    
+    MeshEntry* entry = new MeshEntry;
+    entry->path = meshPath;
+    entry->type = meshType;
+    entry->units = units;
+    entry->offset = offset;
+    entry->reverse = reverse;
+    entry->isLoaded = false;
+    entry->solid = 0;
+    
+    G4int meshID = G4int(fEntries.size());
+    
+    fEntries.push_back(entry);
+    fEntryIDs[key.str()] = meshID;
+    fPending.push_back(meshID);
+    
+    return meshID;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MeshRegistry::Load()
+{
+    if(fPending.empty()) return;
+    
+    ////    The largest mesh files are loaded first, such that the loading time is bounded by the largest mesh
+    std::vector< std::pair<off_t, G4int> > pendingBySize;
+    
+    for(size_t i=0; i<fPending.size(); i++)
+    {
+        struct stat fileStatus;
+        off_t fileSize = (stat(fEntries[fPending[i]]->path.c_str(), &fileStatus)==0) ? fileStatus.st_size : 0;
+        
+        pendingBySize.push_back(std::make_pair(fileSize, fPending[i]));
+    }
+    
+    std::sort(pendingBySize.begin(), pendingBySize.end(), std::greater< std::pair<off_t, G4int> >());
+    
+    for(size_t i=0; i<pendingBySize.size(); i++)
+    {
+        fPending[i] = pendingBySize[i].second;
+    }
+    
+    fNextPending = 0;
+    
+#ifdef G4MULTITHREADED
+    G4int nofWorkers = std::min(G4Threading::G4GetNumberOfCores(), G4int(fPending.size()));
+    std::vector<G4Thread> workers(nofWorkers);
+    
+    for(G4int i=0; i<nofWorkers; i++)
+    {
+        G4THREADCREATE(&workers[i], &MeshRegistry::LoadWorker, this);
+    }
+    
+    for(G4int i=0; i<nofWorkers; i++)
+    {
+        G4THREADJOIN(workers[i]);
+    }
+#else
+    LoadWorker(this);
+#endif
+    
+    fPending.clear();
+    fNextPending = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreadFunReturnType MeshRegistry::LoadWorker(G4ThreadFunArgType registry)
+{
+    MeshRegistry* meshRegistry = static_cast<MeshRegistry*>(registry);
+    
+    while(true)
+    {
+        MeshEntry* entry = 0;
+        
+        {
+            G4AutoLock lock(&meshRegistryMutex);
+            
+            if(meshRegistry->fNextPending < meshRegistry->fPending.size())
+            {
+                entry = meshRegistry->fEntries[meshRegistry->fPending[meshRegistry->fNextPending++]];
+            }
+        }
+        
+        if(!entry) break;
+        
+        ////    The facets are read from the cache or parsed from the mesh file here, the Geant4 solids are assembled by GetSolid() on the calling thread
+        if(!entry->isLoaded)
+        {
+            MeshCache::LoadFacets(entry->path.c_str(), entry->type.c_str(), entry->units, entry->offset, entry->reverse, entry->facets);
+            entry->isLoaded = true;
+        }
+    }
+    
+    return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VSolid* MeshRegistry::GetSolid(G4int meshID)
+{
+    MeshEntry* entry = fEntries[meshID];
+    
+    if(!entry->solid)
+    {
+        if(!entry->isLoaded)
+        {
+            MeshCache::LoadFacets(entry->path.c_str(), entry->type.c_str(), entry->units, entry->offset, entry->reverse, entry->facets);
+            entry->isLoaded = true;
+        }
+        
+        entry->solid = MeshCache::BuildSolid(entry->path.c_str(), entry->type.c_str(), entry->units, entry->offset, entry->reverse, entry->facets);
+    }
+    
+    return entry->solid;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
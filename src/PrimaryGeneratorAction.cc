@@ -35,519 +35,542 @@
 //
 
 #include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "PrimaryVertexFile.hh"
+#include "PrimaryVertexWeight.hh"
+#include "RandomSeeding.hh"
 
 #include "G4RunManager.hh"
-#include "G4LogicalVolumeStore.hh"
-#include "G4LogicalVolume.hh"
-#include "G4Box.hh"
+#include "G4Run.hh"
 #include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
 #include "G4ParticleGun.hh"
 
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
 #include "Randomize.hh"
+#include "G4Poisson.hh"
 #include "G4ThreeVector.hh"
 
 #include "G4IonTable.hh"
 
 #include "BiRelKin.hh"
+#include "ReactionKinematicsCache.hh"
+#include "EfficiencyCurve.hh"
+#include "ResponseMatrix.hh"
+
+#include <algorithm>
 
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorSettings::PrimaryGeneratorSettings()
+: mode(kGunMode),
+direction(kIsotropicDirection), energySigma(0.), targetThickness(0.), timeSigma(0.), biasingFraction(0.9),
+bunchMode(Activate_CyclotronBeam_Timing), particlesPerBunch(Particles_per_Bunch), rfPeriod(CyclotronBeam_RFPeriod*ns), bunchesPerEvent(CyclotronBeam_BunchesPerEvent),
+ejectileZ(2), ejectileA(4), recoilZ(8), recoilA(16),
+beamEnergySigma(0.), excitation(12.049*MeV), excitationFWHM(0.012*MeV), thetaMin(-2.*deg), thetaMax(2.*deg),
+emitEjectile(true), emitRecoil(false), decayRecoil(false),
+parentExcitation(12.049*MeV), separationEnergy(7.16192*MeV), emittedZ(2), emittedA(4), daughterZ(6), daughterA(12),
+emitDaughter(false), emitGamma(true),
+inputFileName("K600Primaries.PVTX"), inputFirstEvent(0)
+{
+    ////    PR226: 16O(a, a')
+    masses[0] = 4.002603; // u
+    masses[1] = 15.99491; // u
+    masses[2] = 4.002603; // u
+    masses[3] = 15.99491; // u
+    
+    beamEnergies.push_back(200.*MeV);
+    
+    ////    16O -> 4He + 12C, to the ground state and to the 4.43891 MeV state of 12C
+    daughterExcitations.push_back(0.*MeV);
+    daughterWeights.push_back(0.5);
+    daughterExcitations.push_back(4.43891*MeV);
+    daughterWeights.push_back(0.5);
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 PrimaryGeneratorAction::PrimaryGeneratorAction()
 : G4VUserPrimaryGeneratorAction(),
-fParticleGun(0)
+fParticleGun(0),
+fMessenger(0),
+fEjectile(0), fRecoil(0), fEmitted(0), fDaughter(0),
+fDetector(0),
+fInputFile(0), fEndOfInputReported(false)
 {
-    ///////////////////////////////////////////////////////////////
-    //          To generate radioactive decay - enabled particles
-    ///////////////////////////////////////////////////////////////
-    
     G4int n_particle = 1;
     fParticleGun  = new G4ParticleGun(n_particle);
     
-    //G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("He3");
+    ////    The default source, an isotropic 4.5 MeV neutron from the origin
     G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("neutron");
-    //G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("mu-");
-    //G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("gamma");
-    //G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("e-");
-    //G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("alpha");
-    //G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("proton");
-    //G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("geantino");
-
     fParticleGun->SetParticleDefinition(particleDefinition);
-    
-    //fParticleGun->SetParticleEnergy(0.*MeV);
-    //fParticleGun->SetParticleEnergy(0.100*MeV);
-    //fParticleGun->SetParticleEnergy(1.332*MeV);
     fParticleGun->SetParticleEnergy(4.5*MeV);
-    
-    //fParticleGun->SetParticleEnergy(200.*MeV);
-    //fParticleGun->SetParticleEnergy(22.5*MeV);
-    //fParticleGun->SetParticleEnergy(50.0*MeV);
-    //fParticleGun->SetParticleEnergy(4*GeV);
-    //fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));
-    
-    
-    //fParticleGun->SetParticlePosition(G4ThreeVector(0.,0.*m,1.90*m));
-    //fParticleGun->SetParticlePosition(G4ThreeVector(0.,57.5*mm,1.6*m));
-    //fParticleGun->SetParticlePosition(G4ThreeVector(0.,0.,0.));
-    //fParticleGun->SetParticlePosition(G4ThreeVector(0.,57.5*mm,2.10*m));
-    
     fParticleGun->SetParticlePosition(G4ThreeVector(0.,0.,0.));
-    //fParticleGun->SetParticlePosition(G4ThreeVector(0.,0.,-1.*mm));
-    //fParticleGun->SetParticlePosition(G4ThreeVector(2000.*mm,0.,3000.0*mm));
-    
-    //fParticleGun->SetParticlePosition(G4ThreeVector(-3.*m, 0., -3.8*m));
-    
-    
-    /*
-    ////////    4He, +1 charge
-    G4int Z = 6, A = 12;
-    //G4int Z = 2, A = 4;
-
-    //G4double ionCharge   = 1.*eplus;
-    G4double ionCharge   = 0.*eplus;
-    G4double excitEnergy = 12.049*MeV;
-     
-    //G4ParticleDefinition* ion = G4ParticleTable::GetParticleTable()->GetIon(Z,A,excitEnergy);
-    G4ParticleDefinition* ion = G4IonTable::GetIonTable()->GetIon(Z,A,excitEnergy);
-    //ion->SetPDGLifeTime(1*ns);
-    fParticleGun->SetParticleDefinition(ion);
-    fParticleGun->SetParticleCharge(ionCharge);
-    */
+    
+    fMessenger = new PrimaryGeneratorMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
+    delete fMessenger;
     delete fParticleGun;
+    delete fInputFile;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
+void PrimaryGeneratorAction::ResetCaches()
 {
-    ////    Different particles for Visualisation
-    /*
-    double test = G4UniformRand();
-    
-    G4ParticleDefinition* particleDefinitionNew;
-    if(test<0.3) particleDefinitionNew = G4ParticleTable::GetParticleTable()->FindParticle("alpha");
-    if(test>=0.3 && test<0.6) particleDefinitionNew = G4ParticleTable::GetParticleTable()->FindParticle("e-");
-    if(test>=0.6 && test<=1.0) particleDefinitionNew = G4ParticleTable::GetParticleTable()->FindParticle("gamma");
-    fParticleGun->SetParticleDefinition(particleDefinitionNew);
-    */
-    
-    ///////////////////////////////////////////////////////////////
-    //          To generate radioactive decay - enabled particles
-    ///////////////////////////////////////////////////////////////
-    
-    /*
-    //G4int Z = 3, A = 11;
-    //G4int Z = 6, A = 21;
-    //G4int Z = 10, A = 18;
-    //G4int Z = 11, A = 22;
-    //G4int Z = 27, A = 60;
-    G4int Z = 8, A = 16;
-    //G4int Z = 63, A = 152;
-     
-    G4double ionCharge   = 0.*eplus;
-    G4double excitEnergy = 12.049*MeV;
-     
-    //G4ParticleDefinition* ion = G4ParticleTable::GetParticleTable()->GetIon(Z,A,excitEnergy);
-    G4ParticleDefinition* ion = G4IonTable::GetIonTable()->GetIon(Z,A,excitEnergy);
-    //ion->SetPDGLifeTime(1*ns);
-    ion->SetPDGLifeTime(0.5485101634774202e-10*ns);
-    fParticleGun->SetParticleDefinition(ion);
-    fParticleGun->SetParticleCharge(ionCharge);
-    */
-
+    fKinematicsTables.clear();
     
-    ///////////////////////////////////////////////////////////
-    //       Initial Position Distribution of Particle
-    ///////////////////////////////////////////////////////////
-    /*
-    G4double targetZoffset = -1000.0; // um
-    G4double targetThickness = 2.42; // um
-    G4double InitialPosition = G4RandFlat::shoot(-(targetThickness/2) + targetZoffset, (targetThickness/2) + targetZoffset); // um
-    */
+    fEjectile = 0;
+    fRecoil = 0;
+    fEmitted = 0;
+    fDaughter = 0;
     
-    ///////////////////////////////////////////////////////////
-    //       Initial Momentum Direction Distribution of Particle
-    ///////////////////////////////////////////////////////////
-    
-    G4double theta = 2*M_PI*G4UniformRand();
-    G4double mz = -1.0 + 2*G4UniformRand();
-    //G4double mz = -1.0 + G4UniformRand();
-    
-    G4double a = sqrt(1-(mz*mz));
-    
-    mx = a*cos(theta);
-    my = a*sin(theta);
-    
-    fParticleGun->SetParticleMomentumDirection(G4ThreeVector(mx, my, mz));
+    delete fInputFile;
+    fInputFile = 0;
+    fEndOfInputReported = false;
+}
 
-    
-    ///////////////////////////////////////////////////
-    //       Initial Energy Distribution of Particle
-    ///////////////////////////////////////////////////
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-    G4double InitialEnergy = G4RandGauss::shoot(4.5, 0.1);
-    //G4double InitialEnergy = ((12.049-7.16192)*(0.75)); // MeV
+void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
+{
+    ////    The primaries are the first to draw random numbers within an event, the engine is reseeded for the event beforehand
+    RandomSeeding::SeedEvent(G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID(), anEvent->GetEventID());
     
-    //  Empirical
-    //G4double InitialEnergy = G4RandGauss::shoot(2.96058e+00, ((1.5e-3)/2.3548));
+    ////    Only the particle gun fires the energies of the efficiency curves, which would otherwise be meaningless
+    if(EfficiencyCurve::IsActive() && fSettings.mode != kGunMode)
+    {
+        G4ExceptionDescription msg;
+        msg << "The efficiency curves (/K600/efficiency/) are measured with the gamma-ray energies fired by the particle gun, select its mode with /K600/gun/mode gun.";
+        G4Exception("PrimaryGeneratorAction::GeneratePrimaries()", "K600Efficiency001", FatalException, msg);
+    }
     
-    //fParticleGun->SetParticleEnergy(InitialEnergy*MeV);
-
+    ////    Likewise for the incident energies of the response matrices, which replace those of the efficiency curves
+    if(ResponseMatrix::IsActive() && (fSettings.mode != kGunMode || EfficiencyCurve::IsActive()))
+    {
+        G4ExceptionDescription msg;
+        msg << "The response matrices (/K600/response/) are generated with the incident energies fired by the particle gun, select its mode with /K600/gun/mode gun and clear the efficiency curve energies with /K600/efficiency/energies none.";
+        G4Exception("PrimaryGeneratorAction::GeneratePrimaries()", "K600Response001", FatalException, msg);
+    }
     
-    ////////////////////////
-    ////    BiRelKin
-    /*
-    double m[4], T[4], E[4], p[4];
-    double ThSCAT, ThSCAT_Recoil, Ex, Phi;
-    G4double mx, my, mz;
+    if(fSettings.mode == kFileMode)
+    {
+        GenerateFromFile(anEvent);
+        return;
+    }
     
-    for(G4int i=0; i<4; i++)
+    ////    The nominal values of the particle gun, restored after the event
+    G4ParticleDefinition* nominalParticle = fParticleGun->GetParticleDefinition();
+    G4double nominalCharge = fParticleGun->GetParticleCharge();
+    G4double nominalEnergy = fParticleGun->GetParticleEnergy();
+    G4ThreeVector nominalDirection = fParticleGun->GetParticleMomentumDirection();
+    G4ThreeVector nominalPosition = fParticleGun->GetParticlePosition();
+    G4double nominalTime = fParticleGun->GetParticleTime();
+    
+    ////////////////////////////////////////////////////////////////
+    //       Cyclotron Bunches, all vertices within a single event
+    ////////////////////////////////////////////////////////////////
+    
+    G4int numberOfBunches = 1;
+    if(fSettings.bunchMode) numberOfBunches = fSettings.bunchesPerEvent;
+    
+    ////    The incident energies of the response matrices, or the gamma-ray energies of the efficiency curves,
+    ////    are interleaved over the events, see ResponseMatrix.hh and EfficiencyCurve.hh
+    G4double eventEnergy = nominalEnergy;
+    if(fSettings.mode == kGunMode && ResponseMatrix::IsActive())
     {
-        T[i] = 0.0;
-        E[i] = 0.0;
-        p[i] = 0.0;
+        eventEnergy = ResponseMatrix::GenerateIncidentEnergy(anEvent->GetEventID());
+    }
+    else if(fSettings.mode == kGunMode && EfficiencyCurve::IsActive())
+    {
+        eventEnergy = EfficiencyCurve::GetEnergy(EfficiencyCurve::GetEnergyIndex(anEvent->GetEventID()));
     }
     
-    ////	PR226: 16O(a, a')
-    m[0] = 4.002603; // u
-    m[1] = 15.99491; // u
-    m[2] = 4.002603; // u
-    m[3] = 15.99491; // u
+    for(G4int bunch=0; bunch<numberOfBunches; bunch++)
+    {
+        G4int numberOfVertices = 1;
+        G4double bunchTime = nominalTime;
+        
+        if(fSettings.bunchMode)
+        {
+            ////    The bunches are centred within their RF periods, such that the jittered times remain positive
+            numberOfVertices = G4Poisson(fSettings.particlesPerBunch);
+            bunchTime += (bunch + 0.5)*fSettings.rfPeriod;
+        }
+        
+        for(G4int vertex=0; vertex<numberOfVertices; vertex++)
+        {
+            ///////////////////////////////////////////////////////////
+            //       Initial Position and Time of the Vertex
+            ///////////////////////////////////////////////////////////
+            
+            if(fSettings.targetThickness > 0.)
+            {
+                G4double z = G4RandFlat::shoot(-fSettings.targetThickness/2, fSettings.targetThickness/2);
+                fParticleGun->SetParticlePosition(nominalPosition + G4ThreeVector(0., 0., z));
+            }
+            
+            G4double time = bunchTime;
+            if(fSettings.timeSigma > 0.) time += G4RandGauss::shoot(0., fSettings.timeSigma);
+            fParticleGun->SetParticleTime(time);
+            
+            switch(fSettings.mode)
+            {
+                case kGunMode:
+                    fParticleGun->SetParticleEnergy(eventEnergy);
+                    GenerateGun(anEvent);
+                    break;
+                    
+                case kReactionMode:
+                    GenerateReaction(anEvent);
+                    break;
+                    
+                case kDecayMode:
+                    ////    The decaying nucleus at rest, its mass only enters through the boost
+                    GenerateDecay(anEvent, fSettings.parentExcitation, G4LorentzVector(0., 0., 0., 1.));
+                    break;
+            }
+            
+            ////    The particle, energy and direction of the gun are reset for the next vertex
+            fParticleGun->SetParticleDefinition(nominalParticle);
+            fParticleGun->SetParticleCharge(nominalCharge);
+            fParticleGun->SetParticleEnergy(nominalEnergy);
+            fParticleGun->SetParticleMomentumDirection(nominalDirection);
+        }
+    }
     
-    ////    Projectile Energy
-    T[0] = 200.; // MeV
+    fParticleGun->SetParticlePosition(nominalPosition);
+    fParticleGun->SetParticleTime(nominalTime);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::GenerateGun(G4Event* anEvent)
+{
+    ///////////////////////////////////////////////////////////
+    //       Initial Momentum Direction Distribution of Particle
+    ///////////////////////////////////////////////////////////
     
-    ////    Ejectile Energy
-    T[1] = 0.0; // MeV
+    G4double weight = 1.;
     
+    if(fSettings.direction == kBiasedDirection)
+    {
+        fParticleGun->SetParticleMomentumDirection(BiasedDirection(fParticleGun->GetParticlePosition(), weight));
+    }
+    else if(fSettings.direction != kFixedDirection)
+    {
+        G4double theta = 2*M_PI*G4UniformRand();
+        G4double mz = 0.;
+        
+        if(fSettings.direction == kIsotropicDirection) mz = -1.0 + 2*G4UniformRand();
+        if(fSettings.direction == kForwardHemisphere) mz = G4UniformRand();
+        if(fSettings.direction == kBackwardHemisphere) mz = -1.0 + G4UniformRand();
+        
+        G4double a = sqrt(1-(mz*mz));
+        
+        fParticleGun->SetParticleMomentumDirection(G4ThreeVector(a*cos(theta), a*sin(theta), mz));
+    }
     
-    ////    Uniformly distributed ThSCAT
-    ThSCAT = G4RandFlat::shoot( -2., 2.); // deg
+    ///////////////////////////////////////////////////
+    //       Initial Energy Distribution of Particle
+    ///////////////////////////////////////////////////
     
+    if(fSettings.energySigma > 0.)
+    {
+        G4double energy = G4RandGauss::shoot(fParticleGun->GetParticleEnergy(), fSettings.energySigma);
+        fParticleGun->SetParticleEnergy(std::max(energy, 0.));
+    }
     
-    ////    Gaussian distributed ThSCAT
-    //ThSCAT = 2.1;
-    //while(pow(ThSCAT*ThSCAT, 0.5)>2.)
-    //{
-    //    ThSCAT = G4RandGauss::shoot(0., 1.0);
-    //}
-    //if(abs(ThSCAT)>2.) "while condition has been breached";
+    fParticleGun->GeneratePrimaryVertex(anEvent);
     
+    ////    The statistical weight of the biased direction, carried by the vertex rather than by its tracks
+    if(weight != 1.) anEvent->GetPrimaryVertex(anEvent->GetNumberOfPrimaryVertex() - 1)->SetUserInformation(new PrimaryVertexWeight(weight));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::GenerateReaction(G4Event* anEvent)
+{
+    if(fSettings.beamEnergies.empty()) return;
     
-    ////    12.049 MeV 0+, 16O
-    Ex = G4RandGauss::shoot(12.049, (0.012/2.3548));
+    if(!fEjectile) fEjectile = GetIon(fSettings.ejectileZ, fSettings.ejectileA);
+    if(!fRecoil) fRecoil = GetIon(fSettings.recoilZ, fSettings.recoilA);
     
-    ////    12.049 MeV 0+, 16O
-    //Ex = G4RandGauss::shoot(15.097, (0.166/2.3548));
-
+    ////    Beam energy, one of the beam energies of the ladder
+    G4int beamIndex = 0;
+    if(fSettings.beamEnergies.size() > 1) beamIndex = std::min((G4int) (G4UniformRand()*fSettings.beamEnergies.size()), (G4int) fSettings.beamEnergies.size() - 1);
     
-    BiRelKin(m, T, E, p, ThSCAT, ThSCAT_Recoil, Ex);
+    G4double beamEnergy = fSettings.beamEnergies[beamIndex];
+    if(fSettings.beamEnergySigma > 0.) beamEnergy = G4RandGauss::shoot(beamEnergy, fSettings.beamEnergySigma);
     
-    ////    Setting Recoil Energy
-    fParticleGun->SetParticleEnergy(T[3]*MeV);
-    //fParticleGun->SetParticleEnergy(0.*MeV);
-    //G4cout << "Here is the Recoil Energy:    " << T[3] << G4endl;
+    ////    Recoil excitation energy
+    G4double Ex = fSettings.excitation;
+    if(fSettings.excitationFWHM > 0.) Ex = G4RandGauss::shoot(Ex, fSettings.excitationFWHM/2.3548);
     
+    ////    Uniformly distributed ThSCAT
+    G4double ThSCAT = G4RandFlat::shoot(fSettings.thetaMin, fSettings.thetaMax)/deg;
+    G4double Phi = 2*M_PI*G4UniformRand();
     
-    ////    Setting Recoil Momentum Direction
-    Phi = G4RandFlat::shoot( 0., 360.);
+    G4double T2, T3, ThSCAT_Recoil;
     
-    mx = sin(ThSCAT_Recoil*deg)*cos(Phi*deg);
-    my = sin(ThSCAT_Recoil*deg)*sin(Phi*deg);
-    mz = abs(cos(ThSCAT_Recoil*deg));
-
-    fParticleGun->SetParticleMomentumDirection(G4ThreeVector( mx, my, mz));
-    */
+    if(fSettings.beamEnergySigma > 0.)
+    {
+        ////    A continuous beam energy distribution is solved exactly
+        BiRelKinematics kinematics(fSettings.masses, beamEnergy/MeV, 0., Ex/MeV);
+        kinematics.Solve(1, &ThSCAT, &T2, &T3, &ThSCAT_Recoil);
+    }
+    else
+    {
+        ////    Tabulated kinematics per beam energy, the Gaussian tails beyond the tabulated excitation energies are solved exactly
+        if(fKinematicsTables.size() != fSettings.beamEnergies.size()) fKinematicsTables.assign(fSettings.beamEnergies.size(), 0);
+        
+        const ReactionKinematicsTable*& kinematicsTable = fKinematicsTables[beamIndex];
+        if(!kinematicsTable)
+        {
+            G4double ExWidth = 5*fSettings.excitationFWHM/2.3548;
+            kinematicsTable = ReactionKinematicsCache::GetTable(fSettings.masses, beamEnergy/MeV, fSettings.thetaMin/deg, fSettings.thetaMax/deg, (fSettings.excitation - ExWidth)/MeV, (fSettings.excitation + ExWidth)/MeV);
+        }
+        
+        if(kinematicsTable->IsInside(ThSCAT, Ex/MeV)) kinematicsTable->Interpolate(ThSCAT, Ex/MeV, T2, T3, ThSCAT_Recoil);
+        else kinematicsTable->Solve(ThSCAT, Ex/MeV, T2, T3, ThSCAT_Recoil);
+    }
     
+    ////    The ejectile and recoil on either side of the beam axis
+    G4ThreeVector ejectileDirection(sin(ThSCAT*deg)*cos(Phi), sin(ThSCAT*deg)*sin(Phi), cos(ThSCAT*deg));
+    G4ThreeVector recoilDirection(-sin(ThSCAT_Recoil*deg)*cos(Phi), -sin(ThSCAT_Recoil*deg)*sin(Phi), cos(ThSCAT_Recoil*deg));
     
-    /*
-    G4double theta_cm, phi_cm;
+    if(fSettings.emitEjectile) Emit(anEvent, fEjectile, T2*MeV, ejectileDirection);
     
-    ////    Isotropic in Centre-Of-Mass Frame
-    bool isotropy = true;
+    if(fSettings.decayRecoil)
+    {
+        G4double recoilMass = fRecoil->GetPDGMass() + Ex;
+        G4double recoilMomentum = sqrt(T3*MeV*(T3*MeV + 2*recoilMass));
+        
+        GenerateDecay(anEvent, Ex, G4LorentzVector(recoilMomentum*recoilDirection, T3*MeV + recoilMass));
+    }
+    else if(fSettings.emitRecoil)
+    {
+        ////    The recoil is emitted in its ground state, its de-excitation is treated by the decay stage
+        Emit(anEvent, fRecoil, T3*MeV, recoilDirection);
+    }
+}
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::GenerateDecay(G4Event* anEvent, G4double parentExcitation, const G4LorentzVector& parentMomentum)
+{
+    if(fSettings.daughterExcitations.empty()) return;
     
-    theta_cm = G4RandFlat::shoot( 0., 360.); // deg
-    //if()
+    if(!fEmitted) fEmitted = GetIon(fSettings.emittedZ, fSettings.emittedA);
+    if(!fDaughter) fDaughter = GetIon(fSettings.daughterZ, fSettings.daughterA);
     
-    fParticleGun->SetParticleMomentumDirection(G4ThreeVector( mx, my, mz));
-    */
+    ////    Daughter state, chosen according to the branching weights
+    G4double totalWeight = 0.;
+    for(size_t i=0; i<fSettings.daughterWeights.size(); i++) totalWeight += fSettings.daughterWeights[i];
     
+    G4double test = G4UniformRand()*totalWeight;
+    size_t state = 0;
+    while(state < fSettings.daughterWeights.size() - 1 && test > fSettings.daughterWeights[state])
+    {
+        test -= fSettings.daughterWeights[state];
+        state++;
+    }
     
+    G4double daughterExcitation = fSettings.daughterExcitations[state];
+    G4double Q = parentExcitation - fSettings.separationEnergy - daughterExcitation;
+    if(Q <= 0.) return;
     
+    ////    Isotropic two-body decay within the rest frame of the parent
+    G4double m1 = fEmitted->GetPDGMass();
+    G4double m2 = fDaughter->GetPDGMass() + daughterExcitation;
+    G4double M = m1 + m2 + Q;
+    G4double p = sqrt((M*M - (m1 + m2)*(m1 + m2))*(M*M - (m1 - m2)*(m1 - m2)))/(2*M);
     
-    /*
-     ////////    4He, +1 charge
-     G4int Z = 2, A = 4;
-     
-     G4double ionCharge   = 1.*eplus;
-     G4double excitEnergy = 0.*MeV;
-     
-     //G4ParticleDefinition* ion = G4ParticleTable::GetParticleTable()->GetIon(Z,A,excitEnergy);
-     G4ParticleDefinition* ion = G4IonTable::GetIonTable()->GetIon(Z,A,excitEnergy);
-     //ion->SetPDGLifeTime(1*ns);
-     fParticleGun->SetParticleDefinition(ion);
-     fParticleGun->SetParticleCharge(ionCharge);
-     */
+    G4ThreeVector direction = IsotropicDirection();
+    G4LorentzVector emitted(p*direction, sqrt(p*p + m1*m1));
+    G4LorentzVector daughter(-p*direction, sqrt(p*p + m2*m2));
     
+    G4ThreeVector boost = parentMomentum.boostVector();
+    emitted.boost(boost);
+    daughter.boost(boost);
     
-    ///////////////////////////////////////////////////
-    //              TIME DISTRIBUTION                //
-    ///////////////////////////////////////////////////
+    Emit(anEvent, fEmitted, emitted.e() - m1, emitted.vect().unit());
     
-    /*
-     initialclocktime = G4RandGauss::shoot( 0, 1.5);
-     fParticleGun->SetParticleTime(initialclocktime*ns);
-     */
+    if(fSettings.emitDaughter)
+    {
+        ////    The daughter is emitted in its ground state, its de-excitation gamma ray is emitted separately
+        Emit(anEvent, fDaughter, daughter.e() - m2, daughter.vect().unit());
+    }
     
+    ////     Gamma Decay - from the daughter nucleus, isotropic within its rest frame
+    if(fSettings.emitGamma && daughterExcitation > 0.)
+    {
+        G4LorentzVector gamma(daughterExcitation*IsotropicDirection(), daughterExcitation);
+        gamma.boost(daughter.boostVector());
+        
+        Emit(anEvent, G4ParticleTable::GetParticleTable()->FindParticle("gamma"), gamma.e(), gamma.vect().unit());
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::GenerateFromFile(G4Event* anEvent)
+{
+    if(!fInputFile) fInputFile = new PrimaryVertexFile(fSettings.inputFileName);
     
+    ////    The event IDs are unique amongst the threads, every thread thereby reads its own events without any locking
+    long long event = (long long) fSettings.inputFirstEvent + anEvent->GetEventID();
     
+    if(event >= fInputFile->GetNumberOfEvents())
+    {
+        if(!fEndOfInputReported)
+        {
+            G4cout << "\n---> The primary vertex file " << fSettings.inputFileName << " holds no event " << event << ", the run is aborted" << G4endl;
+            fEndOfInputReported = true;
+        }
+        G4RunManager::GetRunManager()->AbortRun(true);
+        return;
+    }
     
-    ///////////////////////////////////////////////////
-    //       Initial Direction of Particle
-    ///////////////////////////////////////////////////
+    G4int nofRecords;
+    const PrimaryVertexRecord* records = fInputFile->GetRecords(event, nofRecords);
     
-    //      Flat Distribution
-    //mx = G4RandFlat::shoot( -.15, .15);
-    //my = G4RandFlat::shoot( -.15, .15);
-    //mz = G4RandFlat::shoot( -1, 1);
-    
-    ////////////////////////////////
-    ////    ISOTROPIC
-    //      Exploiting the spherical symmetry of normal distributions
-    //      Gaussian Distribution
-    /*
-     mx = G4RandGauss::shoot( 0, 1.);
-     my = G4RandGauss::shoot( 0, 1.);
-     mz = G4RandGauss::shoot( 0, 1.);
-     
-     if(mz<0) mz = -mz;
-     //mz = abs(mz);
-     //fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,-1.));
-     //fParticleGun->SetParticleMomentumDirection(G4ThreeVector(mx, my, 10.));
-     fParticleGun->SetParticleMomentumDirection(G4ThreeVector(mx, my, -mz));
-     */
-    
-    ////    Alternative Method for ISOTROPY
-    /*
-    G4double theta = 2*M_PI*G4UniformRand();
-    //G4double mz = -1.0 + 2*G4UniformRand();
-    G4double mz = -1.0 + G4UniformRand();
+    G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
     
+    for(G4int i=0; i<nofRecords; i++)
+    {
+        const PrimaryVertexRecord& record = records[i];
+        
+        G4ParticleDefinition* particle = 0;
+        if(record.pdg != 0) particle = particleTable->FindParticle(record.pdg);
+        else particle = G4IonTable::GetIonTable()->GetIon(record.Z, record.A, record.Ex*MeV);
+        
+        if(!particle)
+        {
+            G4ExceptionDescription msg;
+            msg << "Unknown particle (pdg " << record.pdg << ", Z " << record.Z << ", A " << record.A << ") within event " << event << " of " << fSettings.inputFileName << ", the primary is skipped.";
+            G4Exception("PrimaryGeneratorAction::GenerateFromFile()", "K600PrimaryVertex002", JustWarning, msg);
+            continue;
+        }
+        
+        G4PrimaryVertex* vertex = new G4PrimaryVertex(record.x*mm, record.y*mm, record.z*mm, record.t*ns);
+        vertex->SetPrimary(new G4PrimaryParticle(particle, record.px*MeV, record.py*MeV, record.pz*MeV));
+        ////    The weight of the event, repeated on every record, is set on its first vertex alone
+        if(anEvent->GetNumberOfPrimaryVertex() == 0 && record.weight != 1.) vertex->SetUserInformation(new PrimaryVertexWeight(record.weight));
+        
+        anEvent->AddPrimaryVertex(vertex);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::Emit(G4Event* anEvent, G4ParticleDefinition* particle, G4double kineticEnergy, const G4ThreeVector& direction)
+{
+    fParticleGun->SetParticleDefinition(particle);
+    fParticleGun->SetParticleEnergy(kineticEnergy);
+    fParticleGun->SetParticleMomentumDirection(direction);
+    fParticleGun->GeneratePrimaryVertex(anEvent);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector PrimaryGeneratorAction::IsotropicDirection() const
+{
+    G4double theta = 2*M_PI*G4UniformRand();
+    G4double mz = -1.0 + 2*G4UniformRand();
     G4double a = sqrt(1-(mz*mz));
     
-    mx = a*cos(theta);
-    my = a*sin(theta);
+    return G4ThreeVector(a*cos(theta), a*sin(theta), mz);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector PrimaryGeneratorAction::BiasedDirection(const G4ThreeVector& vertex, G4double& weight)
+{
+    if(!fDetector) fDetector = static_cast<const DetectorConstruction*>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    
+    ////    The cones from the vertex which enclose the bounding spheres of the present detectors
+    const std::vector<InstrumentedVolume>& volumes = fDetector->GetInstrumentedVolumes();
     
-    fParticleGun->SetParticleMomentumDirection(G4ThreeVector(mx, my, mz));
-    */
+    fConeAxes.clear();
+    fConeCosAngles.clear();
+    fConeSolidAngles.clear();
     
+    G4double totalSolidAngle = 0.;
     
-    /*
-     theta = M_PI*G4UniformRand();
-     phi = 2*M_PI*G4UniformRand();
-     fParticleGun->SetParticleMomentumDirection(G4ThreeVector(sin(theta*rad)*cos(phi*rad), sin(theta*rad)*sin(phi*rad), cos(theta*rad)));
-     */
+    for(size_t i=0; i<volumes.size(); i++)
+    {
+        G4ThreeVector axis = volumes[i].centre - vertex;
+        G4double distance = axis.mag();
+        
+        ////    A vertex within the bounding sphere sees the detector over the full solid angle
+        G4double cosAngle = -1.;
+        if(distance > volumes[i].radius) cosAngle = sqrt(1. - (volumes[i].radius*volumes[i].radius)/(distance*distance));
+        
+        fConeAxes.push_back(axis.unit());
+        fConeCosAngles.push_back(cosAngle);
+        fConeSolidAngles.push_back(2*M_PI*(1. - cosAngle));
+        totalSolidAngle += fConeSolidAngles.back();
+    }
     
+    weight = 1.;
+    if(fConeAxes.empty()) return IsotropicDirection();
     
+    ////    A fraction of the directions is drawn uniformly within a cone, chosen according to its solid angle,
+    ////    the remainder isotropically, such that every direction is sampled and the weights remain bounded
+    G4ThreeVector direction;
+    size_t drawnCone = fConeAxes.size();
     
-    ///////////////////////////////////////////////////
-    //                  16O(a,a')
-    ///////////////////////////////////////////////////
-    /*
-     G4double test = G4UniformRand();
-     
-     //if(test<=0.5) beamEnergy = G4RandGauss::shoot( 200, 0.5); // MeV
-     //if(test>0.5) beamEnergy = G4RandGauss::shoot( 180, 0.5); // MeV
-     
-     if(test>0.0 && test<=0.1) beamEnergy = G4RandGauss::shoot( 215, 0.5); // MeV
-     if(test>0.1 && test<=0.2) beamEnergy = G4RandGauss::shoot( 210, 0.5); // MeV
-     if(test>0.2 && test<=0.3) beamEnergy = G4RandGauss::shoot( 200, 0.5); // MeV
-     if(test>0.3 && test<=0.4) beamEnergy = G4RandGauss::shoot( 190, 0.5); // MeV
-     if(test>0.4 && test<=0.5) beamEnergy = G4RandGauss::shoot( 180, 0.5); // MeV
-     if(test>0.5 && test<=0.6) beamEnergy = G4RandGauss::shoot( 185, 0.5); // MeV
-     if(test>0.6 && test<=0.7) beamEnergy = G4RandGauss::shoot( 170, 0.5); // MeV
-     if(test>0.7 && test<=0.8) beamEnergy = G4RandGauss::shoot( 160, 0.5); // MeV
-     if(test>0.8 && test<=0.9) beamEnergy = G4RandGauss::shoot( 150, 0.5); // MeV
-     if(test>0.9 && test<=1.0) beamEnergy = G4RandGauss::shoot( 140, 0.5); // MeV
-     
-     //beamEnergy = G4RandGauss::shoot( 200, 0.5); // MeV
-     //beamEnergy = 200; // MeV
-     
-     recoilExcitationEnergy = 15.097;  // MeV
-     alphaSeperationEnergy = 7.16192;    // MeV
-     protonSeperationEnergy = 12.1274;  // MeV
-     //  Elastically scattered outgoing alpha
-     mx = G4RandGauss::shoot( 0, 0.00001);
-     my = G4RandGauss::shoot( 0, .05);
-     //mx = G4RandGauss::shoot( 0, 0.00001);
-     //my = G4RandGauss::shoot( 0, 0.00001);
-     //mx = 0;
-     //my = 0;
-     
-     fParticleGun->SetParticleMomentumDirection(G4ThreeVector(mx, my, 10.));
-     energy = beamEnergy - recoilExcitationEnergy; // MeV
-     fParticleGun->SetParticleEnergy(energy*MeV);
-     fParticleGun->GeneratePrimaryVertex(anEvent);
-     
-     
-     //////////////////////////////////////////////////////////////
-     //                      16O -> 4He + 12C
-     //////////////////////////////////////////////////////////////
-     //  Alpha 0 isotropic decay:    15.097 MeV state of 16O -> to Ground state of 12C
-     //  Alpha 1 anisotropic decay:  15.097 MeV state of 16O -> to 4.43891 MeV state of 12C
-     //  Assuming recoil nucleus takes no kinetic energy from inelastic scatter
-     
-     G4double pAlphaDecayMode = G4UniformRand();
-     
-     if(pAlphaDecayMode<=0.5) alphaDecayMode = 0;
-     if(pAlphaDecayMode>0.5) alphaDecayMode = 1;
-     
-     //alphaDecayMode = 1;
-     
-     ////    ALPHA 1
-     if(alphaDecayMode == 0) daughterExcitationEnergy = 0; //    MeV
-     
-     ////    Alpha 0
-     if(alphaDecayMode == 1) daughterExcitationEnergy = 4.43891; //    MeV
-     
-     mx = G4RandFlat::shoot( -1., 1.);
-     my = G4RandFlat::shoot( -1., 1.);
-     mz = G4RandFlat::shoot( -1., 1.);
-     
-     fParticleGun->SetParticleEnergy( (recoilExcitationEnergy - alphaSeperationEnergy - daughterExcitationEnergy)*(3/4)*MeV);
-     
-     fParticleGun->SetParticleMomentumDirection(ejectileDirection);
-     
-     fParticleGun->GeneratePrimaryVertex(anEvent);
-     */
-    
-    
-    ////    Recoil - 12C
-    /*
-     fParticleGun->SetParticleEnergy( (recoilExcitationEnergy - alphaSeperationEnergy - daughterExcitationEnergy)*(1/4)*MeV);
-     
-     recoilDirection = -ejectileDirection;
-     fParticleGun->SetParticleMomentumDirection(recoilDirection);
-     */
-    
-    /*
-     Z = 6, A = 12;
-     
-     G4ParticleDefinition* recoil = G4IonTable::GetIonTable()->GetIon(Z, A, 4.43891*MeV);
-     //G4ParticleDefinition* recoil = G4ParticleTable::GetParticleTable()->GetIon(Z, A, 0.*keV);
-     fParticleGun->SetParticleCharge(0.*eplus);
-     //recoil->SetPDGLifeTime(1*ns);
-     //recoil->SetPDGStable(true);
-     fParticleGun->SetParticleDefinition(recoil);
-     
-     fParticleGun->SetParticleEnergy( (recoilExcitationEnergy - alphaSeperationEnergy - daughterExcitationEnergy)*(1/4)*MeV);
-     
-     recoilDirection = -ejectileDirection;
-     fParticleGun->SetParticleMomentumDirection(recoilDirection);
-     */
-    
-    
-    //fParticleGun->GeneratePrimaryVertex(anEvent);
-    
-    //G4double Lifetime = fParticleGun->GetParticleDefinition()->GetPDGLifeTime();
-    //G4double Lifetime = recoil->GetPDGLifeTime();
-    
-    //G4cout << "Here is the alphaSeperationEnergy    "<< alphaSeperationEnergy << G4endl;
-    
-    
-    
-    ////     Gamma Decay - from Recoil Nucleus
-    /*
-     if(alphaDecayMode == 1)
-     {
-     G4ParticleDefinition* particleDefinition = G4ParticleTable::GetParticleTable()->FindParticle("gamma");
-     fParticleGun->SetParticleDefinition(particleDefinition);
-     
-     fParticleGun->SetParticleEnergy(daughterExcitationEnergy*MeV);
-     
-     mx = G4RandFlat::shoot( -1., 1.);
-     my = G4RandFlat::shoot( -1., 1.);
-     mz = G4RandFlat::shoot( -1., 1.);
-     fParticleGun->SetParticleMomentumDirection(G4ThreeVector(mx, my, mz));
-     
-     fParticleGun->GeneratePrimaryVertex(anEvent);
-     }
-     */
-    
-    
-
-    
-    
-    
-    
-    ////////////////////////////////////////////////////////
-    //          PARTICLE INFORMATION OUTPUT
-    ////////////////////////////////////////////////////////
-    /*
-     G4double Lifetime = fParticleGun->GetParticleDefinition()->GetPDGLifeTime();
-     G4double Spin = fParticleGun->GetParticleDefinition()->GetPDGSpin();
-     G4double Isospin = fParticleGun->GetParticleDefinition()->GetPDGIsospin();
-     G4double Parity = fParticleGun->GetParticleDefinition()->GetPDGiGParity();
-     G4String ParticleName = fParticleGun->GetParticleDefinition()->GetParticleName();
-     
-     
-     
-     G4cout << "Here is the Lifetime    "<< Lifetime << G4endl;
-     G4cout << "Here is the Spin    "<< Spin << G4endl;
-     G4cout << "Here is the Isospin    "<< Isospin << G4endl;
-     G4cout << "Here is the Parity    "<< Parity << G4endl;
-     G4cout << "Here is the ParticleName    "<< ParticleName << G4endl;
-     */
-    
-
-    //create vertex
-    //
-    fParticleGun->GeneratePrimaryVertex(anEvent);
+    if(G4UniformRand() < fSettings.biasingFraction)
+    {
+        G4double test = G4UniformRand()*totalSolidAngle;
+        size_t cone = 0;
+        while(cone < fConeAxes.size() - 1 && test > fConeSolidAngles[cone])
+        {
+            test -= fConeSolidAngles[cone];
+            cone++;
+        }
+        
+        G4double cosTheta = 1. - G4UniformRand()*(1. - fConeCosAngles[cone]);
+        G4double sinTheta = sqrt(std::max(0., 1. - cosTheta*cosTheta));
+        G4double phi = 2*M_PI*G4UniformRand();
+        
+        direction = G4ThreeVector(sinTheta*cos(phi), sinTheta*sin(phi), cosTheta);
+        direction.rotateUz(fConeAxes[cone]);
+        drawnCone = cone;
+    }
+    else direction = IsotropicDirection();
     
+    ////    Sampling density of the mixture, each cone contributes (solid angle/total)*(1/solid angle) where it covers the direction
+    G4int coveringCones = 0;
+    for(size_t i=0; i<fConeAxes.size(); i++)
+    {
+        if(i == drawnCone || direction.dot(fConeAxes[i]) >= fConeCosAngles[i]) coveringCones++;
+    }
     
+    G4double density = (1. - fSettings.biasingFraction)/(4*M_PI) + fSettings.biasingFraction*coveringCones/totalSolidAngle;
+    weight = 1./(4*M_PI*density);
     
-    /*
-     // This function is called at the begining of event
-     
-     // In order to avoid dependence of PrimaryGeneratorAction
-     // on DetectorConstruction class we get world volume
-     // from G4LogicalVolumeStore
-     //
-     G4double worldZHalfLength = 0;
-     G4LogicalVolume* worlLV
-     = G4LogicalVolumeStore::GetInstance()->GetVolume("World");
-     G4Box* worldBox = 0;
-     if ( worlLV) worldBox = dynamic_cast< G4Box*>(worlLV->GetSolid());
-     if ( worldBox ) {
-     worldZHalfLength = worldBox->GetZHalfLength();
-     }
-     else  {
-     G4ExceptionDescription msg;
-     msg << "World volume of box not found." << G4endl;
-     msg << "Perhaps you have changed geometry." << G4endl;
-     msg << "The gun will be place in the center.";
-     G4Exception("PrimaryGeneratorAction::GeneratePrimaries()",
-     "MyCode0002", JustWarning, msg);
-     }
-     
-     // Set gun position
-     fParticleGun
-     ->SetParticlePosition(G4ThreeVector(0., 0., -worldZHalfLength));
-     
-     fParticleGun->GeneratePrimaryVertex(anEvent);
-     */
+    return direction;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+G4ParticleDefinition* PrimaryGeneratorAction::GetIon(G4int Z, G4int A) const
+{
+    ////    Light ions (p, d, t, 3He, 4He) are resolved to their particle definitions by the ion table
+    return G4IonTable::GetIonTable()->GetIon(Z, A, 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
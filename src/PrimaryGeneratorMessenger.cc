@@ -0,0 +1,366 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "PrimaryGeneratorMessenger.hh"
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+#include <sstream>
+
+namespace
+{
+    G4UIcmdWithADoubleAndUnit* CreateDoubleCommand(const char* name, const char* guidance, const char* unitCategory, const char* defaultUnit, G4UImessenger* messenger)
+    {
+        G4UIcmdWithADoubleAndUnit* command = new G4UIcmdWithADoubleAndUnit(name, messenger);
+        command->SetGuidance(guidance);
+        command->SetParameterName("value", false);
+        command->SetUnitCategory(unitCategory);
+        command->SetDefaultUnit(defaultUnit);
+        command->AvailableForStates(G4State_PreInit, G4State_Idle);
+        return command;
+    }
+    
+    G4UIcmdWithABool* CreateBoolCommand(const char* name, const char* guidance, G4UImessenger* messenger)
+    {
+        G4UIcmdWithABool* command = new G4UIcmdWithABool(name, messenger);
+        command->SetGuidance(guidance);
+        command->SetParameterName("flag", false);
+        command->AvailableForStates(G4State_PreInit, G4State_Idle);
+        return command;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* generatorAction)
+: G4UImessenger(),
+fGeneratorAction(generatorAction)
+{
+    fK600Directory = new G4UIdirectory("/K600/");
+    fK600Directory->SetGuidance("K600 simulation control");
+    
+    ////////////////////////////
+    //      SOURCE
+    fGunDirectory = new G4UIdirectory("/K600/gun/");
+    fGunDirectory->SetGuidance("Primary generator, applied on top of the /gun/ settings");
+    
+    fModeCmd = new G4UIcmdWithAString("/K600/gun/mode", this);
+    fModeCmd->SetGuidance("Primary stage of the generator:");
+    fModeCmd->SetGuidance("  gun      - the particle of the /gun/ settings");
+    fModeCmd->SetGuidance("  reaction - binary reaction of the beam on the target, see /K600/reaction/");
+    fModeCmd->SetGuidance("  decay    - decay of an excited nucleus at rest, see /K600/decay/");
+    fModeCmd->SetGuidance("  file     - primaries read from a primary vertex file, see /K600/input/");
+    fModeCmd->SetParameterName("mode", false);
+    fModeCmd->SetCandidates("gun reaction decay file");
+    fModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fDirectionCmd = new G4UIcmdWithAString("/K600/gun/direction", this);
+    fDirectionCmd->SetGuidance("Momentum direction distribution of the gun: isotropic, forward (+z) or backward (-z) hemisphere, or the fixed /gun/direction");
+    fDirectionCmd->SetGuidance("biased: towards the present CLOVER, LEPS and NAIS detectors, each event carrying the statistical weight of its direction");
+    fDirectionCmd->SetParameterName("direction", false);
+    fDirectionCmd->SetCandidates("isotropic forward backward fixed biased");
+    fDirectionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fEnergySigmaCmd = CreateDoubleCommand("/K600/gun/energySigma", "Gaussian standard deviation of the gun energy", "Energy", "MeV", this);
+    fTargetThicknessCmd = CreateDoubleCommand("/K600/gun/targetThickness", "Target thickness, the vertices are uniformly distributed along z about the /gun/position", "Length", "um", this);
+    fTimeSigmaCmd = CreateDoubleCommand("/K600/gun/timeSigma", "Gaussian standard deviation of the vertex time", "Time", "ns", this);
+    
+    fBiasingFractionCmd = new G4UIcmdWithADouble("/K600/gun/biasingFraction", this);
+    fBiasingFractionCmd->SetGuidance("Fraction of the biased directions drawn towards the detectors, the remainder is drawn isotropically");
+    fBiasingFractionCmd->SetParameterName("fraction", false);
+    fBiasingFractionCmd->SetRange("fraction >= 0. && fraction <= 1.");
+    fBiasingFractionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fBunchModeCmd = CreateBoolCommand("/K600/gun/bunchMode", "Generates the RF bunches of the cyclotron beam, each with a Poisson number of primary vertices, the time spread being the beam-time jitter", this);
+    
+    fParticlesPerBunchCmd = new G4UIcmdWithADouble("/K600/gun/particlesPerBunch", this);
+    fParticlesPerBunchCmd->SetGuidance("Mean number of primary vertices per RF bunch, from the beam intensity and RF frequency");
+    fParticlesPerBunchCmd->SetParameterName("mean", false);
+    fParticlesPerBunchCmd->SetRange("mean >= 0.");
+    fParticlesPerBunchCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fRFPeriodCmd = CreateDoubleCommand("/K600/gun/rfPeriod", "RF period of the cyclotron, the separation of the bunches", "Time", "ns", this);
+    
+    fBunchesPerEventCmd = new G4UIcmdWithAnInteger("/K600/gun/bunchesPerEvent", this);
+    fBunchesPerEventCmd->SetGuidance("Number of consecutive RF bunches within an event");
+    fBunchesPerEventCmd->SetParameterName("bunches", false);
+    fBunchesPerEventCmd->SetRange("bunches >= 1");
+    fBunchesPerEventCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    ////////////////////////////
+    //      REACTION
+    fReactionDirectory = new G4UIdirectory("/K600/reaction/");
+    fReactionDirectory->SetGuidance("Binary reaction m0(m1, m2)m3, with the beam along +z");
+    
+    fMassesCmd = new G4UIcommand("/K600/reaction/masses", this);
+    fMassesCmd->SetGuidance("Masses of the projectile, target, ejectile and recoil (u)");
+    const char* massNames[4] = {"m0", "m1", "m2", "m3"};
+    for(G4int i=0; i<4; i++)
+    {
+        G4UIparameter* parameter = new G4UIparameter(massNames[i], 'd', false);
+        parameter->SetParameterRange(G4String(massNames[i]) + " > 0.");
+        fMassesCmd->SetParameter(parameter);
+    }
+    fMassesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fEjectileCmd = CreateIonCommand("/K600/reaction/ejectile", "Ejectile nucleus (Z A)");
+    fRecoilCmd = CreateIonCommand("/K600/reaction/recoil", "Recoil nucleus (Z A)");
+    
+    fBeamEnergyCmd = CreateDoubleCommand("/K600/reaction/beamEnergy", "Beam energy, replaces the beam energy ladder", "Energy", "MeV", this);
+    fAddBeamEnergyCmd = CreateDoubleCommand("/K600/reaction/addBeamEnergy", "Adds a beam energy to the ladder, one of which is chosen with equal probability per event", "Energy", "MeV", this);
+    fBeamEnergySigmaCmd = CreateDoubleCommand("/K600/reaction/beamEnergySigma", "Gaussian standard deviation of the beam energy", "Energy", "MeV", this);
+    fExcitationCmd = CreateDoubleCommand("/K600/reaction/excitation", "Excitation energy of the recoil", "Energy", "MeV", this);
+    fExcitationFWHMCmd = CreateDoubleCommand("/K600/reaction/excitationFWHM", "Gaussian FWHM of the recoil excitation energy", "Energy", "MeV", this);
+    
+    fThetaRangeCmd = new G4UIcommand("/K600/reaction/thetaRange", this);
+    fThetaRangeCmd->SetGuidance("Range of the uniformly distributed ejectile scattering angle, negative angles lie at the opposite azimuth");
+    fThetaRangeCmd->SetParameter(new G4UIparameter("thetaMin", 'd', false));
+    fThetaRangeCmd->SetParameter(new G4UIparameter("thetaMax", 'd', false));
+    G4UIparameter* thetaUnit = new G4UIparameter("unit", 's', true);
+    thetaUnit->SetDefaultValue("deg");
+    thetaUnit->SetParameterCandidates("deg rad mrad");
+    fThetaRangeCmd->SetParameter(thetaUnit);
+    fThetaRangeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fEmitEjectileCmd = CreateBoolCommand("/K600/reaction/emitEjectile", "Emits the ejectile", this);
+    fEmitRecoilCmd = CreateBoolCommand("/K600/reaction/emitRecoil", "Emits the recoil in its ground state, unless it decays", this);
+    fDecayRecoilCmd = CreateBoolCommand("/K600/reaction/decayRecoil", "Decays the excited recoil in flight, see /K600/decay/", this);
+    
+    ////////////////////////////
+    //      DECAY
+    fDecayDirectory = new G4UIdirectory("/K600/decay/");
+    fDecayDirectory->SetGuidance("Two-body decay of an excited nucleus into an emitted particle and a daughter nucleus");
+    
+    fParentExcitationCmd = CreateDoubleCommand("/K600/decay/parentExcitation", "Excitation energy of the nucleus decaying at rest (decay mode), the recoil excitation is used otherwise", "Energy", "MeV", this);
+    fSeparationEnergyCmd = CreateDoubleCommand("/K600/decay/separationEnergy", "Separation energy of the emitted particle", "Energy", "MeV", this);
+    
+    fEmittedCmd = CreateIonCommand("/K600/decay/emitted", "Emitted particle (Z A)");
+    fDaughterCmd = CreateIonCommand("/K600/decay/daughter", "Daughter nucleus (Z A)");
+    
+    fClearDaughterStatesCmd = new G4UIcmdWithoutParameter("/K600/decay/clearDaughterStates", this);
+    fClearDaughterStatesCmd->SetGuidance("Removes all the daughter states");
+    fClearDaughterStatesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fAddDaughterStateCmd = new G4UIcommand("/K600/decay/addDaughterState", this);
+    fAddDaughterStateCmd->SetGuidance("Adds a daughter state, its excitation energy and its branching weight");
+    fAddDaughterStateCmd->SetParameter(new G4UIparameter("excitation", 'd', false));
+    G4UIparameter* excitationUnit = new G4UIparameter("unit", 's', false);
+    excitationUnit->SetParameterCandidates("eV keV MeV");
+    fAddDaughterStateCmd->SetParameter(excitationUnit);
+    G4UIparameter* weight = new G4UIparameter("weight", 'd', true);
+    weight->SetDefaultValue(1.);
+    weight->SetParameterRange("weight >= 0.");
+    fAddDaughterStateCmd->SetParameter(weight);
+    fAddDaughterStateCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fEmitDaughterCmd = CreateBoolCommand("/K600/decay/emitDaughter", "Emits the daughter nucleus in its ground state", this);
+    fEmitGammaCmd = CreateBoolCommand("/K600/decay/emitGamma", "Emits the de-excitation gamma ray of an excited daughter state", this);
+    
+    ////////////////////////////
+    //      INPUT
+    fInputDirectory = new G4UIdirectory("/K600/input/");
+    fInputDirectory->SetGuidance("Primary vertex file of the file mode, produced by the PrimaryVertexConverter");
+    
+    fInputFileNameCmd = new G4UIcmdWithAString("/K600/input/fileName", this);
+    fInputFileNameCmd->SetGuidance("Primary vertex file, the run is aborted at its last event");
+    fInputFileNameCmd->SetParameterName("fileName", false);
+    fInputFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fInputFirstEventCmd = new G4UIcmdWithAnInteger("/K600/input/firstEvent", this);
+    fInputFirstEventCmd->SetGuidance("Event of the primary vertex file of the first event of a run, such that consecutive runs continue through the file");
+    fInputFirstEventCmd->SetParameterName("event", false);
+    fInputFirstEventCmd->SetRange("event >= 0");
+    fInputFirstEventCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
+{
+    delete fModeCmd;
+    delete fDirectionCmd;
+    delete fEnergySigmaCmd;
+    delete fTargetThicknessCmd;
+    delete fTimeSigmaCmd;
+    delete fBiasingFractionCmd;
+    delete fBunchModeCmd;
+    delete fParticlesPerBunchCmd;
+    delete fRFPeriodCmd;
+    delete fBunchesPerEventCmd;
+    delete fGunDirectory;
+    
+    delete fMassesCmd;
+    delete fEjectileCmd;
+    delete fRecoilCmd;
+    delete fBeamEnergyCmd;
+    delete fAddBeamEnergyCmd;
+    delete fBeamEnergySigmaCmd;
+    delete fExcitationCmd;
+    delete fExcitationFWHMCmd;
+    delete fThetaRangeCmd;
+    delete fEmitEjectileCmd;
+    delete fEmitRecoilCmd;
+    delete fDecayRecoilCmd;
+    delete fReactionDirectory;
+    
+    delete fParentExcitationCmd;
+    delete fSeparationEnergyCmd;
+    delete fEmittedCmd;
+    delete fDaughterCmd;
+    delete fClearDaughterStatesCmd;
+    delete fAddDaughterStateCmd;
+    delete fEmitDaughterCmd;
+    delete fEmitGammaCmd;
+    delete fDecayDirectory;
+    
+    delete fInputFileNameCmd;
+    delete fInputFirstEventCmd;
+    delete fInputDirectory;
+    
+    delete fK600Directory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcommand* PrimaryGeneratorMessenger::CreateIonCommand(const char* name, const char* guidance)
+{
+    G4UIcommand* command = new G4UIcommand(name, this);
+    command->SetGuidance(guidance);
+    
+    G4UIparameter* Z = new G4UIparameter("Z", 'i', false);
+    Z->SetParameterRange("Z >= 1");
+    command->SetParameter(Z);
+    
+    G4UIparameter* A = new G4UIparameter("A", 'i', false);
+    A->SetParameterRange("A >= 1");
+    command->SetParameter(A);
+    
+    command->AvailableForStates(G4State_PreInit, G4State_Idle);
+    return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    PrimaryGeneratorSettings& settings = fGeneratorAction->GetSettings();
+    std::istringstream values(newValue);
+    
+    ////    Source
+    if(command == fModeCmd)
+    {
+        if(newValue == "gun") settings.mode = kGunMode;
+        if(newValue == "reaction") settings.mode = kReactionMode;
+        if(newValue == "decay") settings.mode = kDecayMode;
+        if(newValue == "file") settings.mode = kFileMode;
+    }
+    else if(command == fDirectionCmd)
+    {
+        if(newValue == "isotropic") settings.direction = kIsotropicDirection;
+        if(newValue == "forward") settings.direction = kForwardHemisphere;
+        if(newValue == "backward") settings.direction = kBackwardHemisphere;
+        if(newValue == "fixed") settings.direction = kFixedDirection;
+        if(newValue == "biased") settings.direction = kBiasedDirection;
+    }
+    else if(command == fEnergySigmaCmd) settings.energySigma = fEnergySigmaCmd->GetNewDoubleValue(newValue);
+    else if(command == fTargetThicknessCmd) settings.targetThickness = fTargetThicknessCmd->GetNewDoubleValue(newValue);
+    else if(command == fTimeSigmaCmd) settings.timeSigma = fTimeSigmaCmd->GetNewDoubleValue(newValue);
+    else if(command == fBiasingFractionCmd) settings.biasingFraction = fBiasingFractionCmd->GetNewDoubleValue(newValue);
+    else if(command == fBunchModeCmd) settings.bunchMode = fBunchModeCmd->GetNewBoolValue(newValue);
+    else if(command == fParticlesPerBunchCmd) settings.particlesPerBunch = fParticlesPerBunchCmd->GetNewDoubleValue(newValue);
+    else if(command == fRFPeriodCmd) settings.rfPeriod = fRFPeriodCmd->GetNewDoubleValue(newValue);
+    else if(command == fBunchesPerEventCmd) settings.bunchesPerEvent = fBunchesPerEventCmd->GetNewIntValue(newValue);
+    
+    ////    Reaction
+    else if(command == fMassesCmd) values >> settings.masses[0] >> settings.masses[1] >> settings.masses[2] >> settings.masses[3];
+    else if(command == fEjectileCmd) values >> settings.ejectileZ >> settings.ejectileA;
+    else if(command == fRecoilCmd) values >> settings.recoilZ >> settings.recoilA;
+    else if(command == fBeamEnergyCmd) settings.beamEnergies.assign(1, fBeamEnergyCmd->GetNewDoubleValue(newValue));
+    else if(command == fAddBeamEnergyCmd) settings.beamEnergies.push_back(fAddBeamEnergyCmd->GetNewDoubleValue(newValue));
+    else if(command == fBeamEnergySigmaCmd) settings.beamEnergySigma = fBeamEnergySigmaCmd->GetNewDoubleValue(newValue);
+    else if(command == fExcitationCmd) settings.excitation = fExcitationCmd->GetNewDoubleValue(newValue);
+    else if(command == fExcitationFWHMCmd) settings.excitationFWHM = fExcitationFWHMCmd->GetNewDoubleValue(newValue);
+    else if(command == fThetaRangeCmd)
+    {
+        G4double thetaMin, thetaMax;
+        G4String unit;
+        values >> thetaMin >> thetaMax >> unit;
+        settings.thetaMin = thetaMin*G4UIcommand::ValueOf(unit);
+        settings.thetaMax = thetaMax*G4UIcommand::ValueOf(unit);
+    }
+    else if(command == fEmitEjectileCmd) settings.emitEjectile = fEmitEjectileCmd->GetNewBoolValue(newValue);
+    else if(command == fEmitRecoilCmd) settings.emitRecoil = fEmitRecoilCmd->GetNewBoolValue(newValue);
+    else if(command == fDecayRecoilCmd) settings.decayRecoil = fDecayRecoilCmd->GetNewBoolValue(newValue);
+    
+    ////    Decay
+    else if(command == fParentExcitationCmd) settings.parentExcitation = fParentExcitationCmd->GetNewDoubleValue(newValue);
+    else if(command == fSeparationEnergyCmd) settings.separationEnergy = fSeparationEnergyCmd->GetNewDoubleValue(newValue);
+    else if(command == fEmittedCmd) values >> settings.emittedZ >> settings.emittedA;
+    else if(command == fDaughterCmd) values >> settings.daughterZ >> settings.daughterA;
+    else if(command == fClearDaughterStatesCmd)
+    {
+        settings.daughterExcitations.clear();
+        settings.daughterWeights.clear();
+    }
+    else if(command == fAddDaughterStateCmd)
+    {
+        G4double excitation, weight;
+        G4String unit;
+        values >> excitation >> unit >> weight;
+        settings.daughterExcitations.push_back(excitation*G4UIcommand::ValueOf(unit));
+        settings.daughterWeights.push_back(weight);
+    }
+    else if(command == fEmitDaughterCmd) settings.emitDaughter = fEmitDaughterCmd->GetNewBoolValue(newValue);
+    else if(command == fEmitGammaCmd) settings.emitGamma = fEmitGammaCmd->GetNewBoolValue(newValue);
+    
+    ////    Input
+    else if(command == fInputFileNameCmd) settings.inputFileName = newValue;
+    else if(command == fInputFirstEventCmd) settings.inputFirstEvent = fInputFirstEventCmd->GetNewIntValue(newValue);
+    
+    ////    The tabulated kinematics and the particle definitions are resolved again for the new settings
+    fGeneratorAction->ResetCaches();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
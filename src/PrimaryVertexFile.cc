@@ -0,0 +1,188 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "PrimaryVertexFile.hh"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryVertexFile::PrimaryVertexFile(const G4String& fileName)
+: fMapping(0), fMappingSize(0), fNofEvents(0), fFirstRecord(0), fRecords(0)
+{
+    int fd = open(fileName.c_str(), O_RDONLY);
+    
+    PrimaryVertexFileHeader header;
+    struct stat fileStatus;
+    
+    G4bool isValid = fd >= 0 &&
+    read(fd, &header, sizeof(header)) == (ssize_t) sizeof(header) &&
+    memcmp(header.magic, "K600PVTX", 8) == 0 &&
+    header.version == 1 && header.recordSize == (G4int) sizeof(PrimaryVertexRecord) &&
+    header.nofEvents >= 0 && header.nofRecords >= 0 &&
+    fstat(fd, &fileStatus) == 0 &&
+    size_t(fileStatus.st_size) == sizeof(header) + (header.nofEvents + 1)*sizeof(long long) + header.nofRecords*sizeof(PrimaryVertexRecord);
+    
+    void* mapping = MAP_FAILED;
+    if(isValid)
+    {
+        ////    A read-only shared mapping, the pages are shared by the readers of every thread
+        mapping = mmap(0, fileStatus.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    if(fd >= 0) close(fd);
+    
+    ////    The index is to start at the first record, never decrease and end at nofRecords
+    if(mapping != MAP_FAILED)
+    {
+        const long long* firstRecord = reinterpret_cast<const long long*>(static_cast<const char*>(mapping) + sizeof(header));
+        
+        isValid = firstRecord[0] == 0 && firstRecord[header.nofEvents] == header.nofRecords;
+        for(long long i=0; isValid && i<header.nofEvents; i++) isValid = firstRecord[i] <= firstRecord[i+1];
+        
+        if(!isValid)
+        {
+            munmap(mapping, fileStatus.st_size);
+            mapping = MAP_FAILED;
+        }
+    }
+    
+    if(mapping == MAP_FAILED)
+    {
+        G4ExceptionDescription msg;
+        msg << "The primary vertex file " << fileName << " is missing, invalid or could not be mapped.";
+        G4Exception("PrimaryVertexFile::PrimaryVertexFile()", "K600PrimaryVertex001", FatalException, msg);
+        return;
+    }
+    
+    fMapping = mapping;
+    fMappingSize = fileStatus.st_size;
+    fNofEvents = header.nofEvents;
+    
+    const char* payload = static_cast<const char*>(fMapping) + sizeof(header);
+    fFirstRecord = reinterpret_cast<const long long*>(payload);
+    fRecords = reinterpret_cast<const PrimaryVertexRecord*>(payload + (fNofEvents + 1)*sizeof(long long));
+    
+    G4cout << "\n---> Mapped the primary vertex file " << fileName << ", " << fNofEvents << " events of " << header.nofRecords << " primaries" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryVertexFile::~PrimaryVertexFile()
+{
+    if(fMapping) munmap(fMapping, fMappingSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PrimaryVertexFile::Convert(const char* textFileName, const char* binaryFileName)
+{
+    std::ifstream textFile(textFileName);
+    if(!textFile.is_open())
+    {
+        G4cerr << " The text file " << textFileName << " could not be opened." << G4endl;
+        return false;
+    }
+    
+    std::vector<PrimaryVertexRecord> records;
+    std::vector<long long> firstRecord;
+    
+    long long lastEvent = -1;
+    G4int lineNumber = 0;
+    std::string line;
+    
+    while(std::getline(textFile, line))
+    {
+        lineNumber++;
+        if(line.empty() || line[0] == '#') continue;
+        
+        std::istringstream values(line);
+        long long event;
+        PrimaryVertexRecord record;
+        memset(&record, 0, sizeof(record));
+        
+        values >> event >> record.pdg >> record.Z >> record.A >> record.Ex
+        >> record.px >> record.py >> record.pz >> record.x >> record.y >> record.z >> record.t >> record.weight;
+        
+        if(values.fail() || event < lastEvent)
+        {
+            G4cerr << " Invalid line " << lineNumber << " of " << textFileName << ", the events are to be given in ascending order." << G4endl;
+            return false;
+        }
+        
+        ////    The weight is that of the event, and hence the same on every line of the event
+        if(event == lastEvent && record.weight != records.back().weight)
+        {
+            G4cerr << " Invalid line " << lineNumber << " of " << textFileName << ", the weight differs from that of the previous lines of event " << event << "." << G4endl;
+            return false;
+        }
+        
+        ////    The event numbers need not be contiguous, the events are numbered in the order of their appearance
+        if(event != lastEvent) firstRecord.push_back(records.size());
+        lastEvent = event;
+        
+        records.push_back(record);
+    }
+    firstRecord.push_back(records.size());
+    
+    PrimaryVertexFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "K600PVTX", 8);
+    header.version = 1;
+    header.recordSize = sizeof(PrimaryVertexRecord);
+    header.nofEvents = firstRecord.size() - 1;
+    header.nofRecords = records.size();
+    
+    std::ofstream binaryFile(binaryFileName, std::ios::out | std::ios::binary);
+    binaryFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    binaryFile.write(reinterpret_cast<const char*>(&firstRecord[0]), firstRecord.size()*sizeof(long long));
+    if(!records.empty()) binaryFile.write(reinterpret_cast<const char*>(&records[0]), records.size()*sizeof(PrimaryVertexRecord));
+    binaryFile.close();
+    
+    G4cout << " ---> " << header.nofEvents << " events of " << header.nofRecords << " primaries" << G4endl;
+    
+    return !binaryFile.fail();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,262 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "ProgressMonitor.hh"
+
+#include "G4AutoLock.hh"
+
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    G4Mutex progressMonitorMutex = G4MUTEX_INITIALIZER;
+    
+    struct ProgressThreadData
+    {
+        G4int       index;              // within the per-thread counts of the run, -1 until the first update
+        G4long      nofEvents;
+        G4long      nofEventsFlushed;
+        G4double    flushTime;          // s
+    };
+    
+    G4ThreadLocal ProgressThreadData* progressThreadData = 0;
+    
+    ProgressThreadData* GetThreadData()
+    {
+        if(!progressThreadData)
+        {
+            progressThreadData = new ProgressThreadData;
+            progressThreadData->index = -1;
+            progressThreadData->nofEvents = 0;
+            progressThreadData->nofEventsFlushed = 0;
+            progressThreadData->flushTime = 0.;
+        }
+        return progressThreadData;
+    }
+    
+    ////    Wall-clock time in s
+    G4double WallTime()
+    {
+        timeval now;
+        gettimeofday(&now, 0);
+        return now.tv_sec + 1.e-6*now.tv_usec;
+    }
+    
+    ////    Peak resident memory of the process in MB
+    G4double PeakRSS()
+    {
+        rusage usage;
+        if(getrusage(RUSAGE_SELF, &usage) != 0) return 0.;
+#ifdef __APPLE__
+        return usage.ru_maxrss/(1024.*1024.);   // bytes
+#else
+        return usage.ru_maxrss/1024.;           // kB
+#endif
+    }
+    
+    ////    h:mm:ss
+    G4String FormatDuration(G4double seconds)
+    {
+        long s = long(seconds + 0.5);
+        std::ostringstream duration;
+        duration << s/3600 << ":" << std::setfill('0') << std::setw(2) << (s/60)%60 << ":" << std::setw(2) << s%60;
+        return duration.str();
+    }
+}
+
+G4double            ProgressMonitor::fInterval = ProgressMonitor_DefaultInterval;
+G4String            ProgressMonitor::fLogFileName;
+G4int               ProgressMonitor::fRunID = 0;
+G4long              ProgressMonitor::fNofEventsToBeProcessed = 0;
+G4long              ProgressMonitor::fNofEvents = 0;
+G4long              ProgressMonitor::fNofEventsReported = 0;
+G4double            ProgressMonitor::fStartTime = 0.;
+G4double            ProgressMonitor::fReportTime = 0.;
+std::vector<G4long> ProgressMonitor::fThreadEvents;
+std::vector<G4long> ProgressMonitor::fThreadEventsReported;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProgressMonitor::BeginOfRun(G4int runID, G4int nofEventsToBeProcessed)
+{
+    G4AutoLock lock(&progressMonitorMutex);
+    
+    fRunID = runID;
+    fNofEventsToBeProcessed = nofEventsToBeProcessed;
+    fNofEvents = 0;
+    fNofEventsReported = 0;
+    fStartTime = WallTime();
+    fReportTime = fStartTime;
+    fThreadEvents.clear();
+    fThreadEventsReported.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProgressMonitor::EndOfRun(G4int nofEvents)
+{
+    G4AutoLock lock(&progressMonitorMutex);
+    
+    ////    The events of the run as counted by the run manager, including those of threads which never reached an update
+    fNofEvents = nofEvents;
+    Report(WallTime(), true);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProgressMonitor::BeginOfThreadRun()
+{
+    ProgressThreadData* data = GetThreadData();
+    data->index = -1;
+    data->nofEvents = 0;
+    data->nofEventsFlushed = 0;
+    data->flushTime = WallTime() + ProgressMonitor_FlushInterval;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProgressMonitor::EndOfThreadRun()
+{
+    if(GetThreadData()->nofEvents > 0) Flush(WallTime());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProgressMonitor::EventDone()
+{
+    ProgressThreadData* data = GetThreadData();
+    data->nofEvents++;
+    
+    ////    Only the wall clock is read per event, the totals are updated once per flush interval
+    G4double wallTime = WallTime();
+    if(wallTime >= data->flushTime)
+    {
+        data->flushTime = wallTime + ProgressMonitor_FlushInterval;
+        Flush(wallTime);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProgressMonitor::Flush(G4double wallTime)
+{
+    ProgressThreadData* data = GetThreadData();
+    
+    G4AutoLock lock(&progressMonitorMutex);
+    
+    if(data->index < 0)
+    {
+        data->index = G4int(fThreadEvents.size());
+        fThreadEvents.push_back(0);
+        fThreadEventsReported.push_back(0);
+    }
+    
+    fThreadEvents[data->index] += data->nofEvents - data->nofEventsFlushed;
+    fNofEvents += data->nofEvents - data->nofEventsFlushed;
+    data->nofEventsFlushed = data->nofEvents;
+    
+    if(fInterval > 0. && wallTime >= fReportTime + fInterval) Report(wallTime, false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProgressMonitor::Report(G4double wallTime, G4bool isFinal)
+{
+    G4double elapsedTime = wallTime - fStartTime;
+    G4double intervalTime = wallTime - fReportTime;
+    G4int nofThreads = std::max(G4int(fThreadEvents.size()), 1);
+    
+    ////    The rates of the run and of the last interval, the latter also per thread
+    G4double runRate = elapsedTime > 0. ? fNofEvents/elapsedTime : 0.;
+    G4double rate = intervalTime > 0. ? (fNofEvents - fNofEventsReported)/intervalTime : 0.;
+    G4double minThreadRate = 0., maxThreadRate = 0.;
+    for(size_t i=0; i<fThreadEvents.size(); i++)
+    {
+        G4double threadRate = intervalTime > 0. ? (fThreadEvents[i] - fThreadEventsReported[i])/intervalTime : 0.;
+        if(i==0 || threadRate < minThreadRate) minThreadRate = threadRate;
+        if(i==0 || threadRate > maxThreadRate) maxThreadRate = threadRate;
+        fThreadEventsReported[i] = fThreadEvents[i];
+    }
+    if(isFinal) rate = runRate;
+    
+    G4double eta = runRate > 0. ? std::max(fNofEventsToBeProcessed - fNofEvents, G4long(0))/runRate : 0.;
+    G4double peakRSS = PeakRSS();
+    
+    ////    Formatted apart, the stream state of G4cout is left untouched
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1);
+    if(isFinal)
+    {
+        line << "Run " << fRunID << ": " << fNofEvents << " events in " << FormatDuration(elapsedTime)
+        << ", " << runRate << " events/s (" << runRate/nofThreads << " per thread)";
+    }
+    else
+    {
+        line << "Run " << fRunID << ": " << fNofEvents << "/" << fNofEventsToBeProcessed << " events"
+        << " (" << (fNofEventsToBeProcessed > 0 ? 100.*fNofEvents/fNofEventsToBeProcessed : 0.) << "%)"
+        << ", " << rate << " events/s, " << nofThreads << " threads at " << rate/nofThreads << " events/s (" << minThreadRate << "-" << maxThreadRate << ")"
+        << ", ETA " << FormatDuration(eta);
+    }
+    line << ", peak RSS " << std::setprecision(0) << peakRSS << " MB";
+    G4cout << "\n---> " << line.str() << G4endl;
+    
+    ////    One line of key=value pairs per report for the job monitoring
+    if(!fLogFileName.empty())
+    {
+        std::ofstream logFile(fLogFileName.c_str(), std::ios::app);
+        if(logFile)
+        {
+            logFile << "time=" << std::fixed << std::setprecision(3) << wallTime << std::setprecision(1)
+            << " run=" << fRunID << " state=" << (isFinal ? "done" : "running")
+            << " events=" << fNofEvents << " total=" << fNofEventsToBeProcessed
+            << " elapsed=" << elapsedTime << " rate=" << rate << " threadRate=" << rate/nofThreads
+            << " threads=" << nofThreads << " eta=" << (isFinal ? 0. : eta)
+            << " peakRSS_MB=" << peakRSS << "\n";
+        }
+    }
+    
+    fNofEventsReported = fNofEvents;
+    fReportTime = wallTime;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,86 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "ProgressMonitorMessenger.hh"
+#include "ProgressMonitor.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ProgressMonitorMessenger::ProgressMonitorMessenger()
+: G4UImessenger()
+{
+    fProgressDirectory = new G4UIdirectory("/K600/progress/");
+    fProgressDirectory->SetGuidance("Rate-limited reports of the progress of a run");
+    
+    fIntervalCmd = new G4UIcmdWithADoubleAndUnit("/K600/progress/interval", this);
+    fIntervalCmd->SetGuidance("Wall-clock time between the progress reports, 0 reports the end of the run only");
+    fIntervalCmd->SetParameterName("interval", false);
+    fIntervalCmd->SetRange("interval >= 0.");
+    fIntervalCmd->SetDefaultUnit("s");
+    fIntervalCmd->SetToBeBroadcasted(false);
+    fIntervalCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fLogFileCmd = new G4UIcmdWithAString("/K600/progress/logFile", this);
+    fLogFileCmd->SetGuidance("Appends every report to the given file as a line of key=value pairs, none switches the log off");
+    fLogFileCmd->SetParameterName("fileName", false);
+    fLogFileCmd->SetToBeBroadcasted(false);
+    fLogFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ProgressMonitorMessenger::~ProgressMonitorMessenger()
+{
+    delete fIntervalCmd;
+    delete fLogFileCmd;
+    delete fProgressDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProgressMonitorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if(command == fIntervalCmd) ProgressMonitor::SetInterval(fIntervalCmd->GetNewDoubleValue(newValue)/s);
+    else if(command == fLogFileCmd) ProgressMonitor::SetLogFileName(newValue == "none" ? G4String() : newValue);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,124 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "RandomSeeding.hh"
+
+#include "Randomize.hh"
+#include "G4Version.hh"
+
+#include "CLHEP/Random/MTwistEngine.h"
+#include "CLHEP/Random/RanecuEngine.h"
+#include "CLHEP/Random/RanluxEngine.h"
+#if G4VERSION_NUMBER >= 1030
+#include "CLHEP/Random/MixMaxRng.h"
+#endif
+
+long RandomSeeding::fRunSeed = RandomSeeding_DefaultSeed;
+G4int RandomSeeding::fReplayRun = -1;
+G4int RandomSeeding::fReplayEvent = 0;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+    ////    SplitMix64, a bijective mixing of the 64 bits, consecutive inputs give uncorrelated outputs
+    unsigned long long Mix(unsigned long long x)
+    {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30))*0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27))*0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CLHEP::HepRandomEngine* RandomSeeding::CreateEngine(const G4String& name)
+{
+#if G4VERSION_NUMBER >= 1030
+    if(name == "MixMax") return new CLHEP::MixMaxRng();
+#endif
+    if(name == "MTwist") return new CLHEP::MTwistEngine();
+    if(name == "Ranecu") return new CLHEP::RanecuEngine();
+    if(name == "Ranlux") return new CLHEP::RanluxEngine(RandomSeeding_DefaultSeed, 4);
+    
+    return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const char* RandomSeeding::GetDefaultEngineName()
+{
+#if G4VERSION_NUMBER >= 1030
+    return "MixMax";
+#else
+    return "MTwist";
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RandomSeeding::SeedEvent(G4int runID, G4int eventID)
+{
+    if(fReplayRun >= 0)
+    {
+        runID = fReplayRun;
+        eventID += fReplayEvent;
+    }
+    
+    unsigned long long hash = Mix((unsigned long long) fRunSeed);
+    hash = Mix(hash ^ (unsigned long long) runID);
+    hash = Mix(hash ^ (unsigned long long) eventID);
+    
+    ////    Two positive 31 bit seeds, as accepted by every engine, the list being terminated by 0
+    long seeds[3];
+    seeds[0] = (long) (hash & 0x7FFFFFFFULL) | 1;
+    seeds[1] = (long) ((hash >> 32) & 0x7FFFFFFFULL) | 1;
+    seeds[2] = 0;
+    
+    G4Random::setTheSeeds(seeds);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RandomSeeding::PrintRunSeed(G4int runID)
+{
+    G4cout << "\n---> Run " << runID << ", random engine " << G4Random::getTheEngine()->name() << ", run seed " << fRunSeed;
+    if(fReplayRun >= 0) G4cout << ", replaying run " << fReplayRun << " from event " << fReplayEvent;
+    G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
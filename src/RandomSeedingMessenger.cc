@@ -0,0 +1,105 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "RandomSeedingMessenger.hh"
+#include "RandomSeeding.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RandomSeedingMessenger::RandomSeedingMessenger()
+: G4UImessenger()
+{
+    fRandomDirectory = new G4UIdirectory("/K600/random/");
+    fRandomDirectory->SetGuidance("Reproducible seeding, every event is seeded from the run seed, the run ID and the event ID");
+    
+    fSeedCmd = new G4UIcmdWithAnInteger("/K600/random/seed", this);
+    fSeedCmd->SetGuidance("Run seed of the following runs");
+    fSeedCmd->SetParameterName("seed", false);
+    fSeedCmd->SetToBeBroadcasted(false);
+    fSeedCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fReplayEventCmd = new G4UIcommand("/K600/random/replayEvent", this);
+    fReplayEventCmd->SetGuidance("Seeds the events of the following runs as those of the given run, starting at the given event");
+    fReplayEventCmd->SetGuidance("e.g. /K600/random/replayEvent 0 1234 followed by /run/beamOn 1 re-runs event 1234 of run 0");
+    G4UIparameter* run = new G4UIparameter("run", 'i', false);
+    run->SetParameterRange("run >= 0");
+    fReplayEventCmd->SetParameter(run);
+    G4UIparameter* event = new G4UIparameter("event", 'i', false);
+    event->SetParameterRange("event >= 0");
+    fReplayEventCmd->SetParameter(event);
+    fReplayEventCmd->SetToBeBroadcasted(false);
+    fReplayEventCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fResetReplayCmd = new G4UIcmdWithoutParameter("/K600/random/resetReplay", this);
+    fResetReplayCmd->SetGuidance("Seeds the events of the following runs by their own run and event IDs");
+    fResetReplayCmd->SetToBeBroadcasted(false);
+    fResetReplayCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RandomSeedingMessenger::~RandomSeedingMessenger()
+{
+    delete fSeedCmd;
+    delete fReplayEventCmd;
+    delete fResetReplayCmd;
+    delete fRandomDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RandomSeedingMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if(command == fSeedCmd) RandomSeeding::SetRunSeed(fSeedCmd->GetNewIntValue(newValue));
+    else if(command == fReplayEventCmd)
+    {
+        G4int run, event;
+        std::istringstream values(newValue);
+        values >> run >> event;
+        RandomSeeding::SetReplay(run, event);
+    }
+    else if(command == fResetReplayCmd) RandomSeeding::ResetReplay();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,189 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "ReactionKinematicsCache.hh"
+#include "BiRelKin.hh"
+
+#include "G4AutoLock.hh"
+
+#include <cmath>
+#include <map>
+#include <sstream>
+
+namespace
+{
+    G4Mutex reactionKinematicsCacheMutex = G4MUTEX_INITIALIZER;
+    
+    ////    The tables live until the end of the program
+    struct ReactionKinematicsTables
+    {
+        ~ReactionKinematicsTables()
+        {
+            std::map<G4String, ReactionKinematicsTable*>::iterator it;
+            for(it = tables.begin(); it != tables.end(); it++) delete it->second;
+        }
+        
+        std::map<G4String, ReactionKinematicsTable*> tables;
+    };
+    
+    ReactionKinematicsTables reactionKinematicsTables;
+    
+    G4int NumberOfPoints(G4double& minimum, G4double& maximum, G4double step)
+    {
+        if(maximum <= minimum) maximum = minimum + step;
+        return (G4int) std::ceil((maximum - minimum)/step - 1.e-9) + 1;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ReactionKinematicsTable::ReactionKinematicsTable(const G4double* m, G4double T0, G4double thetaMin, G4double thetaMax, G4double ExMin, G4double ExMax)
+: fT0(T0),
+fThetaMin(thetaMin), fThetaMax(thetaMax),
+fExMin(ExMin), fExMax(ExMax)
+{
+    for(G4int i=0; i<4; i++) fMass[i] = m[i];
+    
+    fNofThetaPoints = NumberOfPoints(fThetaMin, fThetaMax, ReactionKinematics_ThetaStep);
+    fNofExPoints = NumberOfPoints(fExMin, fExMax, ReactionKinematics_ExStep);
+    
+    if(fNofThetaPoints*fNofExPoints > ReactionKinematics_MaxPoints)
+    {
+        fNofThetaPoints = std::max(2, ReactionKinematics_MaxPoints/fNofExPoints);
+    }
+    
+    fThetaStep = (fThetaMax - fThetaMin)/(fNofThetaPoints - 1);
+    fExStep = (fExMax - fExMin)/(fNofExPoints - 1);
+    
+    ////    One row of scattering angles per excitation energy, solved as a batch
+    std::vector<G4double> theta(fNofThetaPoints), T2(fNofThetaPoints), T3(fNofThetaPoints), ThetaRecoil(fNofThetaPoints);
+    
+    for(G4int i=0; i<fNofThetaPoints; i++) theta[i] = fThetaMin + i*fThetaStep;
+    
+    fTable.resize(3*fNofThetaPoints*fNofExPoints);
+    
+    for(G4int j=0; j<fNofExPoints; j++)
+    {
+        BiRelKinematics kinematics(fMass, fT0, 0., fExMin + j*fExStep);
+        kinematics.Solve(fNofThetaPoints, &theta[0], &T2[0], &T3[0], &ThetaRecoil[0]);
+        
+        G4double* row = &fTable[3*j*fNofThetaPoints];
+        for(G4int i=0; i<fNofThetaPoints; i++)
+        {
+            row[3*i] = T2[i];
+            row[3*i + 1] = T3[i];
+            row[3*i + 2] = ThetaRecoil[i];
+        }
+    }
+    
+    ////    The interpolation error is sampled at the centres of the grid cells
+    for(G4int q=0; q<3; q++) fErrorBound[q] = 0.;
+    
+    for(G4int i=0; i<fNofThetaPoints-1; i++) theta[i] = fThetaMin + (i + 0.5)*fThetaStep;
+    
+    for(G4int j=0; j<fNofExPoints-1; j++)
+    {
+        G4double Ex = fExMin + (j + 0.5)*fExStep;
+        
+        BiRelKinematics kinematics(fMass, fT0, 0., Ex);
+        kinematics.Solve(fNofThetaPoints-1, &theta[0], &T2[0], &T3[0], &ThetaRecoil[0]);
+        
+        for(G4int i=0; i<fNofThetaPoints-1; i++)
+        {
+            G4double interpolated[3];
+            Interpolate(theta[i], Ex, interpolated[0], interpolated[1], interpolated[2]);
+            
+            G4double error[3] = {std::fabs(interpolated[0] - T2[i]), std::fabs(interpolated[1] - T3[i]), std::fabs(interpolated[2] - ThetaRecoil[i])};
+            for(G4int q=0; q<3; q++) if(error[q] > fErrorBound[q]) fErrorBound[q] = error[q];
+        }
+    }
+    
+    G4cout << "\n---> Tabulated the reaction kinematics, " << fNofThetaPoints << " scattering angles within [" << fThetaMin << ", " << fThetaMax << "] deg, "
+    << fNofExPoints << " excitation energies within [" << fExMin << ", " << fExMax << "] MeV" << G4endl;
+    G4cout << "     Maximum interpolation errors, ejectile energy: " << fErrorBound[0]*1.e3 << " keV, recoil energy: " << fErrorBound[1]*1.e3
+    << " keV, recoil angle: " << fErrorBound[2] << " deg" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ReactionKinematicsTable::Interpolate(G4double ThetaSCAT, G4double Ex, G4double& T2, G4double& T3, G4double& ThetaRecoil) const
+{
+    G4double u = (ThetaSCAT - fThetaMin)/fThetaStep;
+    G4double v = (Ex - fExMin)/fExStep;
+    
+    G4int i = (G4int) u;
+    G4int j = (G4int) v;
+    if(i > fNofThetaPoints - 2) i = fNofThetaPoints - 2;
+    if(j > fNofExPoints - 2) j = fNofExPoints - 2;
+    
+    u -= i;
+    v -= j;
+    
+    const G4double* p00 = &fTable[3*(j*fNofThetaPoints + i)];
+    const G4double* p01 = p00 + 3*fNofThetaPoints;
+    
+    G4double w00 = (1. - u)*(1. - v), w10 = u*(1. - v), w01 = (1. - u)*v, w11 = u*v;
+    
+    T2 = w00*p00[0] + w10*p00[3] + w01*p01[0] + w11*p01[3];
+    T3 = w00*p00[1] + w10*p00[4] + w01*p01[1] + w11*p01[4];
+    ThetaRecoil = w00*p00[2] + w10*p00[5] + w01*p01[2] + w11*p01[5];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ReactionKinematicsTable::Solve(G4double ThetaSCAT, G4double Ex, G4double& T2, G4double& T3, G4double& ThetaRecoil) const
+{
+    BiRelKinematics kinematics(fMass, fT0, 0., Ex);
+    kinematics.Solve(1, &ThetaSCAT, &T2, &T3, &ThetaRecoil);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const ReactionKinematicsTable* ReactionKinematicsCache::GetTable(const G4double* m, G4double T0, G4double thetaMin, G4double thetaMax, G4double ExMin, G4double ExMax)
+{
+    std::ostringstream key;
+    key.precision(17);
+    key << m[0] << ' ' << m[1] << ' ' << m[2] << ' ' << m[3] << ' ' << T0 << ' ' << thetaMin << ' ' << thetaMax << ' ' << ExMin << ' ' << ExMax;
+    
+    G4AutoLock lock(&reactionKinematicsCacheMutex);
+    
+    ReactionKinematicsTable*& table = reactionKinematicsTables.tables[key.str()];
+    if(!table) table = new ReactionKinematicsTable(m, T0, thetaMin, thetaMax, ExMin, ExMax);
+    
+    return table;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,263 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "ResponseMatrix.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4AutoLock.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <fstream>
+#include <cstring>
+
+namespace
+{
+    G4Mutex responseMatrixMutex = G4MUTEX_INITIALIZER;
+    
+    const G4int         arrayCrystals[numberOf_ResponseArrays] = {1, 4};
+    const G4int         arrayOffset[numberOf_ResponseArrays] = {0, numberOf_NAIS};
+    const G4int         numberOfCrystals = numberOf_NAIS + 4*numberOf_LEPS;
+    
+    struct ResponseMatrices
+    {
+        G4int                                       nofIncidentBins, nofDepositBins;
+        std::vector<G4double>                       nofEvents;      // per incident energy bin
+        std::vector<std::vector<G4double> >         matrices;       // per crystal, empty until its first deposit
+        std::vector<std::pair<G4int, G4double> >    eventEnergies;  // the measured energies of the current event per crystal
+    };
+    
+    G4ThreadLocal ResponseMatrices* responseMatrices = 0;
+    
+    ////    The matrices of every thread, registered on their creation and only reduced by the master
+    std::vector<ResponseMatrices*> threadMatrices;
+    
+    ResponseMatrices* GetThreadMatrices()
+    {
+        if(!responseMatrices)
+        {
+            responseMatrices = new ResponseMatrices;
+            responseMatrices->nofIncidentBins = 0;
+            responseMatrices->nofDepositBins = 0;
+            
+            G4AutoLock lock(&responseMatrixMutex);
+            threadMatrices.push_back(responseMatrices);
+        }
+        return responseMatrices;
+    }
+}
+
+G4bool      ResponseMatrix::fActive = false;
+G4double    ResponseMatrix::fIncidentMin = ResponseMatrix_DefaultIncidentMin*keV;
+G4double    ResponseMatrix::fIncidentMax = ResponseMatrix_DefaultIncidentMax*keV;
+G4int       ResponseMatrix::fNofIncidentBins = ResponseMatrix_DefaultIncidentBins;
+G4double    ResponseMatrix::fDepositMax = ResponseMatrix_DefaultDepositMax*keV;
+G4int       ResponseMatrix::fNofDepositBins = ResponseMatrix_DefaultDepositBins;
+G4bool      ResponseMatrix::fUniformInBin = true;
+G4String    ResponseMatrix::fFileName = ResponseMatrix_DefaultFileName;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ResponseMatrix::SetIncidentGrid(G4double min, G4double max, G4int nofBins)
+{
+    if(min < 0. || max <= min || nofBins <= 0)
+    {
+        G4cerr << "ResponseMatrix: invalid incident energy grid, the command is ignored" << G4endl;
+        return;
+    }
+    
+    fIncidentMin = min;
+    fIncidentMax = max;
+    fNofIncidentBins = nofBins;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ResponseMatrix::SetDepositGrid(G4double max, G4int nofBins)
+{
+    if(max <= 0. || nofBins <= 0)
+    {
+        G4cerr << "ResponseMatrix: invalid deposited energy grid, the command is ignored" << G4endl;
+        return;
+    }
+    
+    fDepositMax = max;
+    fNofDepositBins = nofBins;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double ResponseMatrix::GenerateIncidentEnergy(G4int eventID)
+{
+    const G4double binWidth = (fIncidentMax - fIncidentMin)/fNofIncidentBins;
+    return fIncidentMin + (GetIncidentBin(eventID) + (fUniformInBin ? G4UniformRand() : 0.5))*binWidth;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ResponseMatrix::BeginOfRun()
+{
+    if(!fActive) return;
+    
+    G4cout << "\n---> Response matrices of " << fNofIncidentBins << " incident energies from " << fIncidentMin/keV << " to " << fIncidentMax/keV << " keV";
+    G4cout << (fUniformInBin ? ", uniform within their bins" : ", at the centres of their bins");
+    G4cout << ", " << fNofDepositBins << " deposited energies up to " << fDepositMax/keV << " keV";
+    G4cout << ", fired by the particle gun, which must be in its gun mode (/K600/gun/mode gun)" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ResponseMatrix::ScoreEnergy(ResponseArray array, G4int detector, G4int crystal, G4double energy)
+{
+    if(detector < 0 || crystal < 0 || crystal >= arrayCrystals[array] || energy <= 0.) return;
+    if(array == kResponse_NAIS && detector >= numberOf_NAIS) return;
+    if(array == kResponse_LEPS && detector >= numberOf_LEPS) return;
+    
+    GetThreadMatrices()->eventEnergies.push_back(std::make_pair(arrayOffset[array] + detector*arrayCrystals[array] + crystal, energy*keV));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ResponseMatrix::EndOfEvent(G4int eventID, G4double weight)
+{
+    ResponseMatrices* thread = GetThreadMatrices();
+    
+    ////    The matrices of the thread follow the grids of the run
+    if(thread->nofIncidentBins != fNofIncidentBins || thread->nofDepositBins != fNofDepositBins)
+    {
+        thread->nofIncidentBins = fNofIncidentBins;
+        thread->nofDepositBins = fNofDepositBins;
+        thread->nofEvents.assign(fNofIncidentBins, 0.);
+        thread->matrices.assign(numberOfCrystals, std::vector<G4double>());
+    }
+    
+    const G4int incidentBin = GetIncidentBin(eventID);
+    thread->nofEvents[incidentBin] += 1.;
+    
+    for(size_t n=0; n<thread->eventEnergies.size(); n++)
+    {
+        G4int depositBin = (G4int) (thread->eventEnergies[n].second/fDepositMax*fNofDepositBins);
+        if(depositBin >= fNofDepositBins) continue;
+        
+        std::vector<G4double>& matrix = thread->matrices[thread->eventEnergies[n].first];
+        if(matrix.empty()) matrix.assign((size_t) fNofIncidentBins*fNofDepositBins, 0.);
+        
+        matrix[(size_t) incidentBin*fNofDepositBins + depositBin] += weight;
+    }
+    thread->eventEnergies.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ResponseMatrix::WriteMatrices()
+{
+    if(!fActive) return;
+    
+    ////    The worker threads have finished the run, their matrices are reduced and reset without locking
+    const size_t matrixSize = (size_t) fNofIncidentBins*fNofDepositBins;
+    std::vector<G4double> nofEvents(fNofIncidentBins, 0.);
+    std::vector<std::vector<G4double> > matrices(numberOfCrystals);
+    
+    for(size_t t=0; t<threadMatrices.size(); t++)
+    {
+        ResponseMatrices* thread = threadMatrices[t];
+        if(thread->nofIncidentBins != fNofIncidentBins || thread->nofDepositBins != fNofDepositBins) continue;
+        
+        for(G4int i=0; i<fNofIncidentBins; i++) nofEvents[i] += thread->nofEvents[i];
+        thread->nofEvents.assign(fNofIncidentBins, 0.);
+        
+        for(G4int c=0; c<numberOfCrystals; c++)
+        {
+            std::vector<G4double>& matrix = thread->matrices[c];
+            if(matrix.empty()) continue;
+            
+            if(matrices[c].empty()) matrices[c].assign(matrixSize, 0.);
+            for(size_t i=0; i<matrixSize; i++) matrices[c][i] += matrix[i];
+            
+            matrix.assign(matrixSize, 0.);
+        }
+    }
+    
+    ResponseMatrixFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "K600RSPM", 8);
+    header.version = 1;
+    header.nofIncidentBins = fNofIncidentBins;
+    header.nofDepositBins = fNofDepositBins;
+    header.incidentMin = fIncidentMin/keV;
+    header.incidentMax = fIncidentMax/keV;
+    header.depositMax = fDepositMax/keV;
+    for(G4int c=0; c<numberOfCrystals; c++) if(!matrices[c].empty()) header.nofMatrices++;
+    
+    std::ofstream file(fFileName.c_str(), std::ios::binary);
+    if(!file)
+    {
+        G4cerr << "ResponseMatrix: cannot write " << fFileName << G4endl;
+        return;
+    }
+    
+    file.write((const char*) &header, sizeof(header));
+    
+    ////    The matrices are accumulated in double precision and only rounded to single precision as they are written
+    std::vector<float> row(fNofDepositBins);
+    
+    for(G4int c=0; c<numberOfCrystals; c++)
+    {
+        if(matrices[c].empty()) continue;
+        
+        ResponseMatrixRecord record;
+        record.array = c < numberOf_NAIS ? kResponse_NAIS : kResponse_LEPS;
+        record.detector = (c - arrayOffset[record.array])/arrayCrystals[record.array];
+        record.crystal = (c - arrayOffset[record.array])%arrayCrystals[record.array];
+        record.reserved = 0;
+        
+        file.write((const char*) &record, sizeof(record));
+        file.write((const char*) &nofEvents[0], fNofIncidentBins*sizeof(G4double));
+        
+        for(G4int i=0; i<fNofIncidentBins; i++)
+        {
+            const G4double* counts = &matrices[c][(size_t) i*fNofDepositBins];
+            for(G4int j=0; j<fNofDepositBins; j++) row[j] = (float) counts[j];
+            
+            file.write((const char*) &row[0], fNofDepositBins*sizeof(float));
+        }
+    }
+    
+    G4cout << "\n---> Response matrices of " << header.nofMatrices << " crystals written to " << fFileName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
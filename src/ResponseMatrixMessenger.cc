@@ -0,0 +1,148 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "ResponseMatrixMessenger.hh"
+#include "ResponseMatrix.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ResponseMatrixMessenger::ResponseMatrixMessenger()
+: G4UImessenger()
+{
+    fResponseDirectory = new G4UIdirectory("/K600/response/");
+    fResponseDirectory->SetGuidance("Response matrices of the NAIS and LEPS crystals, with the gun mode of the generator");
+    
+    fActiveCmd = new G4UIcmdWithABool("/K600/response/active", this);
+    fActiveCmd->SetGuidance("The particle gun fires the incident energy grid, the response matrices are written at the end of every run");
+    fActiveCmd->SetParameterName("flag", false);
+    fActiveCmd->SetToBeBroadcasted(false);
+    fActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fIncidentGridCmd = new G4UIcommand("/K600/response/incidentGrid", this);
+    fIncidentGridCmd->SetGuidance("Incident energy bins, from min to max");
+    G4UIparameter* parameter = new G4UIparameter("min", 'd', false);
+    parameter->SetParameterRange("min >= 0.");
+    fIncidentGridCmd->SetParameter(parameter);
+    parameter = new G4UIparameter("max", 'd', false);
+    parameter->SetParameterRange("max > 0.");
+    fIncidentGridCmd->SetParameter(parameter);
+    parameter = new G4UIparameter("nofBins", 'i', false);
+    parameter->SetParameterRange("nofBins > 0");
+    fIncidentGridCmd->SetParameter(parameter);
+    parameter = new G4UIparameter("unit", 's', true);
+    parameter->SetDefaultValue("keV");
+    parameter->SetParameterCandidates("eV keV MeV");
+    fIncidentGridCmd->SetParameter(parameter);
+    fIncidentGridCmd->SetToBeBroadcasted(false);
+    fIncidentGridCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fDepositGridCmd = new G4UIcommand("/K600/response/depositGrid", this);
+    fDepositGridCmd->SetGuidance("Deposited energy bins, from 0 to max");
+    parameter = new G4UIparameter("max", 'd', false);
+    parameter->SetParameterRange("max > 0.");
+    fDepositGridCmd->SetParameter(parameter);
+    parameter = new G4UIparameter("nofBins", 'i', false);
+    parameter->SetParameterRange("nofBins > 0");
+    fDepositGridCmd->SetParameter(parameter);
+    parameter = new G4UIparameter("unit", 's', true);
+    parameter->SetDefaultValue("keV");
+    parameter->SetParameterCandidates("eV keV MeV");
+    fDepositGridCmd->SetParameter(parameter);
+    fDepositGridCmd->SetToBeBroadcasted(false);
+    fDepositGridCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fUniformInBinCmd = new G4UIcmdWithABool("/K600/response/uniformInBin", this);
+    fUniformInBinCmd->SetGuidance("Incident energies uniformly distributed within their bins, rather than at their centres");
+    fUniformInBinCmd->SetParameterName("flag", false);
+    fUniformInBinCmd->SetToBeBroadcasted(false);
+    fUniformInBinCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fFileNameCmd = new G4UIcmdWithAString("/K600/response/fileName", this);
+    fFileNameCmd->SetGuidance("The response matrix file, see ResponseMatrix.hh for its format");
+    fFileNameCmd->SetParameterName("fileName", false);
+    fFileNameCmd->SetToBeBroadcasted(false);
+    fFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ResponseMatrixMessenger::~ResponseMatrixMessenger()
+{
+    delete fActiveCmd;
+    delete fIncidentGridCmd;
+    delete fDepositGridCmd;
+    delete fUniformInBinCmd;
+    delete fFileNameCmd;
+    delete fResponseDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ResponseMatrixMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if(command == fActiveCmd) ResponseMatrix::SetActive(fActiveCmd->GetNewBoolValue(newValue));
+    else if(command == fIncidentGridCmd)
+    {
+        G4double min, max;
+        G4int nofBins;
+        G4String unit;
+        std::istringstream values(newValue);
+        values >> min >> max >> nofBins >> unit;
+        ResponseMatrix::SetIncidentGrid(min*G4UIcommand::ValueOf(unit), max*G4UIcommand::ValueOf(unit), nofBins);
+    }
+    else if(command == fDepositGridCmd)
+    {
+        G4double max;
+        G4int nofBins;
+        G4String unit;
+        std::istringstream values(newValue);
+        values >> max >> nofBins >> unit;
+        ResponseMatrix::SetDepositGrid(max*G4UIcommand::ValueOf(unit), nofBins);
+    }
+    else if(command == fUniformInBinCmd) ResponseMatrix::SetUniformInBin(fUniformInBinCmd->GetNewBoolValue(newValue));
+    else if(command == fFileNameCmd) ResponseMatrix::SetFileName(newValue);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
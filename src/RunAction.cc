@@ -35,7 +35,16 @@
 //
 
 #include "RunAction.hh"
+#include "RunAccumulable.hh"
 #include "Analysis.hh"
+#include "TransferMapCalibration.hh"
+#include "RandomSeeding.hh"
+#include "ProgressMonitor.hh"
+#include "StackingAction.hh"
+#include "TimeWindow.hh"
+#include "ImportanceBiasing.hh"
+#include "EfficiencyCurve.hh"
+#include "ResponseMatrix.hh"
 
 #include "G4Run.hh"
 #include "G4RunManager.hh"
@@ -47,8 +56,7 @@
 RunAction::RunAction()
 : G4UserRunAction()
 {
-    // set printing event number per each event
-    G4RunManager::GetRunManager()->SetPrintProgress(1);
+    // The progress is reported at a wall-clock interval by the ProgressMonitor rather than per event
     
     // Create analysis manager
     // The choice of analysis technology is done via selectin of a namespace
@@ -62,6 +70,9 @@ RunAction::RunAction()
     analysisManager->SetVerboseLevel(1);
     //analysisManager->SetFirstHistoId(1);
     
+    // Default output file, which may be changed per run with /analysis/setFileName
+    analysisManager->SetFileName("K600Output");
+    
     // Book histograms, ntuple
     //
     
@@ -258,6 +269,9 @@ RunAction::RunAction()
      //analysisManager->CreateNtupleDColumn("HAGAR_t");
      */
     
+    ////    Statistical weight of the event, unity unless the primary generator is biased
+    fEventWeightColumn[0] = analysisManager->CreateNtupleDColumn(0, "EventWeight");
+    
     analysisManager->FinishNtuple(0);
     
     
@@ -276,6 +290,9 @@ RunAction::RunAction()
     analysisManager->CreateNtupleDColumn(1, "Theta");
     analysisManager->CreateNtupleDColumn(1, "Phi");
     
+    ////    Statistical weight of the event, unity unless the primary generator is biased
+    fEventWeightColumn[1] = analysisManager->CreateNtupleDColumn(1, "EventWeight");
+    
     analysisManager->FinishNtuple(1);
     
     
@@ -290,6 +307,9 @@ RunAction::RunAction()
     analysisManager->CreateNtupleDColumn(2, "ThetaDist");
     analysisManager->CreateNtupleDColumn(2, "PhiDist");
     
+    ////    Statistical weight of the event, unity unless the primary generator is biased
+    fEventWeightColumn[2] = analysisManager->CreateNtupleDColumn(2, "EventWeight");
+    
     analysisManager->FinishNtuple(2);
     
     
@@ -304,8 +324,31 @@ RunAction::~RunAction()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void RunAction::BeginOfRunAction(const G4Run* /*run*/)
+void RunAction::BeginOfRunAction(const G4Run* run)
 {
+    ////    The seeds of the events follow from the run seed, see RandomSeeding.hh
+    if(IsMaster()) RandomSeeding::PrintRunSeed(run->GetRunID());
+    
+    ////    Progress reports, the master holds the totals of the run, every thread counts its own events
+    if(IsMaster()) ProgressMonitor::BeginOfRun(run->GetRunID(), run->GetNumberOfEventToBeProcessed());
+    ProgressMonitor::BeginOfThreadRun();
+    
+    ////    The counters of the run (RunAccumulable.hh), reset by the master before any thread counts
+    if(IsMaster()) RunAccumulableManager::Reset();
+    
+    ////    The time limit of the tracking follows from the detectors present in this run
+    if(IsMaster()) TimeWindow::BeginOfRun();
+    
+    if(IsMaster()) EfficiencyCurve::BeginOfRun();
+    if(IsMaster()) ResponseMatrix::BeginOfRun();
+    
+    ////    The importances of the neutron shielding studies, filled into the importance store of every thread
+    if(ImportanceBiasing_Active)
+    {
+        if(IsMaster()) ImportanceBiasing::BeginOfRun();
+        ImportanceBiasing::BeginOfThreadRun();
+    }
+    
     //inform the runManager to save random number seed
     //G4RunManager::GetRunManager()->SetRandomNumberStore(true);
     
@@ -314,14 +357,27 @@ void RunAction::BeginOfRunAction(const G4Run* /*run*/)
     
     // Open an output file
     //
-    G4String fileName = "K600Output";
-    analysisManager->OpenFile(fileName);
+    analysisManager->OpenFile();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void RunAction::EndOfRunAction(const G4Run* /*run*/)
+void RunAction::EndOfRunAction(const G4Run* run)
 {
+    ProgressMonitor::EndOfThreadRun();
+    if(IsMaster()) ProgressMonitor::EndOfRun(run->GetNumberOfEvent());
+    
+    ////    Every thread merges its counters, the worker threads end their runs before the master, which then reports the merged counters
+    RunAccumulableManager::Merge();
+    
+    if(IsMaster())
+    {
+        StackingAction::PrintCounters();
+        TimeWindow::PrintCounters();
+        EfficiencyCurve::WriteTables();
+        ResponseMatrix::WriteMatrices();
+        if(ImportanceBiasing_Active) ImportanceBiasing::PrintTallies();
+    }
     
     G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
     
@@ -365,6 +421,12 @@ void RunAction::EndOfRunAction(const G4Run* /*run*/)
     analysisManager->Write();
     analysisManager->CloseFile();
     
+    ////    Transfer map calibration, the samples of the workers are merged and the transfer maps are fitted on the master once the workers have finished
+    if(TransferMap_Calibrate)
+    {
+        TransferMapCalibration::Merge();
+        if(IsMaster()) TransferMapCalibration::Fit();
+    }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,201 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "StackingAction.hh"
+#include "StackingMessenger.hh"
+#include "RunAccumulable.hh"
+
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4ParticleTable.hh"
+#include "G4Electron.hh"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
+#include "G4EmCalculator.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace
+{
+    struct StackingCounters
+    {
+        StackingCounters() : nofSecondaries(0)
+        {
+            for(G4int i=0; i<numberOf_StackingKills; i++)
+            {
+                nofKilled[i] = 0;
+                killedEnergy[i] = 0.;
+            }
+        }
+        
+        void Merge(const StackingCounters& other)
+        {
+            nofSecondaries += other.nofSecondaries;
+            for(G4int i=0; i<numberOf_StackingKills; i++)
+            {
+                nofKilled[i] += other.nofKilled[i];
+                killedEnergy[i] += other.killedEnergy[i];
+            }
+        }
+        
+        G4long      nofSecondaries;
+        G4long      nofKilled[numberOf_StackingKills];
+        G4double    killedEnergy[numberOf_StackingKills];
+    };
+    
+    RunAccumulable<StackingCounters> stackingCounters;
+    
+    const char* StackingKillNames[numberOf_StackingKills] = {"particle type", "energy floor", "creation volume", "range"};
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingSettings::StackingSettings()
+: rangeRejection(StackingAction_RangeRejection)
+{
+    if(StackingAction_KillNeutrinos)
+    {
+        const char* neutrinos[] = {"nu_e", "anti_nu_e", "nu_mu", "anti_nu_mu", "nu_tau", "anti_nu_tau"};
+        for(G4int i=0; i<6; i++)
+        {
+            const G4ParticleDefinition* particle = G4ParticleTable::GetParticleTable()->FindParticle(neutrinos[i]);
+            if(particle) killedParticles.insert(particle);
+        }
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingAction::StackingAction()
+: G4UserStackingAction(),
+fMessenger(0),
+fNavigator(0),
+fEmCalculator(new G4EmCalculator)
+{
+    fMessenger = new StackingMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingAction::~StackingAction()
+{
+    delete fMessenger;
+    delete fNavigator;
+    delete fEmCalculator;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+    ////    The primaries are always tracked
+    if(track->GetParentID() == 0) return fUrgent;
+    
+    StackingCounters& counters = stackingCounters.GetLocal();
+    counters.nofSecondaries++;
+    
+    const G4ParticleDefinition* particle = track->GetDefinition();
+    const G4double kineticEnergy = track->GetKineticEnergy();
+    G4int kill = numberOf_StackingKills;
+    
+    ////    The rules, from the cheapest to the most expensive
+    if(fSettings.killedParticles.count(particle)) kill = kKillParticle;
+    
+    if(kill == numberOf_StackingKills && !fSettings.energyFloors.empty())
+    {
+        std::map<const G4ParticleDefinition*, G4double>::const_iterator floor = fSettings.energyFloors.find(particle);
+        if(floor != fSettings.energyFloors.end() && kineticEnergy < floor->second) kill = kKillEnergyFloor;
+    }
+    
+    ////    The touchable of a secondary is that of its point of creation
+    const G4VPhysicalVolume* volume = track->GetVolume();
+    
+    if(kill == numberOf_StackingKills && volume && !fSettings.killedVolumes.empty())
+    {
+        if(fSettings.killedVolumes.count(volume->GetLogicalVolume()->GetName())) kill = kKillCreationVolume;
+    }
+    
+    ////    Range rejection, the electron remains within the volume of its creation, which holds no sensitive detector
+    if(kill == numberOf_StackingKills && volume && fSettings.rangeRejection && particle == G4Electron::Definition())
+    {
+        const G4LogicalVolume* logicalVolume = volume->GetLogicalVolume();
+        if(!logicalVolume->GetSensitiveDetector())
+        {
+            G4double range = fEmCalculator->GetRangeFromRestricteDEDX(kineticEnergy, particle, logicalVolume->GetMaterial());
+            if(range < GetSafety(track->GetPosition())) kill = kKillRange;
+        }
+    }
+    
+    if(kill == numberOf_StackingKills) return fUrgent;
+    
+    counters.nofKilled[kill]++;
+    counters.killedEnergy[kill] += kineticEnergy;
+    return fKill;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double StackingAction::GetSafety(const G4ThreeVector& position)
+{
+    G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+    
+    if(!fNavigator) fNavigator = new G4Navigator;
+    if(fNavigator->GetWorldVolume() != world) fNavigator->SetWorldVolume(world);
+    
+    fNavigator->LocateGlobalPointAndSetup(position, 0, false, true);
+    return fNavigator->ComputeSafety(position);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::PrintCounters()
+{
+    const StackingCounters& counters = stackingCounters.GetMerged();
+    
+    G4long nofKilled = 0;
+    for(G4int i=0; i<numberOf_StackingKills; i++) nofKilled += counters.nofKilled[i];
+    
+    G4cout << "\n---> Stacking: " << nofKilled << " of " << counters.nofSecondaries << " secondaries killed" << G4endl;
+    for(G4int i=0; i<numberOf_StackingKills; i++)
+    {
+        if(counters.nofKilled[i] == 0) continue;
+        G4cout << "     " << StackingKillNames[i] << ": " << counters.nofKilled[i] << " secondaries, " << counters.killedEnergy[i]/MeV << " MeV kinetic energy" << G4endl;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,150 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "StackingMessenger.hh"
+#include "StackingAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4ParticleTable.hh"
+
+#include <sstream>
+
+namespace
+{
+    G4UIcmdWithAString* CreateStringCommand(const char* name, const char* guidance, const char* parameterName, G4UImessenger* messenger)
+    {
+        G4UIcmdWithAString* command = new G4UIcmdWithAString(name, messenger);
+        command->SetGuidance(guidance);
+        command->SetParameterName(parameterName, false);
+        command->AvailableForStates(G4State_PreInit, G4State_Idle);
+        return command;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingMessenger::StackingMessenger(StackingAction* stackingAction)
+: G4UImessenger(),
+fStackingAction(stackingAction)
+{
+    fStackDirectory = new G4UIdirectory("/K600/stack/");
+    fStackDirectory->SetGuidance("Rules of the secondaries which are killed before they are tracked, the primaries are always tracked");
+    
+    fKillParticleCmd = CreateStringCommand("/K600/stack/killParticle", "Kills the secondaries of the given particle type (the neutrinos by default)", "particle", this);
+    fKeepParticleCmd = CreateStringCommand("/K600/stack/keepParticle", "Tracks the secondaries of the given particle type again", "particle", this);
+    
+    fEnergyFloorCmd = new G4UIcommand("/K600/stack/energyFloor", this);
+    fEnergyFloorCmd->SetGuidance("Kills the secondaries of the given particle type below the kinetic-energy floor, 0 removes the floor");
+    fEnergyFloorCmd->SetGuidance("e.g. /K600/stack/energyFloor e- 10 keV, the annihilation photons of killed positrons are lost");
+    fEnergyFloorCmd->SetParameter(new G4UIparameter("particle", 's', false));
+    G4UIparameter* energy = new G4UIparameter("energy", 'd', false);
+    energy->SetParameterRange("energy >= 0.");
+    fEnergyFloorCmd->SetParameter(energy);
+    G4UIparameter* unit = new G4UIparameter("unit", 's', true);
+    unit->SetDefaultValue("keV");
+    unit->SetParameterCandidates("eV keV MeV");
+    fEnergyFloorCmd->SetParameter(unit);
+    fEnergyFloorCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fKillInVolumeCmd = CreateStringCommand("/K600/stack/killInVolume", "Kills all secondaries created within the given logical volume", "logicalVolume", this);
+    fKeepInVolumeCmd = CreateStringCommand("/K600/stack/keepInVolume", "Tracks the secondaries created within the given logical volume again", "logicalVolume", this);
+    
+    fRangeRejectionCmd = new G4UIcmdWithABool("/K600/stack/rangeRejection", this);
+    fRangeRejectionCmd->SetGuidance("Kills the electrons created outside the sensitive volumes whose range is shorter than the distance to the boundary of their volume");
+    fRangeRejectionCmd->SetGuidance("Off by default, the bremsstrahlung of the killed electrons is neglected");
+    fRangeRejectionCmd->SetParameterName("flag", false);
+    fRangeRejectionCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingMessenger::~StackingMessenger()
+{
+    delete fKillParticleCmd;
+    delete fKeepParticleCmd;
+    delete fEnergyFloorCmd;
+    delete fKillInVolumeCmd;
+    delete fKeepInVolumeCmd;
+    delete fRangeRejectionCmd;
+    delete fStackDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    StackingSettings& settings = fStackingAction->GetSettings();
+    G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+    
+    if(command == fKillParticleCmd || command == fKeepParticleCmd)
+    {
+        const G4ParticleDefinition* particle = particleTable->FindParticle(newValue);
+        if(!particle)
+        {
+            G4cerr << "Unknown particle " << newValue << ", the stacking rule is ignored" << G4endl;
+            return;
+        }
+        if(command == fKillParticleCmd) settings.killedParticles.insert(particle);
+        else settings.killedParticles.erase(particle);
+    }
+    else if(command == fEnergyFloorCmd)
+    {
+        G4String particleName, unit;
+        G4double energy;
+        std::istringstream values(newValue);
+        values >> particleName >> energy >> unit;
+        
+        const G4ParticleDefinition* particle = particleTable->FindParticle(particleName);
+        if(!particle)
+        {
+            G4cerr << "Unknown particle " << particleName << ", the stacking rule is ignored" << G4endl;
+            return;
+        }
+        energy *= G4UIcommand::ValueOf(unit);
+        if(energy > 0.) settings.energyFloors[particle] = energy;
+        else settings.energyFloors.erase(particle);
+    }
+    else if(command == fKillInVolumeCmd) settings.killedVolumes.insert(newValue);
+    else if(command == fKeepInVolumeCmd) settings.killedVolumes.erase(newValue);
+    else if(command == fRangeRejectionCmd) settings.rangeRejection = fRangeRejectionCmd->GetNewBoolValue(newValue);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
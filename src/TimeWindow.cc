@@ -0,0 +1,148 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "TimeWindow.hh"
+#include "DetectorConstruction.hh"
+#include "RunAccumulable.hh"
+
+#include "G4RunManager.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cfloat>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+    struct TimeWindowCounters
+    {
+        TimeWindowCounters() : killedEnergy(0.) {}
+        
+        void Merge(const TimeWindowCounters& other)
+        {
+            std::map<const G4ParticleDefinition*, G4long>::const_iterator it;
+            for(it = other.nofKilled.begin(); it != other.nofKilled.end(); it++) nofKilled[it->first] += it->second;
+            killedEnergy += other.killedEnergy;
+        }
+        
+        std::map<const G4ParticleDefinition*, G4long>   nofKilled;
+        G4double                                        killedEnergy;
+    };
+    
+    RunAccumulable<TimeWindowCounters> timeWindowCounters;
+    
+    ////    The particle types with the most killed tracks first
+    G4bool MoreKilled(const std::pair<G4String, G4long>& a, const std::pair<G4String, G4long>& b)
+    {
+        return a.second > b.second;
+    }
+}
+
+G4bool                      TimeWindow::fActive = TimeWindow_DefaultActive;
+G4double                    TimeWindow::fLimit = 0.;
+G4double                    TimeWindow::fRunLimit = DBL_MAX;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TimeWindow::BeginOfRun()
+{
+    fRunLimit = DBL_MAX;
+    
+    if(!fActive) return;
+    
+    if(fLimit > 0.)
+    {
+        fRunLimit = fLimit;
+        G4cout << "\n---> Tracks are killed beyond a global time of " << G4BestUnit(fRunLimit, "Time") << G4endl;
+        return;
+    }
+    
+    const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    G4double longestSampledTime = detector ? detector->GetLongestSampledTime()*ns : 0.;
+    
+    if(longestSampledTime > 0.)
+    {
+        fRunLimit = longestSampledTime;
+        G4cout << "\n---> Tracks are killed beyond a global time of " << G4BestUnit(fRunLimit, "Time") << ", the longest sampled time of the present detectors" << G4endl;
+    }
+    else
+    {
+        G4cout << "\n---> No present detector is sampled in time, the tracks are not killed in time" << G4endl;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TimeWindow::CountKilledTrack(const G4Track& track)
+{
+    TimeWindowCounters& counters = timeWindowCounters.GetLocal();
+    
+    counters.nofKilled[track.GetDefinition()]++;
+    counters.killedEnergy += track.GetKineticEnergy();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TimeWindow::PrintCounters()
+{
+    if(fRunLimit == DBL_MAX) return;
+    
+    const TimeWindowCounters& counters = timeWindowCounters.GetMerged();
+    
+    std::vector<std::pair<G4String, G4long> > nofKilled;
+    std::map<const G4ParticleDefinition*, G4long>::const_iterator it;
+    for(it = counters.nofKilled.begin(); it != counters.nofKilled.end(); it++) nofKilled.push_back(std::make_pair(it->first->GetParticleName(), it->second));
+    
+    std::sort(nofKilled.begin(), nofKilled.end(), MoreKilled);
+    
+    G4long total = 0;
+    for(size_t i=0; i<nofKilled.size(); i++) total += nofKilled[i].second;
+    
+    G4cout << "\n---> Time window: " << total << " tracks killed beyond " << G4BestUnit(fRunLimit, "Time") << ", " << counters.killedEnergy/MeV << " MeV kinetic energy" << G4endl;
+    
+    ////    The ten most frequent particle types
+    for(size_t i=0; i<nofKilled.size() && i<10; i++)
+    {
+        G4cout << "     " << nofKilled[i].first << ": " << nofKilled[i].second << G4endl;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,86 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "TimeWindowMessenger.hh"
+#include "TimeWindow.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TimeWindowMessenger::TimeWindowMessenger()
+: G4UImessenger()
+{
+    fTimeWindowDirectory = new G4UIdirectory("/K600/timeWindow/");
+    fTimeWindowDirectory->SetGuidance("Kills the tracks beyond the longest sampled time of the present detectors");
+    
+    fActiveCmd = new G4UIcmdWithABool("/K600/timeWindow/active", this);
+    fActiveCmd->SetGuidance("Kills the tracks beyond the time limit");
+    fActiveCmd->SetParameterName("flag", false);
+    fActiveCmd->SetToBeBroadcasted(false);
+    fActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    
+    fLimitCmd = new G4UIcmdWithADoubleAndUnit("/K600/timeWindow/limit", this);
+    fLimitCmd->SetGuidance("Fixed limit of the global time, 0 for the longest sampled time of the present detectors");
+    fLimitCmd->SetParameterName("limit", false);
+    fLimitCmd->SetRange("limit >= 0.");
+    fLimitCmd->SetUnitCategory("Time");
+    fLimitCmd->SetDefaultUnit("us");
+    fLimitCmd->SetToBeBroadcasted(false);
+    fLimitCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TimeWindowMessenger::~TimeWindowMessenger()
+{
+    delete fActiveCmd;
+    delete fLimitCmd;
+    delete fTimeWindowDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TimeWindowMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if(command == fActiveCmd) TimeWindow::SetActive(fActiveCmd->GetNewBoolValue(newValue));
+    else if(command == fLimitCmd) TimeWindow::SetLimit(fLimitCmd->GetNewDoubleValue(newValue));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
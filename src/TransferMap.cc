@@ -0,0 +1,442 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "TransferMap.hh"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace
+{
+    const char* const TransferMap_MagnetNames[numberOf_TransferMapMagnets] = {"K600_Quadrupole", "K600_Dipole1", "K600_Dipole2"};
+    
+    const char* const TransferMap_FileHeader = "K600 transfer map";
+    
+    ////    The relative ridge of the least squares fit, the direction components (and the coordinates of a slanted entrance face) are linearly dependent
+    const G4double TransferMap_Ridge = 1.e-9;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TransferMap::TransferMap(G4int order)
+: fOrder(order)
+{
+    if(fOrder < 1) fOrder = 1;
+    if(fOrder > TransferMap_MaxOrder) fOrder = TransferMap_MaxOrder;
+    
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++)
+    {
+        fMinimum[i] = 0.;
+        fMaximum[i] = 0.;
+        fCentre[i] = 0.;
+        fNormalisation[i] = 0.;
+        fTolerance[i] = 0.;
+    }
+    
+    for(G4int i=0; i<numberOf_TransferMapOutputs; i++)
+    {
+        fResidual[i] = 0.;
+    }
+    
+    BuildTerms();
+    fCoefficients.assign(GetNumberOfTerms()*numberOf_TransferMapOutputs, 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TransferMap::~TransferMap()
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMap::GetInputs(const G4ThreeVector& localPosition, const G4ThreeVector& localDirection, G4double momentum, G4double charge, G4double* inputs)
+{
+    inputs[0] = localPosition.x();
+    inputs[1] = localPosition.y();
+    inputs[2] = localPosition.z();
+    inputs[3] = localDirection.x();
+    inputs[4] = localDirection.y();
+    inputs[5] = localDirection.z();
+    inputs[6] = momentum/charge;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String TransferMap::GetFileName(G4int magnet)
+{
+    return G4String("TransferMap_") + TransferMap_MagnetNames[magnet] + ".map";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMap::BuildTerms()
+{
+    ////    All the monomials of the inputs up to the total order, in lexicographic order of their exponents
+    G4int exponents[numberOf_TransferMapInputs] = {0};
+    
+    fExponents.clear();
+    
+    while(true)
+    {
+        G4int degree = 0;
+        for(G4int i=0; i<numberOf_TransferMapInputs; i++) degree += exponents[i];
+        
+        if(degree <= fOrder) fExponents.insert(fExponents.end(), exponents, exponents + numberOf_TransferMapInputs);
+        
+        G4int i = numberOf_TransferMapInputs - 1;
+        while(i >= 0 && exponents[i] == fOrder)
+        {
+            exponents[i] = 0;
+            i--;
+        }
+        if(i < 0) break;
+        exponents[i]++;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMap::SetBounds(const G4double* minimum, const G4double* maximum)
+{
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++)
+    {
+        fMinimum[i] = minimum[i];
+        fMaximum[i] = maximum[i];
+        fCentre[i] = 0.5*(minimum[i] + maximum[i]);
+        fTolerance[i] = 1.e-9*(1. + std::fabs(minimum[i]) + std::fabs(maximum[i]));
+        
+        ////    An input which is constant over the fitted phase space is dropped
+        G4double range = maximum[i] - minimum[i];
+        fNormalisation[i] = (range > fTolerance[i]) ? 2./range : 0.;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMap::EvaluateTerms(const G4double* inputs, G4double* terms) const
+{
+    G4double powers[numberOf_TransferMapInputs][TransferMap_MaxOrder+1];
+    
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++)
+    {
+        G4double u = (inputs[i] - fCentre[i])*fNormalisation[i];
+        
+        powers[i][0] = 1.;
+        for(G4int k=1; k<=fOrder; k++) powers[i][k] = powers[i][k-1]*u;
+    }
+    
+    const G4int nofTerms = GetNumberOfTerms();
+    const G4int* exponents = &fExponents[0];
+    
+    for(G4int t=0; t<nofTerms; t++, exponents += numberOf_TransferMapInputs)
+    {
+        G4double term = 1.;
+        for(G4int i=0; i<numberOf_TransferMapInputs; i++) term *= powers[i][exponents[i]];
+        terms[t] = term;
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool TransferMap::IsInside(const G4double* inputs) const
+{
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++)
+    {
+        if(inputs[i] < fMinimum[i] - fTolerance[i] || inputs[i] > fMaximum[i] + fTolerance[i]) return false;
+    }
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMap::Evaluate(const G4double* inputs, G4double* outputs) const
+{
+    G4double terms[TransferMap_MaxNumberOfTerms];
+    EvaluateTerms(inputs, terms);
+    
+    for(G4int o=0; o<numberOf_TransferMapOutputs; o++) outputs[o] = 0.;
+    
+    const G4int nofTerms = GetNumberOfTerms();
+    const G4double* coefficients = &fCoefficients[0];
+    
+    for(G4int t=0; t<nofTerms; t++, coefficients += numberOf_TransferMapOutputs)
+    {
+        for(G4int o=0; o<numberOf_TransferMapOutputs; o++) outputs[o] += terms[t]*coefficients[o];
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool TransferMap::Fit(const std::vector<G4double>& samples)
+{
+    const G4int rowSize = numberOf_TransferMapInputs + numberOf_TransferMapOutputs;
+    const G4int nofSamples = (G4int) samples.size()/rowSize;
+    const G4int nofTerms = GetNumberOfTerms();
+    
+    if(nofSamples < 2*nofTerms)
+    {
+        G4cout << "TransferMap: " << nofSamples << " calibration samples are too few for the " << nofTerms << " terms of an order " << fOrder << " transfer map" << G4endl;
+        return false;
+    }
+    
+    ////    The fitted phase space
+    G4double minimum[numberOf_TransferMapInputs], maximum[numberOf_TransferMapInputs];
+    
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++)
+    {
+        minimum[i] = maximum[i] = samples[i];
+    }
+    
+    for(G4int s=1; s<nofSamples; s++)
+    {
+        const G4double* row = &samples[s*rowSize];
+        for(G4int i=0; i<numberOf_TransferMapInputs; i++)
+        {
+            if(row[i] < minimum[i]) minimum[i] = row[i];
+            if(row[i] > maximum[i]) maximum[i] = row[i];
+        }
+    }
+    
+    SetBounds(minimum, maximum);
+    
+    ////    Normal equations, only the lower triangle of the symmetric matrix is accumulated
+    std::vector<G4double> normal(nofTerms*nofTerms, 0.);
+    std::vector<G4double> projection(nofTerms*numberOf_TransferMapOutputs, 0.);
+    std::vector<G4double> terms(nofTerms);
+    
+    for(G4int s=0; s<nofSamples; s++)
+    {
+        const G4double* row = &samples[s*rowSize];
+        EvaluateTerms(row, &terms[0]);
+        
+        for(G4int i=0; i<nofTerms; i++)
+        {
+            G4double ti = terms[i];
+            if(ti == 0.) continue;
+            
+            G4double* normalRow = &normal[i*nofTerms];
+            for(G4int j=0; j<=i; j++) normalRow[j] += ti*terms[j];
+            
+            for(G4int o=0; o<numberOf_TransferMapOutputs; o++) projection[i*numberOf_TransferMapOutputs + o] += ti*row[numberOf_TransferMapInputs + o];
+        }
+    }
+    
+    ////    The ridge also keeps the terms of the dropped inputs, which vanish over the whole sample, at zero
+    G4double maximumDiagonal = 0.;
+    for(G4int i=0; i<nofTerms; i++)
+    {
+        if(normal[i*nofTerms + i] > maximumDiagonal) maximumDiagonal = normal[i*nofTerms + i];
+    }
+    
+    for(G4int i=0; i<nofTerms; i++)
+    {
+        normal[i*nofTerms + i] += TransferMap_Ridge*maximumDiagonal;
+    }
+    
+    ////    Cholesky decomposition, in place within the lower triangle
+    for(G4int j=0; j<nofTerms; j++)
+    {
+        G4double diagonal = normal[j*nofTerms + j];
+        for(G4int k=0; k<j; k++) diagonal -= normal[j*nofTerms + k]*normal[j*nofTerms + k];
+        
+        if(diagonal <= 0.)
+        {
+            G4cout << "TransferMap: the normal equations of the fit are singular" << G4endl;
+            return false;
+        }
+        
+        diagonal = std::sqrt(diagonal);
+        normal[j*nofTerms + j] = diagonal;
+        
+        for(G4int i=j+1; i<nofTerms; i++)
+        {
+            G4double value = normal[i*nofTerms + j];
+            for(G4int k=0; k<j; k++) value -= normal[i*nofTerms + k]*normal[j*nofTerms + k];
+            normal[i*nofTerms + j] = value/diagonal;
+        }
+    }
+    
+    ////    Forward and back substitution, for every output
+    for(G4int o=0; o<numberOf_TransferMapOutputs; o++)
+    {
+        std::vector<G4double> solution(nofTerms);
+        
+        for(G4int i=0; i<nofTerms; i++)
+        {
+            G4double value = projection[i*numberOf_TransferMapOutputs + o];
+            for(G4int k=0; k<i; k++) value -= normal[i*nofTerms + k]*solution[k];
+            solution[i] = value/normal[i*nofTerms + i];
+        }
+        
+        for(G4int i=nofTerms-1; i>=0; i--)
+        {
+            G4double value = solution[i];
+            for(G4int k=i+1; k<nofTerms; k++) value -= normal[k*nofTerms + i]*solution[k];
+            solution[i] = value/normal[i*nofTerms + i];
+        }
+        
+        for(G4int i=0; i<nofTerms; i++) fCoefficients[i*numberOf_TransferMapOutputs + o] = solution[i];
+    }
+    
+    ////    RMS residuals of the fit
+    G4double outputs[numberOf_TransferMapOutputs];
+    
+    for(G4int o=0; o<numberOf_TransferMapOutputs; o++) fResidual[o] = 0.;
+    
+    for(G4int s=0; s<nofSamples; s++)
+    {
+        const G4double* row = &samples[s*rowSize];
+        Evaluate(row, outputs);
+        
+        for(G4int o=0; o<numberOf_TransferMapOutputs; o++)
+        {
+            G4double residual = outputs[o] - row[numberOf_TransferMapInputs + o];
+            fResidual[o] += residual*residual;
+        }
+    }
+    
+    for(G4int o=0; o<numberOf_TransferMapOutputs; o++) fResidual[o] = std::sqrt(fResidual[o]/nofSamples);
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool TransferMap::Write(const G4String& fileName, const G4String& setting) const
+{
+    std::ofstream file(fileName.c_str());
+    if(!file.good()) return false;
+    
+    file << std::setprecision(17);
+    file << TransferMap_FileHeader << "\n";
+    file << "setting " << setting << "\n";
+    file << "order " << fOrder << " terms " << GetNumberOfTerms() << "\n";
+    
+    file << "minimum";
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++) file << " " << fMinimum[i];
+    file << "\nmaximum";
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++) file << " " << fMaximum[i];
+    file << "\nresidual";
+    for(G4int o=0; o<numberOf_TransferMapOutputs; o++) file << " " << fResidual[o];
+    file << "\n";
+    
+    ////    One term per line, its exponents followed by its coefficients
+    for(G4int t=0; t<GetNumberOfTerms(); t++)
+    {
+        for(G4int i=0; i<numberOf_TransferMapInputs; i++) file << fExponents[t*numberOf_TransferMapInputs + i] << " ";
+        for(G4int o=0; o<numberOf_TransferMapOutputs; o++) file << " " << fCoefficients[t*numberOf_TransferMapOutputs + o];
+        file << "\n";
+    }
+    
+    return file.good();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TransferMap* TransferMap::Read(const G4String& fileName, const G4String& setting)
+{
+    std::ifstream file(fileName.c_str());
+    if(!file.good()) return 0;
+    
+    std::string line;
+    std::getline(file, line);
+    
+    if(line != TransferMap_FileHeader)
+    {
+        G4ExceptionDescription msg;
+        msg << fileName << " is not a transfer map, the magnet is tracked in full.";
+        G4Exception("TransferMap::Read()", "K600TransferMap001", JustWarning, msg);
+        return 0;
+    }
+    
+    ////    A transfer map fitted for another setting of the magnet is stale
+    std::getline(file, line);
+    
+    if(line != "setting " + setting)
+    {
+        G4ExceptionDescription msg;
+        msg << fileName << " was fitted for another magnet setting (" << line << "), the magnet is tracked in full." << G4endl;
+        msg << "Repeat the calibration run for the current setting: " << setting;
+        G4Exception("TransferMap::Read()", "K600TransferMap002", JustWarning, msg);
+        return 0;
+    }
+    
+    std::string keyword;
+    G4int order = 0, nofTerms = 0;
+    file >> keyword >> order >> keyword >> nofTerms;
+    
+    TransferMap* map = new TransferMap(order);
+    G4bool isValid = (map->GetOrder() == order && map->GetNumberOfTerms() == nofTerms);
+    
+    G4double minimum[numberOf_TransferMapInputs], maximum[numberOf_TransferMapInputs];
+    
+    file >> keyword;
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++) file >> minimum[i];
+    file >> keyword;
+    for(G4int i=0; i<numberOf_TransferMapInputs; i++) file >> maximum[i];
+    file >> keyword;
+    for(G4int o=0; o<numberOf_TransferMapOutputs; o++) file >> map->fResidual[o];
+    
+    for(G4int t=0; isValid && t<nofTerms; t++)
+    {
+        for(G4int i=0; i<numberOf_TransferMapInputs; i++)
+        {
+            G4int exponent = -1;
+            file >> exponent;
+            if(exponent != map->fExponents[t*numberOf_TransferMapInputs + i]) isValid = false;
+        }
+        for(G4int o=0; o<numberOf_TransferMapOutputs; o++) file >> map->fCoefficients[t*numberOf_TransferMapOutputs + o];
+    }
+    
+    if(!isValid || file.fail())
+    {
+        delete map;
+        
+        G4ExceptionDescription msg;
+        msg << fileName << " is corrupt, the magnet is tracked in full.";
+        G4Exception("TransferMap::Read()", "K600TransferMap003", JustWarning, msg);
+        return 0;
+    }
+    
+    map->SetBounds(minimum, maximum);
+    
+    return map;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
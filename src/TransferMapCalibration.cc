@@ -0,0 +1,187 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "TransferMapCalibration.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4TouchableHistory.hh"
+#include "G4AffineTransform.hh"
+#include "G4AutoLock.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace
+{
+    G4Mutex transferMapCalibrationMutex = G4MUTEX_INITIALIZER;
+    
+    ////    The entrance of the track currently traversing a magnet, secondaries are only tracked once their parent has left the magnet
+    struct TransferMapEntrance
+    {
+        G4int       trackID;
+        G4double    trackLength;
+        G4double    inputs[numberOf_TransferMapInputs];
+    };
+    
+    struct TransferMapThreadData
+    {
+        TransferMapEntrance     entrance[numberOf_TransferMapMagnets];
+        std::vector<G4double>   samples[numberOf_TransferMapMagnets];
+    };
+    
+    G4ThreadLocal TransferMapThreadData* transferMapThreadData = 0;
+    
+    TransferMapThreadData* GetThreadData()
+    {
+        if(!transferMapThreadData)
+        {
+            transferMapThreadData = new TransferMapThreadData;
+            for(G4int i=0; i<numberOf_TransferMapMagnets; i++) transferMapThreadData->entrance[i].trackID = -1;
+        }
+        return transferMapThreadData;
+    }
+}
+
+G4String                TransferMapCalibration::fMagnetSetting[numberOf_TransferMapMagnets];
+std::vector<G4double>   TransferMapCalibration::fSamples[numberOf_TransferMapMagnets];
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMapCalibration::SetMagnetSetting(G4int magnet, const G4String& setting)
+{
+    fMagnetSetting[magnet] = setting;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const G4String& TransferMapCalibration::GetMagnetSetting(G4int magnet)
+{
+    return fMagnetSetting[magnet];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMapCalibration::RecordEntrance(G4int magnet, const G4Step* step)
+{
+    const G4StepPoint* preStepPoint = step->GetPreStepPoint();
+    G4double charge = preStepPoint->GetCharge();
+    if(charge == 0.) return;
+    
+    const G4AffineTransform& transform = preStepPoint->GetTouchableHandle()->GetHistory()->GetTopTransform();
+    
+    TransferMapEntrance& entrance = GetThreadData()->entrance[magnet];
+    entrance.trackID = step->GetTrack()->GetTrackID();
+    entrance.trackLength = step->GetTrack()->GetTrackLength() - step->GetStepLength();
+    
+    TransferMap::GetInputs(transform.TransformPoint(preStepPoint->GetPosition()), transform.TransformAxis(preStepPoint->GetMomentumDirection()), preStepPoint->GetMomentum().mag(), charge, entrance.inputs);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMapCalibration::RecordExit(G4int magnet, const G4Step* step)
+{
+    TransferMapThreadData* data = GetThreadData();
+    TransferMapEntrance& entrance = data->entrance[magnet];
+    
+    if(entrance.trackID != step->GetTrack()->GetTrackID()) return;
+    entrance.trackID = -1;
+    
+    ////    The post-step point lies within the next volume, the exit is expressed in the frame of the magnet
+    const G4AffineTransform& transform = step->GetPreStepPoint()->GetTouchableHandle()->GetHistory()->GetTopTransform();
+    const G4StepPoint* postStepPoint = step->GetPostStepPoint();
+    
+    G4ThreeVector position = transform.TransformPoint(postStepPoint->GetPosition());
+    G4ThreeVector direction = transform.TransformAxis(postStepPoint->GetMomentumDirection());
+    
+    std::vector<G4double>& samples = data->samples[magnet];
+    samples.insert(samples.end(), entrance.inputs, entrance.inputs + numberOf_TransferMapInputs);
+    samples.push_back(position.x());
+    samples.push_back(position.y());
+    samples.push_back(position.z());
+    samples.push_back(direction.x());
+    samples.push_back(direction.y());
+    samples.push_back(direction.z());
+    samples.push_back(step->GetTrack()->GetTrackLength() - entrance.trackLength);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMapCalibration::Merge()
+{
+    if(!transferMapThreadData) return;
+    
+    G4AutoLock lock(&transferMapCalibrationMutex);
+    
+    for(G4int i=0; i<numberOf_TransferMapMagnets; i++)
+    {
+        std::vector<G4double>& samples = transferMapThreadData->samples[i];
+        fSamples[i].insert(fSamples[i].end(), samples.begin(), samples.end());
+        std::vector<G4double>().swap(samples);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMapCalibration::Fit()
+{
+    G4AutoLock lock(&transferMapCalibrationMutex);
+    
+    const G4int rowSize = numberOf_TransferMapInputs + numberOf_TransferMapOutputs;
+    
+    for(G4int i=0; i<numberOf_TransferMapMagnets; i++)
+    {
+        if(fSamples[i].empty()) continue;
+        
+        G4String fileName = TransferMap::GetFileName(i);
+        TransferMap transferMap(TransferMap_Order);
+        
+        G4cout << "\n---> Fitting the order " << transferMap.GetOrder() << " transfer map " << fileName << " to " << fSamples[i].size()/rowSize << " samples" << G4endl;
+        
+        if(transferMap.Fit(fSamples[i]) && transferMap.Write(fileName, fMagnetSetting[i]))
+        {
+            G4cout << "     RMS residuals, exit position (mm): " << transferMap.GetResidual(0)/mm << " " << transferMap.GetResidual(1)/mm << " " << transferMap.GetResidual(2)/mm
+            << ", exit direction: " << transferMap.GetResidual(3) << " " << transferMap.GetResidual(4) << " " << transferMap.GetResidual(5)
+            << ", path length (mm): " << transferMap.GetResidual(6)/mm << G4endl;
+        }
+        else
+        {
+            G4cout << "     The transfer map " << fileName << " was not written" << G4endl;
+        }
+        
+        std::vector<G4double>().swap(fSamples[i]);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
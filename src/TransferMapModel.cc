@@ -0,0 +1,136 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "TransferMapModel.hh"
+#include "TransferMap.hh"
+
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4VSolid.hh"
+#include "G4ParticleDefinition.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TransferMapModel::TransferMapModel(const G4String& name, G4Region* envelope, const TransferMap* transferMap)
+: G4VFastSimulationModel(name, envelope),
+fTransferMap(transferMap),
+fPathLength(0.)
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TransferMapModel::~TransferMapModel()
+{
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool TransferMapModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+    return particle.GetPDGCharge() != 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool TransferMapModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+    const G4Track* track = fastTrack.GetPrimaryTrack();
+    
+    ////    Only a particle which has just entered the envelope is transported by the map
+    const G4Step* step = track->GetStep();
+    if(!step || step->GetPostStepPoint()->GetStepStatus() != fGeomBoundary || fastTrack.OnTheBoundaryButExiting()) return false;
+    
+    G4double charge = track->GetDynamicParticle()->GetCharge();
+    if(charge == 0.) return false;
+    
+    G4double inputs[numberOf_TransferMapInputs];
+    TransferMap::GetInputs(fastTrack.GetPrimaryTrackLocalPosition(), fastTrack.GetPrimaryTrackLocalDirection(), track->GetMomentum().mag(), charge, inputs);
+    
+    if(!fTransferMap->IsInside(inputs)) return false;
+    
+    G4double outputs[numberOf_TransferMapOutputs];
+    fTransferMap->Evaluate(inputs, outputs);
+    
+    fExitPosition = G4ThreeVector(outputs[0], outputs[1], outputs[2]);
+    fExitDirection = G4ThreeVector(outputs[3], outputs[4], outputs[5]);
+    fPathLength = outputs[6];
+    
+    if(fExitDirection.mag2() == 0. || fPathLength <= 0.) return false;
+    fExitDirection = fExitDirection.unit();
+    
+    ////    The fitted exit point is moved onto the envelope surface along the exit direction
+    const G4VSolid* envelope = fastTrack.GetEnvelopeSolid();
+    EInside inside = envelope->Inside(fExitPosition);
+    
+    if(inside == kInside)
+    {
+        G4double distance = envelope->DistanceToOut(fExitPosition, fExitDirection);
+        fExitPosition += distance*fExitDirection;
+        fPathLength += distance;
+    }
+    else if(inside == kOutside)
+    {
+        G4double distance = envelope->DistanceToIn(fExitPosition, -fExitDirection);
+        if(distance == kInfinity || distance >= fPathLength) return false;
+        
+        fExitPosition -= distance*fExitDirection;
+        fPathLength -= distance;
+    }
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TransferMapModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+    const G4Track* track = fastTrack.GetPrimaryTrack();
+    const G4DynamicParticle* particle = track->GetDynamicParticle();
+    
+    ////    The magnets are evacuated and static, the kinetic energy is conserved
+    G4double flightTime = fPathLength/track->GetVelocity();
+    
+    fastStep.ProposePrimaryTrackFinalPosition(fExitPosition, true);
+    fastStep.ProposePrimaryTrackFinalMomentumDirection(fExitDirection, true);
+    fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + flightTime);
+    fastStep.ProposePrimaryTrackFinalProperTime(track->GetProperTime() + flightTime*particle->GetMass()/particle->GetTotalEnergy());
+    fastStep.ProposePrimaryTrackPathLength(fPathLength);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
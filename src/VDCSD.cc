@@ -0,0 +1,204 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "VDCSD.hh"
+#include "EventAction.hh"
+
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
+#include "G4SDManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4LogicalVolume.hh"
+
+#include <cmath>
+
+////    Drift cell geometry of the U wireplanes, evaluated once rather than per step
+static const G4double   VDC_U_inverseCellWidth = 1./abs(xShift);
+static const G4double   VDC_U_xOffsetGradient = -(1/tan(50));
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+VDCSD::VDCSD(const G4String& name, const G4String& hitsCollectionName, const G4String& traverseHitsCollectionName)
+: G4VSensitiveDetector(name),
+fHitsCollection(0),
+fTraverseHitsCollection(0),
+fHitIndex(numberOf_VDC_Channels, -1)
+{
+    collectionName.insert(hitsCollectionName);
+    collectionName.insert(traverseHitsCollectionName);
+    
+    for(G4int i=0; i<4; i++) fTraverseHit[i] = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+VDCSD::~VDCSD()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VDCSD::Initialize(G4HCofThisEvent* hce)
+{
+    // Create hits collections
+    fHitsCollection = new VDCHitsCollection(SensitiveDetectorName, collectionName[0]);
+    fTraverseHitsCollection = new VDCTraverseHitsCollection(SensitiveDetectorName, collectionName[1]);
+    
+    // Add these collections in hce
+    G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+    hce->AddHitsCollection(sdManager->GetCollectionID(collectionName[0]), fHitsCollection);
+    hce->AddHitsCollection(sdManager->GetCollectionID(collectionName[1]), fTraverseHitsCollection);
+    
+    for(G4int i=0; i<4; i++) fTraverseHit[i] = 0;
+    
+    // Reset the wire channels which were hit within the previous event
+    for(size_t i=0; i<fTouchedChannels.size(); i++) fHitIndex[fTouchedChannels[i]] = -1;
+    fTouchedChannels.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool VDCSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+    G4StepPoint* preStepPoint = step->GetPreStepPoint();
+    
+    G4double interactiontime = preStepPoint->GetGlobalTime()/ns;
+    if(interactiontime >= VDC_TotalSampledTime) return false;
+    
+    G4TouchableHandle theTouchable = preStepPoint->GetTouchableHandle();
+    
+    ////    The sense region is the mother of a wireplane volume
+    G4int depth = IsWireplaneVolume(theTouchable->GetVolume()->GetLogicalVolume()) ? 1 : 0;
+    
+    G4int WireChamberNo = theTouchable->GetCopyNumber(depth);
+    G4double edepVDC = step->GetTotalEnergyDeposit()/keV;
+    
+    G4ThreeVector localPosition = theTouchable->GetHistory()->GetTransform(theTouchable->GetHistoryDepth() - depth).TransformPoint(preStepPoint->GetPosition());
+    
+    G4double xPosL = localPosition.x()/mm;
+    G4double yPosL = localPosition.y()/mm;
+    G4double zPosL = 0.;
+    
+    G4int channelID = -1;
+    
+    //  X WireChamber
+    if( (WireChamberNo==0) || (WireChamberNo==2) )
+    {
+        zPosL = localPosition.z()/mm + 4.0;
+        
+        if(abs(zPosL)<=8)
+        {
+            ////    The cell for which (-99+cellNo)*4 < xPosL <= (-98+cellNo)*4
+            G4int cellNo = G4int(std::ceil(xPosL/4.)) + 98;
+            
+            if(cellNo>=0 && cellNo<198)
+            {
+                if(WireChamberNo==0) channelID = cellNo;
+                if(WireChamberNo==2) channelID = cellNo + 341;
+            }
+        }
+    }
+    
+    //  U WireChamber
+    if( (WireChamberNo==1) || (WireChamberNo==3) )
+    {
+        zPosL = localPosition.z()/mm - 4.0;
+        
+        if(abs(zPosL)<=8)
+        {
+            G4double xOffset = VDC_U_xOffsetGradient*yPosL;
+            
+            ////    The cell for which (-71.5+cellNo)*abs(xShift) + xOffset < xPosL <= (-70.5+cellNo)*abs(xShift) + xOffset
+            G4int cellNo = G4int(std::ceil((xPosL - xOffset)*VDC_U_inverseCellWidth + 0.5)) + 70;
+            
+            if(cellNo>=0 && cellNo<143)
+            {
+                if(WireChamberNo==1) channelID = cellNo + 198;
+                if(WireChamberNo==3) channelID = cellNo + 539;
+            }
+        }
+    }
+    
+    if(channelID >= 0) FillHit(channelID, edepVDC, edepVDC*zPosL, edepVDC*interactiontime);
+    
+    ////    Wireplane traversal of the primary particle
+    if(step->GetTrack()->GetParentID()==0)
+    {
+        if(!fTraverseHit[WireChamberNo])
+        {
+            fTraverseHit[WireChamberNo] = new VDCTraverseHit(WireChamberNo);
+            fTraverseHitsCollection->insert(fTraverseHit[WireChamberNo]);
+        }
+        
+        G4ThreeVector position(xPosL, yPosL, zPosL);
+        
+        ////    The PRE-point
+        if(zPosL<0.) fTraverseHit[WireChamberNo]->SetPREPosition(position);
+        
+        ////    The POST-point
+        if(zPosL>0. && !fTraverseHit[WireChamberNo]->HasPOST()) fTraverseHit[WireChamberNo]->SetPOSTPosition(position);
+    }
+    
+    return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VDCSD::FillHit(G4int channelID, G4double edep, G4double EW_zpos, G4double EW_t)
+{
+    if(fHitIndex[channelID] < 0)
+    {
+        if(fHitsCollection->entries() >= hit_buffersize) return;
+        
+        fHitIndex[channelID] = fHitsCollection->insert(new VDCHit(channelID)) - 1;
+        fTouchedChannels.push_back(channelID);
+    }
+    
+    (*fHitsCollection)[fHitIndex[channelID]]->Add(edep, EW_zpos, EW_t);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool VDCSD::IsWireplaneVolume(const G4LogicalVolume* volume) const
+{
+    for(size_t i=0; i<fWireplaneVolumes.size(); i++)
+    {
+        if(fWireplaneVolumes[i] == volume) return true;
+    }
+    
+    return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,132 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+#include "VDCWireplaneParameterisation.hh"
+
+#include "G4VPhysicalVolume.hh"
+#include "G4Tubs.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+
+////    Wire radii
+static const G4double   VDC_SignalWire_Radius = 20.*um;
+static const G4double   VDC_GuardWire_Radius = 50.*um;
+static const G4double   VDC_GuardWireThick_Radius = 100.*um;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+VDCWireplaneParameterisation::VDCWireplaneParameterisation(G4int nofSignalWires,
+                                                           G4double signalWirePitch,
+                                                           const G4RotationMatrix& wireRotation,
+                                                           G4double wireHalfLength,
+                                                           G4double windowHalfX,
+                                                           G4double windowHalfY)
+: G4VPVParameterisation(),
+fRotation(new G4RotationMatrix(wireRotation.inverse()))
+{
+    ////    Thick guard wire, then alternating guard and signal wires, ending with a guard and a thick guard wire
+    G4int nofWires = 2*nofSignalWires + 3;
+    
+    ////    Direction of the wire axis within the wireplane
+    G4ThreeVector wireAxis = wireRotation*G4ThreeVector(0., 0., 1.);
+    
+    for(G4int n=0; n<nofWires; n++)
+    {
+        G4double radius;
+        
+        if(n==0 || n==nofWires-1) radius = VDC_GuardWireThick_Radius;
+        else if(n%2==1) radius = VDC_GuardWire_Radius;
+        else radius = VDC_SignalWire_Radius;
+        
+        G4ThreeVector centre((n - (nofSignalWires + 1))*signalWirePitch/2., 0., 0.);
+        
+        ////    The wire axis, centre + t*wireAxis for |t| <= wireHalfLength, is clipped to the wire window.
+        ////    The window is reduced by the extent of the end faces of the wire, which keeps each wire within the wireplane volume
+        G4double tMin = -wireHalfLength;
+        G4double tMax = wireHalfLength;
+        
+        ClipAxis(centre.x(), wireAxis.x(), windowHalfX - radius*std::sqrt(std::max(0., 1. - wireAxis.x()*wireAxis.x())), tMin, tMax);
+        ClipAxis(centre.y(), wireAxis.y(), windowHalfY - radius*std::sqrt(std::max(0., 1. - wireAxis.y()*wireAxis.y())), tMin, tMax);
+        
+        fPosition.push_back(centre + 0.5*(tMin + tMax)*wireAxis);
+        fHalfLength.push_back(0.5*(tMax - tMin));
+        fRadius.push_back(radius);
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+VDCWireplaneParameterisation::~VDCWireplaneParameterisation()
+{
+    delete fRotation;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VDCWireplaneParameterisation::ComputeTransformation(const G4int copyNo, G4VPhysicalVolume* physVol) const
+{
+    physVol->SetTranslation(fPosition[copyNo]);
+    physVol->SetRotation(fRotation);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VDCWireplaneParameterisation::ComputeDimensions(G4Tubs& wire, const G4int copyNo, const G4VPhysicalVolume*) const
+{
+    wire.SetInnerRadius(0.);
+    wire.SetOuterRadius(fRadius[copyNo]);
+    wire.SetZHalfLength(fHalfLength[copyNo]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void VDCWireplaneParameterisation::ClipAxis(G4double x0, G4double u, G4double halfWidth, G4double& tMin, G4double& tMax)
+{
+    ////    A wire parallel to this boundary is not clipped by it
+    if(std::abs(u) < 1.e-9) return;
+    
+    G4double t1 = (-halfWidth - x0)/u;
+    G4double t2 = (halfWidth - x0)/u;
+    
+    if(t1 > t2) std::swap(t1, t2);
+    
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,225 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+#include "BiRelKin.hh"
+
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+
+/// BiRelKin test
+///
+/// Compares BiRelKinematics, the single angle and the batch Solve, with the
+/// scalar BiRelKin of the K600 baseline, which is kept verbatim below, over a
+/// grid of scattering angles and excitation energies of three reactions.
+///
+/// The baseline expands a quadratic equation for the ejectile energy, whose
+/// coefficients cancel over many orders of magnitude (Etotal^4 ~ 1e17 MeV^4)
+/// and whose discriminant vanishes at 90 deg. Against a quadruple precision
+/// solution its kinetic energies are off by up to 3e-4 MeV at 200 MeV and its
+/// recoil angles by up to 1e-2 deg MeV/T[3], T[3] the recoil kinetic energy,
+/// whereas BiRelKinematics is within 1e-11 MeV and 1e-9 deg. The tolerances
+/// against the baseline are therefore those of the baseline itself, and the
+/// baseline is not compared where it has no solution.
+
+////////////////////////
+////    Tolerances  ////
+////////////////////////
+
+////    Single angle and batch Solve
+const double BiRelKinTest_BatchEnergyTolerance = 1e-9;  // MeV
+const double BiRelKinTest_BatchAngleTolerance = 1e-9;   // deg
+
+////    Recoil momentum from its components against p[3]^2 c^2 = T[3] (T[3] + 2 m[3] c^2)
+const double BiRelKinTest_MomentumTolerance = 1e-8;     // relative
+
+////    BiRelKinematics and the baseline BiRelKin
+const double BiRelKinTest_EnergyTolerance = 2e-6;       // relative to the beam energy
+const double BiRelKinTest_AngleTolerance = 1e-4;        // deg
+const double BiRelKinTest_AngleTolerance_T3 = 2e-2;     // deg MeV, divided by T[3]
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+////    The baseline BiRelKin, with its header scope variables
+namespace BiRelKinBaseline
+{
+    double c2 = 931.494;     // MeV/u, c^2
+    double c4 = c2*c2;  // (MeV/u)^2, c^4
+
+    double Q, Etotal;
+    double theta_lab, phi_lab;
+
+    double a = 0.0;
+    double b = 0.0;
+    double c = 0.0;
+
+    void BiRelKin(double *m, double *T, double *E, double *p, double ThetaSCAT,  double &PhiSCAT, double Ex)
+    {
+        using std::sqrt;
+        using std::cos;
+        using std::sin;
+        using std::asin;
+
+        Q = (m[2] + m[3])*c2 - (m[0] + m[1])*c2; // MeV
+
+        theta_lab = ThetaSCAT*0.017453292; // radians
+        phi_lab = PhiSCAT*0.017453292; // radians
+
+        E[0] = T[0] + (m[0]*c2);
+        E[1] = T[1] + (m[1]*c2);
+        Etotal = E[0] + E[1] + Q - Ex;
+
+        p[0] = (1/sqrt(c2))*sqrt((E[0]*E[0]) - (m[0]*m[0]*c4));
+        p[1] = (1/sqrt(c2))*sqrt((E[1]*E[1]) - (m[1]*m[1]*c4));
+
+        a = 4*p[0]*p[0]*c2*cos(theta_lab)*cos(theta_lab) - 4*Etotal*Etotal;
+        b = (4*Etotal*Etotal*Etotal) - (4*p[0]*p[0]*c2*Etotal) + (4*m[2]*m[2]*c4*Etotal) - (4*m[3]*m[3]*c4*Etotal);
+        c = (2*p[0]*p[0]*c2*Etotal*Etotal) - (2*m[2]*m[2]*c4*Etotal*Etotal) + (2*m[2]*m[2]*c4*p[0]*p[0]*c2) + (2*m[3]*m[3]*c4*Etotal*Etotal) - (2*m[3]*m[3]*c4*p[0]*p[0]*c2) + (2*m[3]*m[3]*c4*m[2]*m[2]*c4) - (Etotal*Etotal*Etotal*Etotal) - (p[0]*p[0]*p[0]*p[0]*c4) - (m[2]*m[2]*m[2]*m[2]*c4*c4) - (m[3]*m[3]*m[3]*m[3]*c4*c4) - (4*m[2]*m[2]*c4*p[0]*p[0]*c2*cos(theta_lab)*cos(theta_lab));
+
+        E[2] = (- b - sqrt((b*b) - (4*a*c)))/(2*a);
+        T[2] = E[2] - m[2]*c2;
+        p[2] = (1/sqrt(c2))*sqrt((E[2]*E[2]) - (m[2]*m[2]*c4));
+
+        E[3] = Etotal - E[2];
+        T[3] = E[3] - m[3]*c2;
+        p[3] = (1/sqrt(c2))*sqrt((E[3]*E[3]) - (m[3]*m[3]*c4));
+
+        phi_lab = asin((p[2]/p[3])*sin(theta_lab)); // radians
+        PhiSCAT = phi_lab/0.0174532925; // deg
+    }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+////    Records the largest deviation of a quantity and the number of failures
+struct Deviation
+{
+    Deviation() : maximum(0.), nofFailures(0) {}
+
+    void Check(double difference, double tolerance)
+    {
+        ////    A NaN on only one side also fails
+        const double d = std::fabs(difference);
+        if(!(d <= tolerance)) nofFailures++;
+        if(d > maximum) maximum = d;
+    }
+
+    double  maximum;
+    int     nofFailures;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int TestReaction(const char* name, double* m, double T0)
+{
+    ////    Up to 90 deg, beyond which the baseline mirrors the forward solution, in
+    ////    an odd batch such that the scalar remainder is tested as well
+    const int nofAngles = 179;
+    double ThetaSCAT[nofAngles];
+    for(int i=0; i<nofAngles; i++) ThetaSCAT[i] = 90.*(i + 1)/nofAngles; // deg
+
+    Deviation batchEnergy, batchAngle, momentum, energy, angle;
+    int nofBaselineFailures = 0;
+
+    for(int j=0; j<=60; j++)
+    {
+        const double Ex = 0.5*j; // MeV
+        BiRelKinematics kinematics(m, T0, 0., Ex);
+
+        double T2[nofAngles], T3[nofAngles], ThetaRecoil[nofAngles];
+        kinematics.Solve(nofAngles, ThetaSCAT, T2, T3, ThetaRecoil);
+
+        for(int i=0; i<nofAngles; i++)
+        {
+            double T[4], E[4], p[4], ThetaRecoilSingle;
+            kinematics.Solve(ThetaSCAT[i], T, E, p, ThetaRecoilSingle);
+
+            batchEnergy.Check(T2[i] - T[2], BiRelKinTest_BatchEnergyTolerance);
+            batchEnergy.Check(T3[i] - T[3], BiRelKinTest_BatchEnergyTolerance);
+            batchAngle.Check(ThetaRecoil[i] - ThetaRecoilSingle, BiRelKinTest_BatchAngleTolerance);
+
+            const double pc3Squared = T[3]*(T[3] + 2*m[3]*BiRelKin_c2);
+            momentum.Check(p[3]*p[3]*BiRelKin_c2/pc3Squared - 1, BiRelKinTest_MomentumTolerance);
+
+            double TBaseline[4] = {T0, 0., 0., 0.}, EBaseline[4], pBaseline[4];
+            double ThetaRecoilBaseline = 0.;
+            BiRelKinBaseline::BiRelKin(m, TBaseline, EBaseline, pBaseline, ThetaSCAT[i], ThetaRecoilBaseline, Ex);
+
+            ////    The discriminant of the baseline rounds below zero at 90 deg
+            if(ThetaRecoilBaseline != ThetaRecoilBaseline)
+            {
+                nofBaselineFailures++;
+                continue;
+            }
+
+            energy.Check(T[2] - TBaseline[2], BiRelKinTest_EnergyTolerance*T0);
+            energy.Check(T[3] - TBaseline[3], BiRelKinTest_EnergyTolerance*T0);
+            angle.Check(ThetaRecoilSingle - ThetaRecoilBaseline, BiRelKinTest_AngleTolerance + BiRelKinTest_AngleTolerance_T3/T[3]);
+        }
+    }
+
+    std::cout << name << "\n";
+    std::cout << "    batch, T[2] and T[3]:       " << batchEnergy.maximum << " MeV, " << batchEnergy.nofFailures << " failures\n";
+    std::cout << "    batch, recoil angle:        " << batchAngle.maximum << " deg, " << batchAngle.nofFailures << " failures\n";
+    std::cout << "    recoil momentum:            " << momentum.maximum << ", " << momentum.nofFailures << " failures\n";
+    std::cout << "    baseline, T[2] and T[3]:    " << energy.maximum << " MeV, " << energy.nofFailures << " failures\n";
+    std::cout << "    baseline, recoil angle:     " << angle.maximum << " deg, " << angle.nofFailures << " failures\n";
+    std::cout << "    baseline without solution:  " << nofBaselineFailures << "\n";
+
+    return batchEnergy.nofFailures + batchAngle.nofFailures + momentum.nofFailures + energy.nofFailures + angle.nofFailures;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main()
+{
+    ////    16O(a,a'), the reaction of the primary generator
+    double alpha16O[4] = {4.002603, 15.99491, 4.002603, 15.99491}; // u
+
+    ////    24Mg(p,p')
+    double proton24Mg[4] = {1.007825, 23.985042, 1.007825, 23.985042}; // u
+
+    ////    12C(p,p')
+    double proton12C[4] = {1.007825, 12., 1.007825, 12.}; // u
+
+    int nofFailures = 0;
+    nofFailures += TestReaction("16O(a,a') at 200 MeV", alpha16O, 200.);
+    nofFailures += TestReaction("24Mg(p,p') at 200 MeV", proton24Mg, 200.);
+    nofFailures += TestReaction("12C(p,p') at 66 MeV", proton12C, 66.);
+
+    return nofFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//      ----------------------------------------------------------------
+//                      K600 Spectrometer (iThemba Labs)
+//      ----------------------------------------------------------------
+//
+//      Github repository: https://www.github.com/KevinCWLi/K600
+//
+//      Main Author:    K.C.W. Li
+//
+//      email: likevincw@gmail.com
+//
+
+
+
+#include "MeshReader.hh"
+#include "CADMesh.hh"
+
+#include "G4TessellatedSolid.hh"
+#include "G4VFacet.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+/// MeshReader test
+///
+/// Compares the facets read by MeshReader with those of the tessellated solid
+/// built by CADMesh, facet by facet and vertex by vertex, for every mesh model
+/// given on the command line and for both facet orientations. The facets read
+/// by MeshReader are cached in place of those of CADMesh, they must therefore
+/// be the same facets, in the same order, at the same positions.
+
+////    Largest difference of a vertex coordinate, both apply the same arithmetic to the same values
+const double kTolerance = 1e-9*mm;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int TestMesh(const char* meshPath, const G4ThreeVector& offset, G4bool reverse)
+{
+    std::ifstream meshFile(meshPath, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(meshFile)), std::istreambuf_iterator<char>());
+    
+    std::vector<G4double> vertices;
+    G4bool isRead = !data.empty() && MeshReader::Read(&data[0], data.size(), "PLY", mm, offset, reverse, vertices);
+    
+    ////    CADMesh expects non-const strings
+    std::vector<char> path(meshPath, meshPath + strlen(meshPath) + 1);
+    char type[] = "PLY";
+    
+    CADMesh mesh(&path[0], type, mm, offset, reverse);
+    G4TessellatedSolid* solid = dynamic_cast<G4TessellatedSolid*>(mesh.TessellatedMesh());
+    
+    G4int nofFacets = solid ? solid->GetNumberOfFacets() : 0;
+    G4int nofDifferences = 0;
+    G4double maximum = 0.;
+    
+    if(isRead && solid && vertices.size()==size_t(9*nofFacets))
+    {
+        for(G4int i=0; i<nofFacets; i++)
+        {
+            const G4VFacet* facet = solid->GetFacet(i);
+            
+            for(G4int j=0; j<3; j++)
+            {
+                G4ThreeVector vertex = facet->GetVertex(j);
+                const G4double* read = &vertices[9*i + 3*j];
+                
+                G4double difference = std::max(std::fabs(vertex.x() - read[0]), std::max(std::fabs(vertex.y() - read[1]), std::fabs(vertex.z() - read[2])));
+                
+                maximum = std::max(maximum, difference);
+                if(!(difference<=kTolerance)) nofDifferences++;
+            }
+        }
+    }
+    
+    G4bool isPassed = isRead && solid && vertices.size()==size_t(9*nofFacets) && nofDifferences==0;
+    
+    std::cout << meshPath << (reverse ? ", reversed" : "") << "\n";
+    std::cout << "    facets, MeshReader:     " << vertices.size()/9 << (isRead ? "" : " (not read)") << "\n";
+    std::cout << "    facets, CADMesh:        " << nofFacets << "\n";
+    std::cout << "    vertex coordinates:     " << maximum/mm << " mm, " << nofDifferences << " differences\n";
+    std::cout << "    " << (isPassed ? "passed" : "FAILED") << "\n";
+    
+    return isPassed ? 0 : 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+    if(argc<2)
+    {
+        std::cout << "Usage: MeshReaderTest <PLY mesh model> ...\n";
+        return 1;
+    }
+    
+    ////    An offset as used by the geometry
+    G4ThreeVector offset = G4ThreeVector(0*cm, 0*cm, -10*cm);
+    
+    int nofFailures = 0;
+    
+    for(int i=1; i<argc; i++)
+    {
+        nofFailures += TestMesh(argv[i], offset, false);
+        nofFailures += TestMesh(argv[i], offset, true);
+    }
+    
+    return nofFailures == 0 ? 0 : 1;
+}